@@ -0,0 +1,139 @@
+#include <catch2/catch.hpp>
+
+#include "packet/ByteBuffer.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
+
+#include <array>
+#include <numeric>
+#include <vector>
+#include <cstdint>
+
+namespace {
+    // Как SMSG_AUTH_LOGON_CHALLENGE: статус + B(32) + g(1) + N(32) + salt(32)
+    AuthPacket make_challenge() {
+        static const std::array<uint8_t, 32> bytes = [] {
+            std::array<uint8_t, 32> a{};
+            for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<uint8_t>(i * 7);
+            return a;
+        }();
+
+        AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_CHALLENGE);
+        reply.write_uint8(0);
+        reply.write_bytes(bytes.data(), bytes.size());
+        reply.write_uint8(7);
+        reply.write_bytes(bytes.data(), bytes.size());
+        reply.write_bytes(bytes.data(), bytes.size());
+        return reply;
+    }
+}
+
+TEST_CASE("ByteBuffer benchmarks", "[bytebuffer][benchmark]") {
+    BENCHMARK("SMSG_PONG: payload + build_packet") {
+        AuthPacket reply(AuthOpcodes::SMSG_PONG);
+        reply.write_uint32_le(0xDEADBEEF);
+        return reply.build_packet();
+    };
+
+    BENCHMARK("SMSG_AUTH_RESPONSE: payload + build_packet") {
+        AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
+        reply.write_uint8(1);
+        reply.write_uint8(2);
+        return reply.build_packet();
+    };
+
+    BENCHMARK("SMSG_AUTH_LOGON_CHALLENGE (97 bytes): payload + build_packet") {
+        return make_challenge().build_packet();
+    };
+
+    BENCHMARK("SMSG_AUTH_LOGON_CHALLENGE (97 bytes): schema encode + build_packet") {
+        AuthMessages::LogonChallengeReply msg;
+        msg.g = 7;
+        AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_CHALLENGE);
+        reply.write(msg);
+        return reply.build_packet();
+    };
+
+    BENCHMARK("CMSG_AUTH_LOGON_PROOF: schema decode") {
+        static const ByteBuffer payload = [] {
+            ByteBuffer buf;
+            PacketSchema::encode(AuthMessages::LogonProof{}, buf);
+            return buf;
+        }();
+        ByteBuffer in(payload);
+        return PacketSchema::decode<AuthMessages::LogonProof>(in).M1[0];
+    };
+
+    BENCHMARK("mixed field writes, 120 bytes") {
+        ByteBuffer buf;
+        for (int i = 0; i < 10; ++i) {
+            buf.write_uint8(static_cast<uint8_t>(i));
+            buf.write_uint16_be(static_cast<uint16_t>(i));
+            buf.write_uint32_le(static_cast<uint32_t>(i));
+            buf.write_uint32_be(static_cast<uint32_t>(i));
+            buf.write_bool(i & 1);
+        }
+        return buf.size();
+    };
+
+    BENCHMARK("string nt LE write + read (24 chars)") {
+        ByteBuffer buf;
+        buf.write_string_nt_le("PLAYER_NAME_WITH_24_CHAR");
+        return buf.read_string_nt_le();
+    };
+}
+
+TEST_CASE("ByteBuffer bulk array benchmarks", "[bytebuffer][array][benchmark]") {
+    std::vector<uint32_t> values(1000);
+    std::iota(values.begin(), values.end(), 0x01020304u);
+    std::vector<uint16_t> values16(1000);
+    std::iota(values16.begin(), values16.end(), uint16_t{1});
+
+    BENCHMARK("1000 x u32 BE: write_uint32_be loop") {
+        ByteBuffer buf;
+        for (uint32_t v : values) buf.write_uint32_be(v);
+        return buf.size();
+    };
+
+    BENCHMARK("1000 x u32 BE: write_array_u32_be") {
+        ByteBuffer buf;
+        buf.write_array_u32_be(values);
+        return buf.size();
+    };
+
+    BENCHMARK("1000 x u32 LE: write_array_u32_le (memcpy)") {
+        ByteBuffer buf;
+        buf.write_array_u32_le(values);
+        return buf.size();
+    };
+
+    ByteBuffer encoded;
+    encoded.write_array_u32_be(values);
+    std::vector<uint32_t> out(values.size());
+
+    BENCHMARK("1000 x u32 BE: read_uint32_be loop") {
+        encoded.reset_read();
+        for (auto& v : out) v = encoded.read_uint32_be();
+        return out.back();
+    };
+
+    BENCHMARK("1000 x u32 BE: read_array_u32_be") {
+        encoded.reset_read();
+        encoded.read_array_u32_be(out);
+        return out.back();
+    };
+
+    std::vector<uint8_t> raw(values.size() * 4);
+    for (auto backend : {ByteSwap::Backend::SCALAR, ByteSwap::Backend::SSSE3, ByteSwap::Backend::AVX2}) {
+        const char* name = backend == ByteSwap::Backend::SCALAR ? "scalar" :
+                           backend == ByteSwap::Backend::SSSE3 ? "ssse3" : "avx2";
+        BENCHMARK(std::string("copy_swap32 x1000, ") + name) {
+            ByteSwap::copy_swap32(raw.data(), values.data(), values.size(), backend);
+            return raw[0];
+        };
+        BENCHMARK(std::string("copy_swap16 x1000, ") + name) {
+            ByteSwap::copy_swap16(raw.data(), values16.data(), values16.size(), backend);
+            return raw[0];
+        };
+    }
+}
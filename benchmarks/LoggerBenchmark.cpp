@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+
+#include "Logger.hpp"
+#include "logging/BinaryLog.hpp"
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    // Прежняя реализация: посимвольно в std::string, только " и \, MDC через unordered_map + ostringstream
+    std::string legacy_escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"') out += "\\\"";
+            else if (c == '\\') out += "\\\\";
+            else out += c;
+        }
+        return out;
+    }
+
+    std::string legacy_format_with_mdc(const std::string& message,
+                                       const std::unordered_map<std::string, std::string>& mdc) {
+        std::ostringstream oss;
+        oss << "\"message\":\"" << legacy_escape(message) << "\",\"mdc\":{";
+        bool first = true;
+        for (const auto& [k, v] : mdc) {
+            if (!first) oss << ",";
+            oss << "\"" << legacy_escape(k) << "\":\"" << legacy_escape(v) << "\"";
+            first = false;
+        }
+        oss << "}";
+        return oss.str();
+    }
+
+    std::string chat_message() {
+        return "[HandlersWork] CMSG_MESSAGE: hey, anyone up for \"Deadmines\" tonight? need a healer and a tank";
+    }
+
+    std::string dump_message() {
+        std::string dump = "[Packet] DUMP opcode ID: 0001 (2048 bytes) RAW: ";
+        for (int i = 0; i < 2048; ++i) dump += fmt::format("{:02X} ", i & 0xFF);
+        return dump;
+    }
+}
+
+TEST_CASE("JSON escape benchmarks", "[logger][benchmark]") {
+    const std::string chat = chat_message();
+    const std::string dump = dump_message();
+
+    BENCHMARK("chat (" + std::to_string(chat.size()) + " B): legacy escape") {
+        return legacy_escape(chat);
+    };
+
+    BENCHMARK("chat (" + std::to_string(chat.size()) + " B): JsonEscape into memory_buf_t") {
+        spdlog::memory_buf_t buf;
+        Logger::escape_to(buf, chat);
+        return buf.size();
+    };
+
+    BENCHMARK("dump (" + std::to_string(dump.size()) + " B): legacy escape") {
+        return legacy_escape(dump);
+    };
+
+    BENCHMARK("dump (" + std::to_string(dump.size()) + " B): JsonEscape into memory_buf_t") {
+        spdlog::memory_buf_t buf;
+        Logger::escape_to(buf, dump);
+        return buf.size();
+    };
+}
+
+TEST_CASE("MDC encoding benchmarks", "[logger][benchmark]") {
+    const std::string chat = chat_message();
+    const std::string opcode = "0x0002";
+    const std::string user = "ALICE";
+
+    BENCHMARK("legacy MDC: unordered_map + ostringstream") {
+        std::unordered_map<std::string, std::string> mdc;
+        mdc["opcode"] = opcode;
+        mdc["user"] = user;
+        return legacy_format_with_mdc(chat, mdc);
+    };
+
+    BENCHMARK("inline MDC: string_view pairs into memory_buf_t") {
+        MDC mdc;
+        mdc.put("opcode", opcode);
+        mdc.put("user", user);
+        spdlog::memory_buf_t buf;
+        Logger::encode_mdc(buf, chat, mdc);
+        return buf.size();
+    };
+}
+
+TEST_CASE("Deferred logging benchmarks", "[logger][benchmark]") {
+    const std::string user = "ALICE";
+    const uint32_t session = 42;
+    const double latency = 0.125;
+
+    // То, что делает поток-производитель в режимах json и deferred/binary
+    BENCHMARK("json: fmt::format_to into memory_buf_t") {
+        spdlog::memory_buf_t buf;
+        fmt::format_to(fmt::appender(buf), "[Auth] user {} session {} proof ok in {:.3f} ms (opcode 0x{:04X})",
+                       user, session, latency, 0x0001);
+        return buf.size();
+    };
+
+    BENCHMARK("deferred: format ID + raw arguments") {
+        spdlog::memory_buf_t buf;
+        BinaryLog::encode(buf, BinaryLog::format_id("[Auth] user {} session {} proof ok in {:.3f} ms (opcode 0x{:04X})"),
+                          user, session, latency, 0x0001);
+        return buf.size();
+    };
+}
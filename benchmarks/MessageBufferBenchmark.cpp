@@ -0,0 +1,223 @@
+#include <catch2/catch.hpp>
+
+#include "packet/ByteBuffer.hpp"
+#include "packet/FlightRecorder.hpp"
+#include "packet/MessageBuffer.hpp"
+#include "packet/ReceiveBufferPool.hpp"
+#include "packet/RingMessageBuffer.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    // Кадры [opcode(2)][len(2)][payload] как в work-сессии и размеры кусков, которыми они приходят
+    struct Arrival {
+        std::vector<uint8_t> stream;
+        std::vector<size_t> chunks;
+    };
+
+    Arrival make_arrival(size_t frames) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> payload(0, 2048);
+        std::uniform_int_distribution<size_t> chunk(1, 2920);   // в среднем быстрее, чем потребитель разбирает
+
+        Arrival a;
+        for (size_t f = 0; f < frames; ++f) {
+            auto size = static_cast<uint16_t>(payload(rng));
+            a.stream.insert(a.stream.end(), {0x00, 0x02, static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(size)});
+            a.stream.resize(a.stream.size() + size, static_cast<uint8_t>(f));
+        }
+        for (size_t sent = 0; sent < a.stream.size();) {
+            size_t n = std::min(chunk(rng), a.stream.size() - sent);
+            a.chunks.push_back(n);
+            sent += n;
+        }
+        return a;
+    }
+
+    size_t frame_size(const uint8_t* header) {
+        return 4 + (static_cast<size_t>(header[2]) << 8 | header[3]);
+    }
+
+    // Медленный потребитель: разбирает не больше одного кадра на каждый приход данных
+    size_t drain_legacy(const Arrival& a) {
+        MessageBuffer buffer(4096);
+        size_t sent = 0, checksum = 0;
+        for (size_t n : a.chunks) {
+            buffer.ensure_free_space(n);
+            std::memcpy(buffer.write_ptr(), a.stream.data() + sent, n);
+            buffer.write_completed(n);
+            sent += n;
+
+            if (buffer.get_active_size() >= 4 && buffer.get_active_size() >= frame_size(buffer.read_ptr())) {
+                size_t size = frame_size(buffer.read_ptr());
+                checksum += buffer.read_ptr()[size - 1];
+                buffer.read_completed(size);
+            }
+        }
+        return checksum + buffer.capacity();
+    }
+
+    size_t drain_ring(const Arrival& a, RingMessageBuffer::Mapping mapping) {
+        RingMessageBuffer buffer(4096, mapping);
+        size_t sent = 0, checksum = 0;
+        for (size_t n : a.chunks) {
+            buffer.ensure_free_space(n);
+            for (size_t left = n; left > 0;) {
+                size_t part = std::min(left, buffer.get_remaining_space());
+                std::memcpy(buffer.write_ptr(), a.stream.data() + sent, part);
+                buffer.write_completed(part);
+                sent += part;
+                left -= part;
+            }
+
+            if (buffer.get_active_size() >= 4 && buffer.get_active_size() >= frame_size(buffer.peek(4))) {
+                size_t size = frame_size(buffer.peek(4));
+                checksum += buffer.peek(size)[size - 1];
+                buffer.read_completed(size);
+            }
+        }
+        return checksum + buffer.capacity();
+    }
+}
+
+TEST_CASE("MessageBuffer benchmarks (fragmented arrival, slow consumer)", "[buffer][benchmark]") {
+    const Arrival arrival = make_arrival(2000);
+
+    BENCHMARK("MessageBuffer: memmove compaction + linear growth") {
+        return drain_legacy(arrival);
+    };
+
+    BENCHMARK("RingMessageBuffer PLAIN") {
+        return drain_ring(arrival, RingMessageBuffer::Mapping::PLAIN);
+    };
+
+    BENCHMARK("RingMessageBuffer MIRRORED") {
+        return drain_ring(arrival, RingMessageBuffer::Mapping::MIRRORED);
+    };
+}
+
+namespace {
+    size_t resident_bytes() {
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    // Каждое соединение получило один пакет авторизации (~60 байт) и затихло.
+    // Соединения настоящие (loopback), поэтому их число ограничено лимитом дескрипторов: два на соединение
+    constexpr size_t IDLE_CONNECTIONS = 4'000;
+    constexpr size_t REPORT_CONNECTIONS = 100'000;
+    constexpr size_t LOGIN_PACKET = 60;
+
+    using tcp = boost::asio::ip::tcp;
+
+    /**
+     * Сессия с теми же полями, что у ClientSession (сервер с БД в бенчмарки не линкуется).
+     * AccountInfo/SRP6 не заводится: это состояние логина, его оценивает purity_session_memory_bytes
+     */
+    template<typename ReadBuffer, typename Recorder>
+    struct IdleSession : std::enable_shared_from_this<IdleSession<ReadBuffer, Recorder>> {
+        explicit IdleSession(tcp::socket s) : socket(std::move(s)) {}
+
+        tcp::socket socket;
+        std::shared_ptr<void> server;
+        uint64_t session_id = 0;
+        std::unique_ptr<int> account_info;
+        ReadBuffer read_buffer;
+        Recorder flight_recorder;
+        std::deque<ByteBuffer> write_queue;
+        bool writing = false;
+        std::atomic<bool> closed{false};
+        uint8_t session_mode = 0;
+        bool counted = false;
+        std::atomic<size_t> accounted_memory{0};
+    };
+
+    // До: собственный RingMessageBuffer(4096) и самописец 16 x 256
+    using SessionBefore = IdleSession<RingMessageBuffer, FlightRecorder<16, 256>>;
+    // После: буфер из пула только на время разбора, самописец 8 x 128
+    using SessionAfter = IdleSession<ReceiveBufferPool::BufferPtr, FlightRecorder<8, 128>>;
+
+    void receive_login(SessionBefore& session, const std::vector<uint8_t>& login) {
+        auto& buffer = session.read_buffer;
+        std::memcpy(buffer.write_ptr(), login.data(), login.size());
+        buffer.write_completed(login.size());
+        session.flight_recorder.record_inbound(buffer.peek(login.size()), login.size());
+        buffer.read_completed(login.size());
+    }
+
+    void receive_login(SessionAfter& session, const std::vector<uint8_t>& login) {
+        auto& buffer = session.read_buffer;
+        buffer = ReceiveBufferPool::local().acquire();
+        std::memcpy(buffer->write_ptr(), login.data(), login.size());
+        buffer->write_completed(login.size());
+        session.flight_recorder.record_inbound(buffer->peek(login.size()), login.size());
+        buffer->read_completed(login.size());
+        ReceiveBufferPool::local().release(std::move(buffer));     // всё разобрано — буфер вернулся
+    }
+
+    /**
+     * Резидентная память процесса на IDLE_CONNECTIONS принятых соединений с сессиями.
+     * Клиентские концы — голые дескрипторы без объектов asio; буферы сокетов в ядре в RSS не входят
+     */
+    template<typename Session>
+    void report_idle_sessions(const char* name, const std::vector<uint8_t>& login) {
+        boost::asio::io_context io;
+        tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        auto endpoint = acceptor.local_endpoint();
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(endpoint.port());
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        std::vector<int> clients;
+        std::vector<std::shared_ptr<Session>> sessions;
+        clients.reserve(IDLE_CONNECTIONS);
+        sessions.reserve(IDLE_CONNECTIONS);
+
+        malloc_trim(0);     // память предыдущего замера не должна достаться этому даром
+        size_t before = resident_bytes();
+        for (size_t i = 0; i < IDLE_CONNECTIONS; ++i) {
+            int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            REQUIRE(fd >= 0);
+            REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+            clients.push_back(fd);
+
+            auto session = std::make_shared<Session>(acceptor.accept());
+            receive_login(*session, login);
+            sessions.push_back(std::move(session));
+        }
+        size_t after = resident_bytes();
+
+        size_t per_session = (after - before) / IDLE_CONNECTIONS;
+        std::cout << name << ": " << per_session << " bytes resident per idle session (sizeof " << sizeof(Session)
+                  << "), ~" << per_session * REPORT_CONNECTIONS / (1024 * 1024) << " MB per "
+                  << REPORT_CONNECTIONS / 1000 << "k (measured on " << sessions.size() << " connections)\n";
+
+        sessions.clear();
+        for (int fd : clients) ::close(fd);
+    }
+}
+
+TEST_CASE("Idle session memory", "[buffer][memory][benchmark]") {
+    const std::vector<uint8_t> login(LOGIN_PACKET, 0x03);
+
+    report_idle_sessions<SessionBefore>("Own RingMessageBuffer(4096), recorder 16x256 (before)", login);
+    report_idle_sessions<SessionAfter>("Pooled buffer borrowed per read, recorder 8x128 (after)", login);
+}
@@ -0,0 +1,25 @@
+#include <catch2/catch.hpp>
+
+#include "utils/generators/GeneratorUtils.hpp"
+#include "utils/generators/SecureRandom.hpp"
+
+#include <openssl/rand.h>
+#include <array>
+
+TEST_CASE("Random benchmarks", "[random][benchmark]") {
+    BENCHMARK("RAND_bytes 32 bytes") {
+        std::array<uint8_t, 32> out{};
+        RAND_bytes(out.data(), static_cast<int>(out.size()));
+        return out;
+    };
+
+    BENCHMARK("SecureRandom::fill 32 bytes") {
+        std::array<uint8_t, 32> out{};
+        SecureRandom::fill(out);
+        return out;
+    };
+
+    BENCHMARK("GeneratorUtils::random_uint32") {
+        return GeneratorUtils::random_uint32();
+    };
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include "srp6/Sha1Hasher.hpp"
+
+#include <openssl/sha.h>
+#include <array>
+#include <vector>
+
+namespace {
+    // Размеры фрагментов M1 = H(NgHash | H(I) | s | A | B | K)
+    struct ProofInput {
+        std::array<uint8_t, 20> ng_hash{};
+        std::array<uint8_t, 20> user_hash{};
+        std::array<uint8_t, 32> salt{};
+        std::array<uint8_t, 32> A{};
+        std::array<uint8_t, 32> B{};
+        std::array<uint8_t, 40> K{};
+
+        explicit ProofInput(uint8_t seed) {
+            for (auto* arr : {ng_hash.data(), user_hash.data()}) for (int i = 0; i < 20; ++i) arr[i] = seed + i;
+            for (auto* arr : {salt.data(), A.data(), B.data()}) for (int i = 0; i < 32; ++i) arr[i] = seed * 3 + i;
+            for (int i = 0; i < 40; ++i) K[i] = seed ^ i;
+        }
+
+        std::array<Sha1Hasher::Part, 6> parts() const {
+            return {ng_hash, user_hash, salt, A, B, K};
+        }
+    };
+}
+
+TEST_CASE("SHA1 benchmarks (M1-sized messages)", "[sha1][benchmark]") {
+    constexpr size_t BATCH = 8;
+
+    std::vector<ProofInput> inputs;
+    for (size_t i = 0; i < BATCH; ++i) inputs.emplace_back(static_cast<uint8_t>(i));
+
+    std::vector<std::array<Sha1Hasher::Part, 6>> parts;
+    std::vector<Sha1Batch::Message> messages;
+    for (auto& in : inputs) parts.push_back(in.parts());
+    for (auto& p : parts) messages.push_back({p});
+
+    std::vector<Sha1Hasher::Digest> out(BATCH);
+
+    BENCHMARK("x8 old path: vector concat + SHA1()") {
+        for (size_t i = 0; i < BATCH; ++i) {
+            const auto& in = inputs[i];
+            std::vector<uint8_t> to_hash;
+            to_hash.insert(to_hash.end(), in.ng_hash.begin(), in.ng_hash.end());
+            to_hash.insert(to_hash.end(), in.user_hash.begin(), in.user_hash.end());
+            to_hash.insert(to_hash.end(), in.salt.begin(), in.salt.end());
+            to_hash.insert(to_hash.end(), in.A.begin(), in.A.end());
+            to_hash.insert(to_hash.end(), in.B.begin(), in.B.end());
+            to_hash.insert(to_hash.end(), in.K.begin(), in.K.end());
+            SHA1(to_hash.data(), to_hash.size(), out[i].data());
+        }
+        return out[0];
+    };
+
+    BENCHMARK("x8 Sha1Hasher scatter, reused context") {
+        Sha1Hasher& hasher = Sha1Hasher::local();
+        for (size_t i = 0; i < BATCH; ++i) {
+            hasher.digest(parts[i], out[i].data());
+        }
+        return out[0];
+    };
+
+    BENCHMARK("x8 Sha1Batch scalar") {
+        Sha1Batch::digest(messages, out.data(), Sha1Batch::Backend::SCALAR);
+        return out[0];
+    };
+
+    if (Sha1Batch::has_avx2()) {
+        BENCHMARK("x8 Sha1Batch AVX2 multi-buffer") {
+            Sha1Batch::digest(messages, out.data(), Sha1Batch::Backend::AVX2);
+            return out[0];
+        };
+    }
+}
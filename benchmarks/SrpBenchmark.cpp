@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include "srp6/SRP6.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Бюджет CPU на полную проверку логина (challenge + proof) на одном ядре
+    constexpr auto LOGIN_SRP_BUDGET = std::chrono::microseconds(1000);
+
+    struct Handshake {
+        SRP6 server;
+        SRP6 client;
+        std::vector<uint8_t> salt;
+        std::vector<uint8_t> verifier;
+
+        Handshake() {
+            auto [s, v] = server.generate_salt_and_verifier_trinity("bench", "password");
+            salt = s;
+            verifier = v;
+            server.set_only_username("BENCH");
+            client.set_credentials("bench", "password");
+            client.load_salt(salt);
+        }
+
+        // Сервер: ответ на CMSG_AUTH_LOGON_CHALLENGE
+        std::vector<uint8_t> challenge() {
+            server.load_verifier(salt, verifier);
+            server.generate_server_ephemeral();
+            return server.get_B_bytes();
+        }
+    };
+}
+
+TEST_CASE("SRP6 benchmarks", "[srp6][benchmark]") {
+    Handshake h;
+
+    BENCHMARK("server: generate_server_ephemeral (challenge)") {
+        return h.challenge();
+    };
+
+    auto B = h.challenge();
+    h.client.generate_client_ephemeral();
+    auto A = h.client.get_A_bytes();
+    auto M1 = h.client.compute_M1(B);
+
+    // Проверка расходует b, поэтому каждому прогону — свой сервер с готовым challenge
+    BENCHMARK_ADVANCED("server: verify_client_proof (u, S, K, M1, M2)")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<SRP6>> servers;
+        std::vector<std::vector<uint8_t>> proofs;
+        for (int i = 0; i < meter.runs(); ++i) {
+            auto &server = *servers.emplace_back(std::make_unique<SRP6>());
+            server.set_only_username("BENCH");
+            server.load_verifier(h.salt, h.verifier);
+            server.generate_server_ephemeral();
+            proofs.push_back(h.client.compute_M1(server.get_B_bytes()));
+        }
+        meter.measure([&](int i) {
+            std::vector<uint8_t> M2;
+            return servers[i]->verify_client_proof(A, proofs[i], M2);
+        });
+    };
+
+    BENCHMARK("client: compute_M1") {
+        return h.client.compute_M1(B);
+    };
+
+    BENCHMARK("generate_salt_and_verifier_trinity") {
+        return h.server.generate_salt_and_verifier_trinity("bench", "password");
+    };
+}
+
+TEST_CASE("SRP6 server-side login fits latency budget", "[srp6][budget]") {
+    using clock = std::chrono::steady_clock;
+    constexpr int ITERATIONS = 200;
+
+    Handshake h;
+    std::vector<clock::duration> samples;
+    samples.reserve(ITERATIONS);
+
+    for (int i = 0; i < ITERATIONS; ++i) {
+        h.client.generate_client_ephemeral();
+
+        auto start = clock::now();
+        auto B = h.challenge();
+        auto stop = clock::now();
+
+        auto M1 = h.client.compute_M1(B);
+
+        auto proof_start = clock::now();
+        std::vector<uint8_t> M2;
+        bool ok = h.server.verify_client_proof(h.client.get_A_bytes(), M1, M2);
+        auto proof_stop = clock::now();
+
+        REQUIRE(ok);
+        samples.push_back((stop - start) + (proof_stop - proof_start));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto p50 = std::chrono::duration_cast<std::chrono::microseconds>(samples[samples.size() / 2]);
+    auto p99 = std::chrono::duration_cast<std::chrono::microseconds>(samples[samples.size() * 99 / 100]);
+    std::cout << "SRP6 server login CPU: p50=" << p50.count() << "us p99=" << p99.count()
+              << "us budget=" << LOGIN_SRP_BUDGET.count() << "us\n";
+
+    REQUIRE(p50 < LOGIN_SRP_BUDGET);
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+
+#include "utils/utf8utils/UTF8Utils.hpp"
+
+#include <string>
+
+namespace {
+    std::string repeat(const std::string& piece, size_t times) {
+        std::string out;
+        for (size_t i = 0; i < times; ++i) out += piece;
+        return out;
+    }
+
+    const std::string ASCII_PANGRAM = "The quick brown fox jumps over the lazy dog. ";
+    const std::string CYRILLIC_PANGRAM = "Съешь же ещё этих мягких французских булок, да выпей чаю. ";
+
+    const std::string ASCII_NAME = "Administrator";
+    const std::string ASCII_CHAT = repeat(ASCII_PANGRAM, 6);           // 270 байт
+    const std::string ASCII_TEXT = repeat(ASCII_PANGRAM, 91);          // ~4 КБ
+    const std::string CYRILLIC_NAME = "Администратор";
+    const std::string CYRILLIC_CHAT = repeat(CYRILLIC_PANGRAM, 3);     // 312 байт
+    const std::string CYRILLIC_TEXT = repeat(CYRILLIC_PANGRAM, 39);    // ~4 КБ
+}
+
+TEST_CASE("UTF-8 benchmarks", "[utf8][benchmark]") {
+    BENCHMARK("is_valid_utf8: ASCII username (13 bytes)") {
+        return UTF8Utils::is_valid_utf8(ASCII_NAME);
+    };
+
+    BENCHMARK("is_valid_utf8: ASCII chat (270 bytes)") {
+        return UTF8Utils::is_valid_utf8(ASCII_CHAT);
+    };
+
+    BENCHMARK("is_valid_utf8: ASCII text (4 KB)") {
+        return UTF8Utils::is_valid_utf8(ASCII_TEXT);
+    };
+
+    BENCHMARK("is_valid_utf8: Cyrillic username (26 bytes)") {
+        return UTF8Utils::is_valid_utf8(CYRILLIC_NAME);
+    };
+
+    BENCHMARK("is_valid_utf8: Cyrillic chat (312 bytes)") {
+        return UTF8Utils::is_valid_utf8(CYRILLIC_CHAT);
+    };
+
+    BENCHMARK("is_valid_utf8: Cyrillic text (4 KB)") {
+        return UTF8Utils::is_valid_utf8(CYRILLIC_TEXT);
+    };
+
+    BENCHMARK("is_valid_utf8 (scalar): Cyrillic text (4 KB)") {
+        return UTF8Utils::is_valid_utf8(CYRILLIC_TEXT, UTF8Utils::Backend::SCALAR);
+    };
+
+    BENCHMARK("is_valid_utf8 (SSSE3): Cyrillic text (4 KB)") {
+        return UTF8Utils::is_valid_utf8(CYRILLIC_TEXT, UTF8Utils::Backend::SSSE3);
+    };
+
+    BENCHMARK("to_uppercase: ASCII username (13 bytes)") {
+        return UTF8Utils::to_uppercase(ASCII_NAME);
+    };
+
+    BENCHMARK("to_uppercase: Cyrillic username (26 bytes)") {
+        return UTF8Utils::to_uppercase(CYRILLIC_NAME);
+    };
+
+    BENCHMARK("to_uppercase_inplace: ASCII chat (270 bytes)") {
+        std::string s = ASCII_CHAT;
+        UTF8Utils::to_uppercase_inplace(s);
+        return s;
+    };
+
+    BENCHMARK("to_uppercase_unicode: Cyrillic username (26 bytes)") {
+        return UTF8Utils::to_uppercase_unicode(CYRILLIC_NAME);
+    };
+
+    BENCHMARK("to_uppercase_unicode: Cyrillic chat (312 bytes)") {
+        return UTF8Utils::to_uppercase_unicode(CYRILLIC_CHAT);
+    };
+}
@@ -0,0 +1,16 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include "Logger.hpp"
+
+// RAII guard, который гарантирует init + shutdown
+struct LoggerGuard {
+    LoggerGuard() {
+        Logger::init_thread_pool();
+    }
+
+    ~LoggerGuard() {
+        Logger::shutdown();
+    }
+};
+
+LoggerGuard logger_guard;
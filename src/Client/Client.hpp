@@ -6,7 +6,9 @@
 #include <vector>
 
 #include "src/server/ClientSession/ClientSession.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
 #include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkMessages.hpp"
 #include "src/server/SessionMode/workstage/opcodes/WorkPacket.hpp"
 
 class Client {
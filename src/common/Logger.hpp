@@ -8,77 +8,119 @@
 #include <cstdlib>
 #include <string>
 #include <algorithm>
-#include <unordered_map>
-#include <sstream>
+#include <array>
+#include <atomic>
+#include <span>
+#include <string_view>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_sinks.h>           // НЕ цветной консольный sink
 #include <spdlog/sinks/rotating_file_sink.h>
-#include <spdlog/async.h>
-#include <spdlog/async_logger.h>
 #include <fmt/format.h>
 
+#include "logging/JsonEscape.hpp"
+#include "logging/JsonFormatter.hpp"
+#include "logging/LogBackend.hpp"
+#include "logging/LogLimiter.hpp"
+
+/**
+ * Контекст сообщения (key → value) без аллокаций: до CAPACITY пар string_view.
+ * Строки должны жить до конца вызова *_with_mdc.
+ */
 class MDC {
 public:
-    void put(const std::string& key, const std::string& value) {
-        data_[key] = value;
+    static constexpr size_t CAPACITY = 8;
+    using Entry = std::pair<std::string_view, std::string_view>;
+
+    // false, если места больше нет
+    bool put(std::string_view key, std::string_view value) {
+        for (size_t i = 0; i < size_; ++i) {
+            if (data_[i].first == key) {
+                data_[i].second = value;
+                return true;
+            }
+        }
+        if (size_ == CAPACITY) return false;
+        data_[size_++] = {key, value};
+        return true;
     }
 
     void clear() {
-        data_.clear();
+        size_ = 0;
     }
 
-    [[nodiscard]] const std::unordered_map<std::string, std::string>& data() const {
-        return data_;
+    [[nodiscard]] std::span<const Entry> data() const {
+        return {data_.data(), size_};
     }
 
 private:
-    std::unordered_map<std::string, std::string> data_;
+    std::array<Entry, CAPACITY> data_{};
+    size_t size_ = 0;
 };
 
-class Logger : public std::enable_shared_from_this<Logger> {
+class Logger {
 public:
+    // Запускает фоновый поток записи; до этого записи копятся в кольцах потоков
     static void init_thread_pool() {
-        constexpr size_t queue_size = 8192;
-        constexpr size_t num_threads = 1;
-        spdlog::init_thread_pool(queue_size, num_threads);
+        get().backend_->start();
     }
 
+    // Дописывает всё накопленное и останавливает фоновый поток
     static void shutdown() {
+        get().backend_->stop();
         spdlog::shutdown();
     }
 
-    static std::shared_ptr<Logger> get() {
-        static std::shared_ptr<Logger> instance = std::shared_ptr<Logger>(new Logger());
+    // Ссылка на единственный экземпляр: без копирования shared_ptr (атомарного inc/dec) на каждую строку лога
+    static Logger& get() {
+        static Logger instance;
         return instance;
     }
 
+    [[nodiscard]] bool should_log(spdlog::level::level_enum lvl) const {
+        return lvl >= level_.load(std::memory_order_relaxed);
+    }
+
+    void set_level(spdlog::level::level_enum lvl) {
+        level_.store(lvl, std::memory_order_relaxed);
+    }
+
+    /** Записи, отброшенные из-за переполнения колец потоков. */
+    [[nodiscard]] uint64_t dropped_messages() const {
+        return backend_->dropped();
+    }
+
     // --- MDC wrappers ---
-    void trace_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->trace("{}", format_with_mdc(message, mdc));
+    void trace_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::trace, message, mdc);
     }
 
-    void debug_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->debug("{}", format_with_mdc(message, mdc));
+    void debug_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::debug, message, mdc);
     }
 
-    void info_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->info("{}", format_with_mdc(message, mdc));
+    void info_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::info, message, mdc);
     }
 
-    void warn_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->warn("{}", format_with_mdc(message, mdc));
+    void warn_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::warn, message, mdc);
     }
 
-    void error_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->error("{}", format_with_mdc(message, mdc));
+    void error_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::err, message, mdc);
     }
 
-    void critical_with_mdc(const std::string& message, const MDC& mdc) {
-        logger_->critical("{}", format_with_mdc(message, mdc));
+    void critical_with_mdc(std::string_view message, const MDC& mdc) {
+        log_mdc(spdlog::level::critical, message, mdc);
     }
 
     // --- Regular log methods with fmt::format_string ---
+    template<typename... Args>
+    void log(spdlog::level::level_enum lvl, fmt::format_string<Args...> fmt, Args&&... args) {
+        log_json(lvl, fmt, std::forward<Args>(args)...);
+    }
+
     template<typename... Args>
     void trace(fmt::format_string<Args...> fmt, Args&&... args) {
         log_json(spdlog::level::trace, fmt, std::forward<Args>(args)...);
@@ -109,12 +151,33 @@ public:
         log_json(spdlog::level::critical, fmt, std::forward<Args>(args)...);
     }
 
+    // Экранирование строки для JSON сразу в буфер spdlog
+    static void escape_to(spdlog::memory_buf_t& dest, std::string_view s) {
+        JsonEscape::append(dest, s);
+    }
+
+    // "message":"...","mdc":{...} — payload для сообщений с MDC
+    static void encode_mdc(spdlog::memory_buf_t& dest, std::string_view message, const MDC& mdc) {
+        append_literal(dest, "\"message\":\"");
+        escape_to(dest, message);
+        append_literal(dest, "\",\"mdc\":{");
+        bool first = true;
+        for (const auto& [k, v] : mdc.data()) {
+            append_literal(dest, first ? "\"" : ",\"");
+            escape_to(dest, k);
+            append_literal(dest, "\":\"");
+            escape_to(dest, v);
+            dest.push_back('"');
+            first = false;
+        }
+        dest.push_back('}');
+    }
+
 private:
     Logger() {
         try {
             // НЕ цветной консольный sink
             auto console_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
-            console_sink->set_level(spdlog::level::debug);
             console_sink->set_formatter(std::make_unique<JsonFormatter>());
 
             std::vector<spdlog::sink_ptr> sinks{ console_sink };
@@ -132,22 +195,16 @@ private:
             if (enable_file_log) {
                 auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
                         "logs/server.log", 1024 * 1024 * 5, 3);
-                file_sink->set_level(spdlog::level::debug);
                 file_sink->set_formatter(std::make_unique<JsonFormatter>());
                 sinks.push_back(file_sink);
             }
 
-            logger_ = std::make_shared<spdlog::async_logger>(
-                    "async_logger",
-                    sinks.begin(),
-                    sinks.end(),
-                    spdlog::thread_pool(),
-                    spdlog::async_overflow_policy::block
-            );
+            backend_ = std::make_unique<LogBackend>(
+                    std::move(sinks), LogBackend::ring_slots_from_env(), LogBackend::policy_from_env(),
+                    LogBackend::mode_from_env(), LogBackend::binary_path_from_env());
 
-            logger_->set_level(spdlog::level::debug);
-            spdlog::register_logger(logger_);
-            spdlog::set_default_logger(logger_);
+            // Уровень задаётся LOG_LEVEL (trace, debug, info, warn, error, critical, off), по умолчанию info
+            set_level(level_from_env());
 
         } catch (const spdlog::spdlog_ex& ex) {
             std::cerr << "Logger init failed: " << ex.what() << std::endl;
@@ -155,83 +212,138 @@ private:
         }
     }
 
+    static spdlog::level::level_enum level_from_env() {
+        const char* env_level = std::getenv("LOG_LEVEL");
+        if (!env_level) return spdlog::level::info;
+
+        std::string val(env_level);
+        std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+        auto lvl = spdlog::level::from_str(val);
+        // from_str возвращает off для неизвестных строк — не глушим логи из-за опечатки
+        if (lvl == spdlog::level::off && val != "off") {
+            std::cerr << "Unknown LOG_LEVEL '" << env_level << "', using info" << std::endl;
+            return spdlog::level::info;
+        }
+        return lvl;
+    }
+
+    // Сообщение форматируется в стековый буфер только если уровень включён; экранирует JsonFormatter
     template<typename... Args>
     void log_json(spdlog::level::level_enum lvl, fmt::format_string<Args...> fmt_str, Args&&... args) {
-        std::string message = fmt::format(fmt_str, std::forward<Args>(args)...);
-        std::ostringstream oss;
-        oss << "\"message\":\"" << escape(message) << "\"";
-        logger_->log(lvl, "{}", oss.str());
+        if (!should_log(lvl)) return;
+
+        spdlog::memory_buf_t buf;
+        if constexpr (BinaryLog::encodable<Args...>) {
+            // Отложенный режим: только ID формата и сырые аргументы, форматирует фоновый поток
+            if (backend_->captures_binary()) {
+                auto format = fmt_str.get();
+                BinaryLog::encode(buf, BinaryLog::format_id(std::string_view(format.data(), format.size())), args...);
+                backend_->push(lvl, LogBackend::RecordKind::BINARY, std::string_view(buf.data(), buf.size()));
+                return;
+            }
+        }
+        fmt::format_to(fmt::appender(buf), fmt_str, std::forward<Args>(args)...);
+        backend_->push(lvl, LogBackend::RecordKind::TEXT, std::string_view(buf.data(), buf.size()));
     }
 
-    std::string format_with_mdc(const std::string& message, const MDC& mdc) {
-        std::ostringstream oss;
-        oss << "\"message\":\"" << escape(message) << "\",\"mdc\":" << mdc_to_json(mdc);
-        return oss.str();
-    }
+    void log_mdc(spdlog::level::level_enum lvl, std::string_view message, const MDC& mdc) {
+        if (!should_log(lvl)) return;
 
-    static std::string mdc_to_json(const MDC& mdc) {
-        std::ostringstream oss;
-        oss << "{";
-        bool first = true;
-        for (const auto& [k, v] : mdc.data()) {
-            if (!first) oss << ",";
-            oss << "\"" << escape(k) << "\":\"" << escape(v) << "\"";
-            first = false;
-        }
-        oss << "}";
-        return oss.str();
+        spdlog::memory_buf_t buf;
+        encode_mdc(buf, message, mdc);
+        backend_->push(lvl, LogBackend::RecordKind::JSON, std::string_view(buf.data(), buf.size()));
     }
 
-    static std::string escape(const std::string& s) {
-        std::string out;
-        for (char c : s) {
-            if (c == '"') out += "\\\"";
-            else if (c == '\\') out += "\\\\";
-            else out += c;
-        }
-        return out;
+    static void append_literal(spdlog::memory_buf_t& dest, std::string_view s) {
+        dest.append(s.data(), s.data() + s.size());
     }
 
-    // JSON форматтер без цвета (консоль и файл)
-    class JsonFormatter : public spdlog::formatter {
-    public:
-        void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
-            using namespace std::chrono;
+private:
+    std::unique_ptr<LogBackend> backend_;
+    std::atomic<int> level_{spdlog::level::info};
+};
+
+// ==================== Compile-time log level ====================
+// PURITY_LOG_LEVEL задаётся из CMake (опция PURITY_LOG_LEVEL). Вызовы ниже этого уровня
+// не компилируются вовсе, аргументы не вычисляются. Выше — одна проверка уровня до форматирования.
+
+#define PURITY_LOG_LEVEL_TRACE    0
+#define PURITY_LOG_LEVEL_DEBUG    1
+#define PURITY_LOG_LEVEL_INFO     2
+#define PURITY_LOG_LEVEL_WARN     3
+#define PURITY_LOG_LEVEL_ERROR    4
+#define PURITY_LOG_LEVEL_CRITICAL 5
+#define PURITY_LOG_LEVEL_OFF      6
 
-            auto tp = msg.time;
-            auto s = time_point_cast<seconds>(tp);
-            auto ms = time_point_cast<milliseconds>(tp) - time_point_cast<milliseconds>(s);
-            auto ns = time_point_cast<nanoseconds>(tp) - time_point_cast<nanoseconds>(time_point_cast<milliseconds>(tp));
+#ifndef PURITY_LOG_LEVEL
+#define PURITY_LOG_LEVEL PURITY_LOG_LEVEL_TRACE
+#endif
+
+#define PURITY_LOG_CALL(lvl, method, ...)                                   \
+    do {                                                                    \
+        auto &purity_log_ = Logger::get();                                  \
+        if (purity_log_.should_log(lvl)) purity_log_.method(__VA_ARGS__);   \
+    } while (0)
 
-            auto time_t = system_clock::to_time_t(s);
-            std::tm tm;
-#ifdef _WIN32
-            localtime_s(&tm, &time_t);
+#define PURITY_LOG_DISABLED(...) do { } while (0)
+
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_TRACE
+#define PURITY_LOG_TRACE(...) PURITY_LOG_CALL(spdlog::level::trace, trace, __VA_ARGS__)
 #else
-            localtime_r(&time_t, &tm);
+#define PURITY_LOG_TRACE(...) PURITY_LOG_DISABLED(__VA_ARGS__)
 #endif
 
-            char time_buf[64];
-            std::strftime(time_buf, sizeof(time_buf), "%Y-%m-%dT%H:%M:%S", &tm);
-
-            // msg.payload уже содержит JSON без внешних скобок, вставляем "как есть"
-            fmt::format_to(
-                    std::back_inserter(dest),
-                    "{{\"timestamp\":\"{}.{:03}{:03}\",\"level\":\"{}\",\"thread_id\":{},{} }}\n",
-                    time_buf,
-                    static_cast<int>(ms.count()),
-                    static_cast<int>(ns.count()),
-                    spdlog::level::to_string_view(msg.level),
-                    msg.thread_id,
-                    fmt::string_view(msg.payload.data(), msg.payload.size())
-            );
-        }
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_DEBUG
+#define PURITY_LOG_DEBUG(...) PURITY_LOG_CALL(spdlog::level::debug, debug, __VA_ARGS__)
+#else
+#define PURITY_LOG_DEBUG(...) PURITY_LOG_DISABLED(__VA_ARGS__)
+#endif
 
-        std::unique_ptr<spdlog::formatter> clone() const override {
-            return std::make_unique<JsonFormatter>();
-        }
-    };
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_INFO
+#define PURITY_LOG_INFO(...) PURITY_LOG_CALL(spdlog::level::info, info, __VA_ARGS__)
+#else
+#define PURITY_LOG_INFO(...) PURITY_LOG_DISABLED(__VA_ARGS__)
+#endif
 
-private:
-    std::shared_ptr<spdlog::logger> logger_;
-};
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_WARN
+#define PURITY_LOG_WARN(...) PURITY_LOG_CALL(spdlog::level::warn, warn, __VA_ARGS__)
+#else
+#define PURITY_LOG_WARN(...) PURITY_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_ERROR
+#define PURITY_LOG_ERROR(...) PURITY_LOG_CALL(spdlog::level::err, error, __VA_ARGS__)
+#else
+#define PURITY_LOG_ERROR(...) PURITY_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_CRITICAL
+#define PURITY_LOG_CRITICAL(...) PURITY_LOG_CALL(spdlog::level::critical, critical, __VA_ARGS__)
+#else
+#define PURITY_LOG_CRITICAL(...) PURITY_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+// ==================== Rate limiting / sampling ====================
+// Ограничение на месте вызова, состояние — static внутри макроса; severity — TRACE..CRITICAL:
+//   PURITY_LOG_RATE(INFO, 10, 20, "...")      — пачкой до 20, дальше не чаще 10 в секунду;
+//   PURITY_LOG_EVERY_N(INFO, 100, "...", x)   — первая и затем каждая 100-я.
+// Подавленные записи не форматируются; их число раз в 10 секунд пишет сводкой фоновый поток логов.
+
+#define PURITY_LOG_LIMITED(severity, limiter_type, limiter_args, ...)                                     \
+    do {                                                                                                  \
+        if constexpr (PURITY_LOG_LEVEL_##severity >= PURITY_LOG_LEVEL) {                                  \
+            constexpr auto purity_lvl_ =                                                                  \
+                    static_cast<spdlog::level::level_enum>(PURITY_LOG_LEVEL_##severity);                  \
+            auto &purity_log_ = Logger::get();                                                            \
+            if (purity_log_.should_log(purity_lvl_)) {                                                    \
+                static limiter_type purity_limiter_ limiter_args;                                         \
+                if (purity_limiter_.allow()) purity_log_.log(purity_lvl_, __VA_ARGS__);                   \
+            }                                                                                             \
+        }                                                                                                 \
+    } while (0)
+
+#define PURITY_LOG_RATE(severity, per_second, burst, ...) \
+    PURITY_LOG_LIMITED(severity, LogRateLimiter, (__FILE__, __LINE__, per_second, burst), __VA_ARGS__)
+
+#define PURITY_LOG_EVERY_N(severity, n, ...) \
+    PURITY_LOG_LIMITED(severity, LogSampler, (__FILE__, __LINE__, n), __VA_ARGS__)
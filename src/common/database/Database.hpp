@@ -13,6 +13,7 @@
 #include "QueryResults.hpp"
 #include "PreparedStatement.hpp"
 #include "Logger.hpp"
+#include "metrics/Metrics.hpp"
 
 class Database {
 public:
@@ -21,7 +22,7 @@ public:
         for (size_t i = 0; i < pool_size; ++i) {
             auto conn = std::make_unique<pqxx::connection>(conninfo_);
             prepare_all(*conn);
-            Logger::get()->info("[Database] Connection {} established", i + 1);
+            Logger::get().info("[Database] Connection {} established", i + 1);
             connections_.push(std::move(conn));
         }
     }
@@ -36,7 +37,7 @@ public:
             auto &c = connections_.front();
             if (c && c->is_open()) {
                 c->disconnect();
-                Logger::get()->info("[Database] Connection closed.");
+                Logger::get().info("[Database] Connection closed.");
             }
             connections_.pop();
         }
@@ -72,6 +73,7 @@ public:
         auto scoped = acquire_scoped_connection();
 
         try {
+            Metrics::Timer::Scope timing(query_time_);
             pqxx::work txn(scoped.get());
             auto invoc = txn.prepared(stmt.name());
             for (const auto &param: stmt.params()) {
@@ -96,7 +98,7 @@ public:
             return PgRowMapper<Struct>::map(result[0]);
         }
         catch (const pqxx::broken_connection &) {
-            Logger::get()->error("[Database] Connection broken. Attempting to reconnect.");
+            Logger::get().error("[Database] Connection broken. Attempting to reconnect.");
             auto reconnect = reconnect_connection();
             if (!reconnect) throw std::runtime_error("Reconnection failed");
             throw;
@@ -105,6 +107,7 @@ public:
 
 private:
     std::unique_ptr<pqxx::connection> acquire_connection(std::chrono::milliseconds timeout) {
+        Metrics::Timer::Scope timing(pool_wait_);
         std::unique_lock<std::mutex> lock(mutex_);
         if (connections_.empty()) {
             if (!cond_.wait_for(lock, timeout, [this] { return !connections_.empty(); })) {
@@ -117,7 +120,7 @@ private:
         connections_.pop();
 
         if (!conn->is_open()) {
-            Logger::get()->warn("[Database] Connection was closed. Reconnecting.");
+            Logger::get().warn("[Database] Connection was closed. Reconnecting.");
             conn = reconnect_connection();
         }
 
@@ -135,7 +138,7 @@ private:
     std::unique_ptr<pqxx::connection> reconnect_connection() {
         auto conn = std::make_unique<pqxx::connection>(conninfo_);
         prepare_all(*conn);
-        Logger::get()->info("[Database] Connection re-established.");
+        Logger::get().info("[Database] Connection re-established.");
         return conn;
     }
 
@@ -152,6 +155,11 @@ private:
     std::queue<std::unique_ptr<pqxx::connection>> connections_;
     std::mutex mutex_;
     std::condition_variable cond_;
+
+    Metrics::Timer &pool_wait_ = Metrics::Registry::instance().timer(
+            "purity_db_pool_wait_seconds", "Time spent waiting for a free database connection");
+    Metrics::Timer &query_time_ = Metrics::Registry::instance().timer(
+            "purity_db_query_seconds", "Prepared statement execution time including commit");
 };
 
 #pragma GCC diagnostic pop
\ No newline at end of file
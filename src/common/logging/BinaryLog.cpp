@@ -0,0 +1,187 @@
+#include "BinaryLog.hpp"
+
+#include <spdlog/fmt/bundled/args.h>
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<const char*, uint32_t> ids;
+        std::deque<std::string> formats;    // deque: ссылки не инвалидируются при росте
+    };
+
+    // Не разрушается: форматы нужны и при логировании из статических деструкторов
+    Registry& registry() {
+        static auto* instance = new Registry();
+        return *instance;
+    }
+
+    // Кэш потока: прямое отображение по адресу литерала. Тривиально разрушаемый,
+    // поэтому безопасен и после завершения thread_local-деструкторов потока
+    struct CacheEntry {
+        const char* format;
+        uint32_t id;
+    };
+
+    constexpr size_t ID_CACHE_SIZE = 256;
+    thread_local std::array<CacheEntry, ID_CACHE_SIZE> id_cache{};
+
+    // Читает значения из payload с проверкой границ
+    class PayloadReader {
+    public:
+        explicit PayloadReader(std::string_view data) : data_(data) {}
+
+        template<typename T>
+        bool read(T& value) {
+            if (data_.size() - pos_ < sizeof(T)) return false;
+            std::memcpy(&value, data_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        bool read_bytes(size_t length, std::string_view& value) {
+            if (data_.size() - pos_ < length) return false;
+            value = data_.substr(pos_, length);
+            pos_ += length;
+            return true;
+        }
+
+    private:
+        std::string_view data_;
+        size_t pos_ = 0;
+    };
+}
+
+uint32_t BinaryLog::format_id(std::string_view format) {
+    auto& entry = id_cache[(reinterpret_cast<uintptr_t>(format.data()) >> 3) % ID_CACHE_SIZE];
+    if (entry.format == format.data()) return entry.id;
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto [it, inserted] = reg.ids.try_emplace(format.data(), static_cast<uint32_t>(reg.formats.size()));
+    if (inserted) reg.formats.emplace_back(format);
+    entry = {format.data(), it->second};
+    return it->second;
+}
+
+std::string_view BinaryLog::format_string(uint32_t id) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return id < reg.formats.size() ? std::string_view(reg.formats[id]) : std::string_view();
+}
+
+uint32_t BinaryLog::payload_id(std::string_view payload) {
+    uint32_t id = 0;
+    PayloadReader(payload).read(id);
+    return id;
+}
+
+bool BinaryLog::format(spdlog::memory_buf_t& out, std::string_view format, std::string_view payload) {
+    PayloadReader reader(payload);
+    uint32_t id = 0;
+    uint8_t count = 0;
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+    bool ok = reader.read(id) && reader.read(count);
+    for (uint8_t i = 0; ok && i < count; ++i) {
+        uint8_t tag = 0;
+        ok = reader.read(tag);
+        if (!ok) break;
+
+        switch (static_cast<ArgType>(tag)) {
+            case ArgType::I64: { int64_t v; ok = reader.read(v); if (ok) store.push_back(v); break; }
+            case ArgType::U64: { uint64_t v; ok = reader.read(v); if (ok) store.push_back(v); break; }
+            case ArgType::F64: { double v; ok = reader.read(v); if (ok) store.push_back(v); break; }
+            case ArgType::BOOL: { uint8_t v; ok = reader.read(v); if (ok) store.push_back(v != 0); break; }
+            case ArgType::CHAR: { char v; ok = reader.read(v); if (ok) store.push_back(v); break; }
+            case ArgType::STR: {
+                uint32_t length = 0;
+                std::string_view v;
+                ok = reader.read(length) && reader.read_bytes(length, v);
+                if (ok) store.push_back(fmt::string_view(v.data(), v.size()));
+                break;
+            }
+            default:
+                ok = false;
+        }
+    }
+
+    if (!ok) {
+        fmt::format_to(fmt::appender(out), "<corrupted binary record, format #{}>", id);
+        return false;
+    }
+
+    try {
+        fmt::vformat_to(fmt::appender(out), fmt::string_view(format.data(), format.size()), store);
+    } catch (const fmt::format_error& e) {
+        fmt::format_to(fmt::appender(out), "<format error '{}' for format #{}>", e.what(), id);
+        return false;
+    }
+    return true;
+}
+
+// ==================== FileWriter ====================
+
+BinaryLog::FileWriter::FileWriter(const std::string& path) : file_(std::fopen(path.c_str(), "wb")) {
+    if (!file_) throw std::runtime_error("BinaryLog: cannot open " + path);
+    std::fwrite(FILE_MAGIC, 1, sizeof(FILE_MAGIC), file_);
+}
+
+BinaryLog::FileWriter::~FileWriter() {
+    if (file_) std::fclose(file_);
+}
+
+void BinaryLog::FileWriter::write(const LogRing::Header& header, size_t thread_id, std::string_view payload) {
+    auto kind = static_cast<LogRecordKind>(header.kind);
+    if (kind == LogRecordKind::BINARY) {
+        uint32_t id = payload_id(payload);
+        if (id >= defined_.size()) defined_.resize(id + 1, false);
+        if (!defined_[id]) {
+            std::string_view format = format_string(id);
+            std::string definition(sizeof(id) + format.size(), '\0');
+            std::memcpy(definition.data(), &id, sizeof(id));
+            std::memcpy(definition.data() + sizeof(id), format.data(), format.size());
+            write_raw(LogRecordKind::FORMAT, 0, 0, 0, definition);
+            defined_[id] = true;
+        }
+    }
+    write_raw(kind, header.level, header.time_ns, thread_id, payload);
+}
+
+void BinaryLog::FileWriter::write_raw(LogRecordKind kind, uint8_t level, int64_t time_ns, uint64_t thread_id,
+                                      std::string_view payload) {
+    FileRecordHeader header{static_cast<uint8_t>(kind), level, 0, static_cast<uint32_t>(payload.size()), time_ns, thread_id};
+    std::fwrite(&header, sizeof(header), 1, file_);
+    std::fwrite(payload.data(), 1, payload.size(), file_);
+}
+
+void BinaryLog::FileWriter::flush() {
+    std::fflush(file_);
+}
+
+// ==================== FileReader ====================
+
+BinaryLog::FileReader::FileReader(std::FILE* file) : file_(file) {
+    char magic[sizeof(FILE_MAGIC)];
+    if (std::fread(magic, 1, sizeof(magic), file_) != sizeof(magic) ||
+        std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("BinaryLog: not a binary log file");
+    }
+}
+
+bool BinaryLog::FileReader::next(FileRecord& record) {
+    size_t got = std::fread(&record.header, 1, sizeof(record.header), file_);
+    if (got == 0) return false;
+    if (got != sizeof(record.header)) throw std::runtime_error("BinaryLog: truncated record header");
+
+    record.payload.resize(record.header.length);
+    if (std::fread(record.payload.data(), 1, record.payload.size(), file_) != record.payload.size()) {
+        throw std::runtime_error("BinaryLog: truncated record payload");
+    }
+    return true;
+}
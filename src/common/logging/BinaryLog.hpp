@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <spdlog/common.h>
+
+#include "LogRing.hpp"
+
+/**
+ * Отложенное (бинарное) логирование: на горячем пути пишется только ID формат-строки
+ * и сырые байты аргументов, форматирование — в фоновом потоке или офлайн (log_decoder).
+ *
+ * Payload записи BINARY: u32 id, u8 число аргументов, далее для каждого аргумента
+ * байт типа и значение (числа — 8 байт LE, строки — u32 длина + байты).
+ */
+namespace BinaryLog {
+
+    enum class ArgType : uint8_t {
+        I64,
+        U64,
+        F64,
+        BOOL,
+        CHAR,
+        STR
+    };
+
+    template<typename T>
+    concept Encodable = std::is_arithmetic_v<T> || std::is_convertible_v<const T&, std::string_view>;
+
+    template<typename... Args>
+    constexpr bool encodable = (Encodable<std::remove_cvref_t<Args>> && ...);
+
+    // ID формат-строки по адресу литерала; кэш на поток, новый ID регистрируется под мьютексом
+    uint32_t format_id(std::string_view format);
+
+    // Формат-строка по ID (пустая, если ID неизвестен этому процессу)
+    std::string_view format_string(uint32_t id);
+
+    namespace detail {
+        inline void put(spdlog::memory_buf_t& out, const void* data, size_t length) {
+            const auto* bytes = static_cast<const char*>(data);
+            out.append(bytes, bytes + length);
+        }
+
+        inline void put_tag(spdlog::memory_buf_t& out, ArgType type) {
+            out.push_back(static_cast<char>(type));
+        }
+
+        inline void put_string(spdlog::memory_buf_t& out, std::string_view value) {
+            put_tag(out, ArgType::STR);
+            auto length = static_cast<uint32_t>(value.size());
+            put(out, &length, sizeof(length));
+            put(out, value.data(), value.size());
+        }
+
+        template<typename T>
+        void put_arg(spdlog::memory_buf_t& out, const T& value) {
+            using V = std::remove_cvref_t<T>;
+            if constexpr (std::is_same_v<V, bool>) {
+                put_tag(out, ArgType::BOOL);
+                out.push_back(value ? 1 : 0);
+            } else if constexpr (std::is_same_v<V, char>) {
+                put_tag(out, ArgType::CHAR);
+                out.push_back(value);
+            } else if constexpr (std::is_floating_point_v<V>) {
+                double v = static_cast<double>(value);
+                put_tag(out, ArgType::F64);
+                put(out, &v, sizeof(v));
+            } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+                int64_t v = value;
+                put_tag(out, ArgType::I64);
+                put(out, &v, sizeof(v));
+            } else if constexpr (std::is_integral_v<V>) {
+                uint64_t v = value;
+                put_tag(out, ArgType::U64);
+                put(out, &v, sizeof(v));
+            } else if constexpr (std::is_pointer_v<V>) {
+                put_string(out, value ? std::string_view(value) : std::string_view("(null)"));
+            } else {
+                // Массивы (литералы, char name[N]) — сюда: их адрес не бывает нулевым
+                put_string(out, std::string_view(value));
+            }
+        }
+    }
+
+    template<typename... Args>
+    void encode(spdlog::memory_buf_t& out, uint32_t id, const Args&... args) {
+        static_assert(sizeof...(Args) < 256, "too many log arguments");
+        detail::put(out, &id, sizeof(id));
+        out.push_back(static_cast<char>(sizeof...(Args)));
+        (detail::put_arg(out, args), ...);
+    }
+
+    /**
+     * Форматирует payload BINARY по формат-строке в out.
+     * false — payload повреждён или не подходит к формат-строке (в out пишется пояснение).
+     */
+    bool format(spdlog::memory_buf_t& out, std::string_view format, std::string_view payload);
+
+    // ID из payload BINARY (0, если payload короче 4 байт)
+    uint32_t payload_id(std::string_view payload);
+
+    // ==================== Файл бинарного лога ====================
+    // 8 байт сигнатуры, далее записи: FileRecordHeader + payload
+
+    constexpr char FILE_MAGIC[8] = {'P', 'U', 'R', 'L', 'O', 'G', '\x01', '\n'};
+
+    struct FileRecordHeader {
+        uint8_t kind;           // LogRecordKind
+        uint8_t level;
+        uint16_t reserved;
+        uint32_t length;
+        int64_t time_ns;
+        uint64_t thread_id;
+    };
+
+    class FileWriter {
+    public:
+        explicit FileWriter(const std::string& path);
+        ~FileWriter();
+
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+
+        // Для BINARY перед первой записью с новым ID пишется определение формата (FORMAT)
+        void write(const LogRing::Header& header, size_t thread_id, std::string_view payload);
+        void flush();
+
+    private:
+        void write_raw(LogRecordKind kind, uint8_t level, int64_t time_ns, uint64_t thread_id, std::string_view payload);
+
+        std::FILE* file_ = nullptr;
+        std::vector<bool> defined_;
+    };
+
+    struct FileRecord {
+        FileRecordHeader header{};
+        std::string payload;
+    };
+
+    class FileReader {
+    public:
+        explicit FileReader(std::FILE* file);
+
+        // false — конец файла; повреждённый файл — исключение
+        bool next(FileRecord& record);
+
+    private:
+        std::FILE* file_;
+    };
+
+} // namespace BinaryLog
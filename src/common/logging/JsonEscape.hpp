@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <spdlog/common.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Экранирование строк для JSON (RFC 8259): ", \ и управляющие байты < 0x20.
+ * Чистые участки копируются целиком, поиск спецсимволов — по 16 байт (SSE2) или по 8 (SWAR).
+ */
+namespace JsonEscape {
+
+    inline bool is_special(unsigned char c) {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    // Позиция первого спецсимвола в [data + from, data + size) или size
+    inline size_t find_special(const char* data, size_t size, size_t from) {
+        size_t i = from;
+#if defined(__SSE2__)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control_max = _mm_set1_epi8(0x1F);
+        for (; i + 16 <= size; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                    _mm_cmpeq_epi8(_mm_min_epu8(v, control_max), v));     // v <= 0x1F (беззнаково)
+            int mask = _mm_movemask_epi8(special);
+            if (mask) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+#else
+        // SWAR: в каждом байте слова ищем 0x22, 0x5C и значения < 0x20
+        constexpr uint64_t ones = 0x0101010101010101ULL;
+        constexpr uint64_t highs = 0x8080808080808080ULL;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t w;
+            __builtin_memcpy(&w, data + i, 8);
+            uint64_t q = w ^ (ones * '"');
+            uint64_t b = w ^ (ones * '\\');
+            uint64_t hit = ((q - ones) & ~q) | ((b - ones) & ~b) | ((w - ones * 0x20) & ~w);
+            if (hit & highs) break;     // точную позицию найдёт скалярный хвост
+        }
+#endif
+        for (; i < size; ++i) {
+            if (is_special(static_cast<unsigned char>(data[i]))) return i;
+        }
+        return size;
+    }
+
+    inline void append_escaped_char(spdlog::memory_buf_t& dest, unsigned char c) {
+        static constexpr char hex[] = "0123456789abcdef";
+        switch (c) {
+            case '"':  dest.append(std::string_view("\\\"")); break;
+            case '\\': dest.append(std::string_view("\\\\")); break;
+            case '\n': dest.append(std::string_view("\\n")); break;
+            case '\r': dest.append(std::string_view("\\r")); break;
+            case '\t': dest.append(std::string_view("\\t")); break;
+            case '\b': dest.append(std::string_view("\\b")); break;
+            case '\f': dest.append(std::string_view("\\f")); break;
+            default: {
+                const char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+                dest.append(u, u + sizeof(u));
+            }
+        }
+    }
+
+    inline void append(spdlog::memory_buf_t& dest, std::string_view s) {
+        size_t run = 0;
+        while (run < s.size()) {
+            size_t pos = find_special(s.data(), s.size(), run);
+            dest.append(s.data() + run, s.data() + pos);
+            if (pos == s.size()) break;
+            append_escaped_char(dest, static_cast<unsigned char>(s[pos]));
+            run = pos + 1;
+        }
+    }
+
+} // namespace JsonEscape
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <string_view>
+
+#include <spdlog/formatter.h>
+#include <spdlog/details/log_msg.h>
+
+#include "JsonEscape.hpp"
+
+/**
+ * JSON форматтер без цвета (консоль, файл и log_decoder).
+ * Сообщения логгера JSON_LOGGER_NAME уже закодированы в JSON (MDC) и вставляются как есть.
+ */
+class JsonFormatter : public spdlog::formatter {
+public:
+    static constexpr std::string_view JSON_LOGGER_NAME = "async_logger_mdc";
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
+        using namespace std::chrono;
+
+        auto tp = msg.time;
+        auto s = time_point_cast<seconds>(tp);
+        auto ms = time_point_cast<milliseconds>(tp) - time_point_cast<milliseconds>(s);
+        auto ns = time_point_cast<nanoseconds>(tp) - time_point_cast<nanoseconds>(time_point_cast<milliseconds>(tp));
+
+        // strftime/localtime_r дорогие — пересчитываем только при смене секунды
+        if (s != cached_second_) {
+            cached_second_ = s;
+            auto time_t = system_clock::to_time_t(s);
+            std::tm tm;
+#ifdef _WIN32
+            localtime_s(&tm, &time_t);
+#else
+            localtime_r(&time_t, &tm);
+#endif
+            cached_time_len_ = std::strftime(cached_time_, sizeof(cached_time_), "%Y-%m-%dT%H:%M:%S", &tm);
+        }
+
+        fmt::format_to(
+                fmt::appender(dest),
+                "{{\"timestamp\":\"{}.{:03}{:06}\",\"level\":\"{}\",\"thread_id\":{},",
+                std::string_view(cached_time_, cached_time_len_),
+                static_cast<int>(ms.count()),
+                static_cast<int>(ns.count()),
+                spdlog::level::to_string_view(msg.level),
+                msg.thread_id
+        );
+
+        std::string_view payload(msg.payload.data(), msg.payload.size());
+        if (std::string_view(msg.logger_name.data(), msg.logger_name.size()) == JSON_LOGGER_NAME) {
+            // payload уже JSON без внешних скобок, вставляем "как есть"
+            dest.append(payload);
+        } else {
+            dest.append(std::string_view("\"message\":\""));
+            JsonEscape::append(dest, payload);
+            dest.push_back('"');
+        }
+        dest.append(std::string_view(" }\n"));
+    }
+
+    std::unique_ptr<spdlog::formatter> clone() const override {
+        return std::make_unique<JsonFormatter>();
+    }
+
+private:
+    std::chrono::sys_seconds cached_second_{};
+    char cached_time_[64] = {};
+    size_t cached_time_len_ = 0;
+};
@@ -0,0 +1,272 @@
+#include "LogBackend.hpp"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/os.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+    constexpr size_t DEFAULT_RING_SLOTS = 4096;
+    constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+    constexpr auto FLUSH_INTERVAL = std::chrono::seconds(1);
+    constexpr auto SUPPRESSED_REPORT_INTERVAL = std::chrono::seconds(10);
+
+    // thread_local-деструкторы потока уже отработали (например, main логирует из статических деструкторов)
+    thread_local bool ring_holder_destroyed = false;
+
+    // Держит кольцо потока; при завершении потока помечает его на удаление
+    struct RingHolder {
+        std::shared_ptr<LogRing> ring;
+        const void* owner = nullptr;
+
+        ~RingHolder() {
+            if (ring) ring->retire();
+            ring_holder_destroyed = true;
+        }
+    };
+
+    thread_local RingHolder ring_holder;
+}
+
+LogBackend::LogBackend(std::vector<spdlog::sink_ptr> sinks, size_t ring_slots, LogRing::OverflowPolicy policy,
+                       Mode mode, const std::string& binary_path)
+        : sinks_(std::move(sinks)), ring_slots_(ring_slots), policy_(policy), mode_(mode) {
+    if (mode_ == Mode::BINARY) {
+        auto parent = std::filesystem::path(binary_path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+        binary_out_ = std::make_unique<BinaryLog::FileWriter>(binary_path);
+    }
+}
+
+LogBackend::~LogBackend() {
+    stop();
+}
+
+void LogBackend::start() {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread([this] { run(); });
+}
+
+void LogBackend::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    while (drain() > 0) {}
+    report_dropped();
+    report_suppressed();
+    for (auto& sink : sinks_) sink->flush();
+    if (binary_out_) binary_out_->flush();
+}
+
+LogRing& LogBackend::local_ring() {
+    if (!ring_holder.ring || ring_holder.owner != this) {
+        if (ring_holder.ring) ring_holder.ring->retire();
+        ring_holder.ring = std::make_shared<LogRing>(ring_slots_, policy_, spdlog::details::os::thread_id());
+        ring_holder.owner = this;
+
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(ring_holder.ring);
+    }
+    return *ring_holder.ring;
+}
+
+LogRing& LogBackend::late_ring() {
+    if (!late_ring_) {
+        late_ring_ = std::make_shared<LogRing>(ring_slots_, policy_, spdlog::details::os::thread_id());
+
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(late_ring_);
+    }
+    return *late_ring_;
+}
+
+void LogBackend::push(spdlog::level::level_enum lvl, RecordKind kind, std::string_view payload) {
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            spdlog::log_clock::now().time_since_epoch()).count();
+
+    if (ring_holder_destroyed) {
+        // Своего кольца у потока уже нет: пишем в общее, производители сериализуются мьютексом
+        std::lock_guard<std::mutex> lock(late_mutex_);
+        late_ring().push(now, static_cast<uint8_t>(lvl), static_cast<uint8_t>(kind), payload);
+        return;
+    }
+    local_ring().push(now, static_cast<uint8_t>(lvl), static_cast<uint8_t>(kind), payload);
+}
+
+uint64_t LogBackend::dropped() const {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    uint64_t total = retired_dropped_;
+    for (const auto& ring : rings_) total += ring->dropped();
+    return total;
+}
+
+size_t LogBackend::drain() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    size_t written = 0;
+    for (const auto& ring : rings) {
+        // Ограничиваем порцию, чтобы одно шумное кольцо не задерживало остальные
+        for (size_t i = 0; i < ring->capacity() && ring->pop(drain_record_); ++i) {
+            write(drain_record_, ring->thread_id());
+            ++written;
+        }
+    }
+
+    // Кольца завершившихся потоков удаляем, когда они опустели
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [this](const std::shared_ptr<LogRing>& ring) {
+        if (ring->retired() && ring->empty()) {
+            retired_dropped_ += ring->dropped();
+            return true;
+        }
+        return false;
+    }), rings_.end());
+
+    return written;
+}
+
+void LogBackend::run() {
+    auto last_flush = std::chrono::steady_clock::now();
+    auto last_suppressed_report = last_flush;
+    while (running_.load(std::memory_order_acquire)) {
+        size_t written = drain();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_flush >= FLUSH_INTERVAL) {
+            report_dropped();
+            for (auto& sink : sinks_) sink->flush();
+            if (binary_out_) binary_out_->flush();
+            last_flush = now;
+        }
+        if (now - last_suppressed_report >= SUPPRESSED_REPORT_INTERVAL) {
+            report_suppressed();
+            last_suppressed_report = now;
+        }
+
+        if (written == 0) std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+std::string_view LogBackend::cached_format(uint32_t id) {
+    if (id >= formats_.size() || formats_[id].empty()) {
+        if (id >= formats_.size()) formats_.resize(id + 1);
+        formats_[id] = BinaryLog::format_string(id);
+    }
+    return formats_[id];
+}
+
+void LogBackend::write(const LogRing::Record& record, size_t thread_id) {
+    if (binary_out_) {
+        binary_out_->write(record.header, thread_id, record.text());
+        return;
+    }
+
+    auto kind = static_cast<RecordKind>(record.header.kind);
+    std::string_view name = kind == RecordKind::JSON ? JSON_LOGGER_NAME : TEXT_LOGGER_NAME;
+    std::string_view payload = record.text();
+
+    if (kind == RecordKind::BINARY) {
+        format_buf_.clear();
+        BinaryLog::format(format_buf_, cached_format(BinaryLog::payload_id(payload)), payload);
+        payload = std::string_view(format_buf_.data(), format_buf_.size());
+    }
+
+    spdlog::details::log_msg msg(
+            spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+                    std::chrono::nanoseconds(record.header.time_ns))),
+            spdlog::source_loc{},
+            spdlog::string_view_t(name.data(), name.size()),
+            static_cast<spdlog::level::level_enum>(record.header.level),
+            spdlog::string_view_t(payload.data(), payload.size()));
+    msg.thread_id = thread_id;
+
+    for (auto& sink : sinks_) {
+        if (sink->should_log(msg.level)) sink->log(msg);
+    }
+}
+
+void LogBackend::write_text(spdlog::level::level_enum lvl, std::string_view text) {
+    LogRing::Record record;
+    record.header.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            spdlog::log_clock::now().time_since_epoch()).count();
+    record.header.length = static_cast<uint32_t>(text.size());
+    record.header.level = static_cast<uint8_t>(lvl);
+    record.header.kind = static_cast<uint8_t>(RecordKind::TEXT);
+    record.payload.assign(text.begin(), text.end());
+    write(record, spdlog::details::os::thread_id());
+}
+
+void LogBackend::report_dropped() {
+    uint64_t total = dropped();
+    if (total == reported_dropped_) return;
+
+    std::string text = "[Logger] " + std::to_string(total - reported_dropped_) +
+                       " log records dropped on overflow (total " + std::to_string(total) + ")";
+    reported_dropped_ = total;
+    write_text(spdlog::level::warn, text);
+}
+
+void LogBackend::report_suppressed() {
+    LogSuppression::collect([this](const LogSuppression& site, uint64_t count) {
+        std::string_view file = site.file();
+        file = file.substr(file.find_last_of('/') + 1);
+
+        spdlog::memory_buf_t text;
+        if (site.policy() == LogSuppression::Policy::RATE) {
+            fmt::format_to(fmt::appender(text), "[Logger] {} log records suppressed at {}:{} (rate limit {}/s)",
+                           count, file, site.line(), site.param());
+        } else {
+            fmt::format_to(fmt::appender(text), "[Logger] {} log records suppressed at {}:{} (1 in {})",
+                           count, file, site.line(), site.param());
+        }
+        write_text(spdlog::level::info, std::string_view(text.data(), text.size()));
+    });
+}
+
+LogRing::OverflowPolicy LogBackend::policy_from_env() {
+    const char* env = std::getenv("LOG_OVERFLOW");
+    if (!env) return LogRing::OverflowPolicy::DROP;
+
+    std::string val(env);
+    std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+    if (val == "overrun") return LogRing::OverflowPolicy::OVERRUN;
+    if (val != "drop") std::cerr << "Unknown LOG_OVERFLOW '" << env << "', using drop" << std::endl;
+    return LogRing::OverflowPolicy::DROP;
+}
+
+size_t LogBackend::ring_slots_from_env() {
+    const char* env = std::getenv("LOG_QUEUE_SLOTS");
+    if (!env) return DEFAULT_RING_SLOTS;
+
+    char* end = nullptr;
+    unsigned long long slots = std::strtoull(env, &end, 10);
+    if (end == env || *end != '\0' || slots < 4 || slots > LogRing::MAX_SLOTS) {
+        std::cerr << "Invalid LOG_QUEUE_SLOTS '" << env << "', using " << DEFAULT_RING_SLOTS << std::endl;
+        return DEFAULT_RING_SLOTS;
+    }
+    return static_cast<size_t>(slots);
+}
+
+LogBackend::Mode LogBackend::mode_from_env() {
+    const char* env = std::getenv("LOG_FORMAT");
+    if (!env) return Mode::JSON;
+
+    std::string val(env);
+    std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+    if (val == "deferred") return Mode::DEFERRED;
+    if (val == "binary") return Mode::BINARY;
+    if (val != "json") std::cerr << "Unknown LOG_FORMAT '" << env << "', using json" << std::endl;
+    return Mode::JSON;
+}
+
+std::string LogBackend::binary_path_from_env() {
+    const char* env = std::getenv("LOG_BINARY_FILE");
+    return env ? env : "logs/server.bin";
+}
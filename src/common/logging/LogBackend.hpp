@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <spdlog/common.h>
+#include <spdlog/sinks/sink.h>
+
+#include "BinaryLog.hpp"
+#include "JsonFormatter.hpp"
+#include "LogLimiter.hpp"
+#include "LogRing.hpp"
+
+/**
+ * Фоновая запись логов: у каждого потока-производителя своё SPSC-кольцо (LogRing),
+ * один поток опустошает все кольца и отдаёт записи в sinks.
+ * Производитель никогда не ждёт: при переполнении запись отбрасывается или вытесняет самую старую.
+ *
+ * Настройки из окружения:
+ *  LOG_QUEUE_SLOTS — слотов по 128 байт в кольце каждого потока (по умолчанию 4096, 4..LogRing::MAX_SLOTS);
+ *  LOG_OVERFLOW    — drop (по умолчанию) или overrun;
+ *  LOG_FORMAT      — json (по умолчанию), deferred или binary (см. Mode);
+ *  LOG_BINARY_FILE — файл для режима binary (по умолчанию logs/server.bin).
+ */
+class LogBackend {
+public:
+    using RecordKind = LogRecordKind;
+
+    enum class Mode : uint8_t {
+        JSON,       // сообщение форматируется в вызывающем потоке
+        DEFERRED,   // в кольцо пишутся ID формата и аргументы, в JSON форматирует фоновый поток
+        BINARY      // как DEFERRED, но фоновый поток пишет сырые записи в файл (читает log_decoder)
+    };
+
+    static constexpr std::string_view TEXT_LOGGER_NAME = "async_logger";
+    static constexpr std::string_view JSON_LOGGER_NAME = JsonFormatter::JSON_LOGGER_NAME;
+
+    LogBackend(std::vector<spdlog::sink_ptr> sinks, size_t ring_slots, LogRing::OverflowPolicy policy,
+               Mode mode = Mode::JSON, const std::string& binary_path = {});
+    ~LogBackend();
+
+    LogBackend(const LogBackend&) = delete;
+    LogBackend& operator=(const LogBackend&) = delete;
+
+    void start();
+    // Останавливает поток, дописывая всё, что осталось в кольцах
+    void stop();
+
+    void push(spdlog::level::level_enum lvl, RecordKind kind, std::string_view payload);
+
+    // Писать ли в кольцо бинарные записи вместо готового текста
+    bool captures_binary() const { return mode_ != Mode::JSON; }
+
+    /** Сколько записей отброшено/вытеснено за всё время (включая кольца завершившихся потоков). */
+    uint64_t dropped() const;
+
+    static LogRing::OverflowPolicy policy_from_env();
+    static size_t ring_slots_from_env();
+    static Mode mode_from_env();
+    static std::string binary_path_from_env();
+
+private:
+    LogRing& local_ring();
+    LogRing& late_ring();
+    size_t drain();
+    void run();
+    void write(const LogRing::Record& record, size_t thread_id);
+    std::string_view cached_format(uint32_t id);
+    void write_text(spdlog::level::level_enum lvl, std::string_view text);
+    void report_dropped();
+    // Сводка по записям, подавленным PURITY_LOG_RATE / PURITY_LOG_EVERY_N
+    void report_suppressed();
+
+    std::vector<spdlog::sink_ptr> sinks_;
+    const size_t ring_slots_;
+    const LogRing::OverflowPolicy policy_;
+    const Mode mode_;
+
+    std::unique_ptr<BinaryLog::FileWriter> binary_out_;     // только в режиме BINARY
+    std::vector<std::string_view> formats_;                 // кэш формат-строк фонового потока
+    spdlog::memory_buf_t format_buf_;
+    // Не thread_local: stop() опустошает кольца из статических деструкторов, когда thread_local main уже разрушены
+    LogRing::Record drain_record_;
+
+    // Кольцо для потоков, чьи thread_local уже разрушены
+    std::mutex late_mutex_;
+    std::shared_ptr<LogRing> late_ring_;
+
+    mutable std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<LogRing>> rings_;
+    uint64_t retired_dropped_ = 0;      // под rings_mutex_
+    uint64_t reported_dropped_ = 0;     // только поток бэкенда
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
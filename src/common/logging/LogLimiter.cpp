@@ -0,0 +1,41 @@
+#include "LogLimiter.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct SiteRegistry {
+        std::mutex mutex;
+        std::vector<LogSuppression*> sites;
+    };
+
+    // Не разрушается: статические места вызова снимаются с регистрации в своих деструкторах при выходе из процесса
+    SiteRegistry& registry() {
+        static auto* instance = new SiteRegistry();
+        return *instance;
+    }
+}
+
+LogSuppression::LogSuppression(const char* file, int line, Policy policy, uint32_t param)
+        : file_(file), line_(line), policy_(policy), param_(param) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.sites.push_back(this);
+}
+
+LogSuppression::~LogSuppression() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::erase(reg.sites, this);
+}
+
+void LogSuppression::collect(const std::function<void(const LogSuppression&, uint64_t)>& callback) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto* site : reg.sites) {
+        if (site->pending_.load(std::memory_order_relaxed) == 0) continue;
+        uint64_t count = site->pending_.exchange(0, std::memory_order_relaxed);
+        if (count > 0) callback(*site, count);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * Ограничение логов на месте вызова: token bucket (LogRateLimiter) и 1-из-N (LogSampler).
+ * Экземпляры — function-local static в макросах PURITY_LOG_RATE / PURITY_LOG_EVERY_N (Logger.hpp).
+ *
+ * Подавленные записи считаются по месту вызова; фоновый поток логов периодически пишет сводку
+ * (LogSuppression::collect). Место вызова регистрируется в конструкторе и снимается в деструкторе.
+ */
+class LogSuppression {
+public:
+    enum class Policy : uint8_t {
+        RATE,       // param — записей в секунду
+        SAMPLE      // param — N в "1 из N"
+    };
+
+    LogSuppression(const char* file, int line, Policy policy, uint32_t param);
+    ~LogSuppression();
+
+    LogSuppression(const LogSuppression&) = delete;
+    LogSuppression& operator=(const LogSuppression&) = delete;
+
+    void add() { pending_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Подавлено с прошлого вызова collect
+    uint64_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+    const char* file() const { return file_; }
+    int line() const { return line_; }
+    Policy policy() const { return policy_; }
+    uint32_t param() const { return param_; }
+
+    /** Забирает ненулевые счётчики всех мест вызова: callback(место, подавлено с прошлого раза). */
+    static void collect(const std::function<void(const LogSuppression&, uint64_t)>& callback);
+
+private:
+    const char* file_;
+    int line_;
+    Policy policy_;
+    uint32_t param_;
+    std::atomic<uint64_t> pending_{0};
+};
+
+/**
+ * Token bucket без блокировок (GCRA): одно атомарное "теоретическое время прихода" следующей записи.
+ * Пропускает до burst записей подряд, дальше — не чаще per_second в секунду.
+ */
+class LogRateLimiter {
+public:
+    LogRateLimiter(const char* file, int line, uint32_t per_second, uint32_t burst)
+            : suppression_(file, line, LogSuppression::Policy::RATE, per_second),
+              interval_ns_(1'000'000'000LL / std::max<uint32_t>(per_second, 1)),
+              tolerance_ns_(interval_ns_ * (std::max<uint32_t>(burst, 1) - 1)) {}
+
+    bool allow() {
+        return allow(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // now_ns — монотонное время; отдельная перегрузка для тестов
+    bool allow(int64_t now_ns) {
+        int64_t tat = tat_.load(std::memory_order_relaxed);
+        while (true) {
+            int64_t start = std::max(tat, now_ns);
+            if (start - now_ns > tolerance_ns_) {
+                suppression_.add();
+                return false;
+            }
+            if (tat_.compare_exchange_weak(tat, start + interval_ns_, std::memory_order_relaxed)) return true;
+        }
+    }
+
+    const LogSuppression& suppression() const { return suppression_; }
+
+private:
+    LogSuppression suppression_;
+    const int64_t interval_ns_;
+    const int64_t tolerance_ns_;
+    std::atomic<int64_t> tat_{0};
+};
+
+/** Пропускает первую запись и затем каждую N-ю. */
+class LogSampler {
+public:
+    LogSampler(const char* file, int line, uint32_t every_n)
+            : suppression_(file, line, LogSuppression::Policy::SAMPLE, every_n),
+              every_n_(std::max<uint32_t>(every_n, 1)) {}
+
+    bool allow() {
+        if (seen_.fetch_add(1, std::memory_order_relaxed) % every_n_ == 0) return true;
+        suppression_.add();
+        return false;
+    }
+
+    const LogSuppression& suppression() const { return suppression_; }
+
+private:
+    LogSuppression suppression_;
+    const uint64_t every_n_;
+    std::atomic<uint64_t> seen_{0};
+};
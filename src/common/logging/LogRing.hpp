@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Тип записи в кольце и в бинарном файле лога
+enum class LogRecordKind : uint8_t {
+    TEXT,       // payload — сообщение, экранирует форматтер
+    JSON,       // payload — уже готовый JSON-фрагмент (сообщения с MDC)
+    BINARY,     // payload — ID формат-строки + сырые аргументы (BinaryLog)
+    FORMAT      // только в файле: определение формат-строки для BINARY
+};
+
+/**
+ * Кольцо записей лога одного потока-производителя (SPSC).
+ *
+ * Память разбита на слоты по SLOT_SIZE байт; запись занимает подряд идущие слоты
+ * (заголовок + payload, через границу кольца переносится). Индексы head_/tail_ считают слоты и только растут.
+ *
+ * При переполнении:
+ *  - DROP: запись отбрасывается, растёт dropped();
+ *  - OVERRUN: производитель сам сдвигает head_ через CAS, выкидывая самые старые записи.
+ * Потребитель копирует запись и подтверждает её CAS'ом head_ h -> h + slots: если CAS не прошёл,
+ * производитель успел затереть запись — копия выбрасывается (схема как у seqlock).
+ */
+class LogRing {
+public:
+    static constexpr size_t SLOT_SIZE = 128;
+    // Больше не бывает: самая длинная запись (полкольца) должна укладываться в Header::slots
+    static constexpr size_t MAX_SLOTS = 65536;
+
+    enum class OverflowPolicy : uint8_t {
+        DROP,
+        OVERRUN
+    };
+
+    struct Header {
+        int64_t time_ns;        // system_clock, наносекунды от эпохи
+        uint32_t length;        // длина payload
+        uint16_t slots;         // слотов на всю запись
+        uint8_t level;
+        uint8_t kind;
+    };
+
+    static constexpr size_t HEADER_SIZE = sizeof(Header);
+    static_assert(MAX_SLOTS / 2 <= UINT16_MAX, "Header::slots must hold the longest record");
+
+    struct Record {
+        Header header{};
+        std::vector<char> payload;
+
+        std::string_view text() const { return {payload.data(), header.length}; }
+    };
+
+    LogRing(size_t slots, OverflowPolicy policy, size_t thread_id)
+            : capacity_(round_up_pow2(std::clamp<size_t>(slots, 4, MAX_SLOTS))),
+              mask_(capacity_ - 1),
+              policy_(policy),
+              thread_id_(thread_id),
+              storage_(std::make_unique<char[]>(capacity_ * SLOT_SIZE)) {}
+
+    // Самая длинная запись — половина кольца, payload длиннее обрезается
+    size_t max_payload() const { return capacity_ / 2 * SLOT_SIZE - HEADER_SIZE; }
+
+    /** Только поток-владелец. false — запись отброшена (DROP). */
+    bool push(int64_t time_ns, uint8_t level, uint8_t kind, std::string_view payload) {
+        if (payload.size() > max_payload()) payload = payload.substr(0, max_payload());
+
+        const auto slots = static_cast<uint16_t>((HEADER_SIZE + payload.size() + SLOT_SIZE - 1) / SLOT_SIZE);
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+
+        while (tail + slots - head > capacity_) {
+            if (policy_ == OverflowPolicy::DROP) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // Выкидываем самую старую запись; head мог сдвинуть и потребитель — тогда просто перечитываем
+            Header oldest;
+            copy_out(head, &oldest, HEADER_SIZE);
+            if (head_.compare_exchange_weak(head, head + oldest.slots, std::memory_order_acq_rel)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                head += oldest.slots;
+            }
+        }
+
+        const Header header{time_ns, static_cast<uint32_t>(payload.size()), slots, level, kind};
+        copy_in(tail, 0, &header, HEADER_SIZE);
+        copy_in(tail, HEADER_SIZE, payload.data(), payload.size());
+        tail_.store(tail + slots, std::memory_order_release);
+        return true;
+    }
+
+    /** Только поток-потребитель. */
+    bool pop(Record& out) {
+        while (true) {
+            uint64_t head = head_.load(std::memory_order_acquire);
+            if (head == tail_.load(std::memory_order_acquire)) return false;
+
+            copy_out(head, &out.header, HEADER_SIZE);
+            size_t length = std::min<size_t>(out.header.length, max_payload());
+            if (out.payload.size() < length) out.payload.resize(length);
+            copy_out(head, out.payload.data(), length, HEADER_SIZE);
+            out.header.length = static_cast<uint32_t>(length);
+
+            uint16_t slots = out.header.slots;
+            if (slots != 0 && slots <= capacity_ &&
+                head_.compare_exchange_strong(head, head + slots, std::memory_order_acq_rel)) {
+                return true;
+            }
+            // Запись затёрта производителем во время копирования — берём следующую
+        }
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    size_t thread_id() const { return thread_id_; }
+    size_t capacity() const { return capacity_; }
+
+    // Поток-владелец завершился: кольцо удаляется после того, как опустеет
+    void retire() { retired_.store(true, std::memory_order_release); }
+    bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+    static size_t round_up_pow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    size_t byte_offset(uint64_t slot, size_t offset) const {
+        return ((slot & mask_) * SLOT_SIZE + offset) & (capacity_ * SLOT_SIZE - 1);
+    }
+
+    void copy_in(uint64_t slot, size_t offset, const void* src, size_t length) {
+        if (length == 0) return;
+        const size_t total = capacity_ * SLOT_SIZE;
+        size_t pos = byte_offset(slot, offset);
+        size_t first = std::min(length, total - pos);
+        std::memcpy(storage_.get() + pos, src, first);
+        std::memcpy(storage_.get(), static_cast<const char*>(src) + first, length - first);
+    }
+
+    void copy_out(uint64_t slot, void* dst, size_t length, size_t offset = 0) const {
+        if (length == 0) return;
+        const size_t total = capacity_ * SLOT_SIZE;
+        size_t pos = byte_offset(slot, offset);
+        size_t first = std::min(length, total - pos);
+        std::memcpy(dst, storage_.get() + pos, first);
+        std::memcpy(static_cast<char*>(dst) + first, storage_.get(), length - first);
+    }
+
+    const size_t capacity_;             // слотов, степень двойки
+    const size_t mask_;
+    const OverflowPolicy policy_;
+    const size_t thread_id_;
+    std::unique_ptr<char[]> storage_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> retired_{false};
+};
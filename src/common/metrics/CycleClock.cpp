@@ -0,0 +1,32 @@
+#include "CycleClock.hpp"
+
+#include <thread>
+
+namespace {
+    constexpr auto MIN_CALIBRATION = std::chrono::milliseconds(10);
+
+    struct Anchor {
+        std::chrono::steady_clock::time_point time;
+        uint64_t ticks;
+    };
+
+    Anchor capture() {
+        return {std::chrono::steady_clock::now(), CycleClock::now()};
+    }
+
+    const Anchor start_anchor = capture();
+}
+
+double CycleClock::ns_per_tick() {
+#if defined(__x86_64__)
+    Anchor now = capture();
+    if (now.time - start_anchor.time < MIN_CALIBRATION) {
+        std::this_thread::sleep_until(start_anchor.time + MIN_CALIBRATION);
+        now = capture();
+    }
+    auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time - start_anchor.time).count();
+    return static_cast<double>(elapsed_ns) / static_cast<double>(now.ticks - start_anchor.ticks);
+#else
+    return 1.0;
+#endif
+}
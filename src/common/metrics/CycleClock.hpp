@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Дешёвые метки времени для замеров латентности: на x86-64 — rdtsc (~7 нс против ~20 нс у steady_clock),
+ * в наносекунды переводятся только при выводе. Рассчитано на invariant TSC (все x86-64 последних лет).
+ * На других архитектурах тик — наносекунда steady_clock.
+ */
+namespace CycleClock {
+
+    inline uint64_t now() {
+#if defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Наносекунд в одном тике; калибруется по steady_clock с момента старта программы (не меньше 10 мс)
+    double ns_per_tick();
+
+    inline uint64_t to_ns(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick());
+    }
+
+} // namespace CycleClock
@@ -0,0 +1,80 @@
+#include "Histogram.hpp"
+
+#include <cmath>
+
+void Histogram::Snapshot::merge(const Snapshot& other) {
+    for (uint32_t i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+}
+
+uint64_t Histogram::Snapshot::percentile(double q) const {
+    if (count == 0) return 0;
+    auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return upper_bound(i);
+    }
+    return upper_bound(BUCKETS - 1);
+}
+
+Histogram::Summary Histogram::summarize(const Snapshot& snapshot, double scale) {
+    auto scaled = [scale](uint64_t v) { return static_cast<uint64_t>(static_cast<double>(v) * scale); };
+    Summary summary;
+    summary.count = snapshot.count;
+    summary.mean = scaled(snapshot.mean());
+    summary.p50 = scaled(snapshot.percentile(0.5));
+    summary.p90 = scaled(snapshot.percentile(0.9));
+    summary.p99 = scaled(snapshot.percentile(0.99));
+    summary.p999 = scaled(snapshot.percentile(0.999));
+    return summary;
+}
+
+HistogramSet::HistogramSet(size_t size, size_t counters)
+        : size_(size), counters_(counters), stride_(1 + counters + Histogram::BUCKETS),
+          shards_(new std::atomic<Shard*>[ThreadSlot::COUNT]()) {}
+
+HistogramSet::~HistogramSet() {
+    for (uint32_t i = 0; i < ThreadSlot::COUNT; ++i) delete shards_[i].load(std::memory_order_acquire);
+}
+
+HistogramSet::Shard* HistogramSet::create_shard(uint32_t slot) {
+    auto* shard = new Shard{std::unique_ptr<std::atomic<uint64_t>[]>(new std::atomic<uint64_t>[size_ * stride_]())};
+
+    // Гонка возможна только за SHARED: проигравший выбрасывает свой шард
+    Shard* expected = nullptr;
+    if (!shards_[slot].compare_exchange_strong(expected, shard, std::memory_order_acq_rel)) {
+        delete shard;
+        return expected;
+    }
+    return shard;
+}
+
+Histogram::Snapshot HistogramSet::snapshot(size_t index) const {
+    Histogram::Snapshot snapshot;
+    for (uint32_t s = 0; s < ThreadSlot::COUNT; ++s) {
+        const Shard* shard = shards_[s].load(std::memory_order_acquire);
+        if (!shard) continue;
+
+        const std::atomic<uint64_t>* cells = shard->cells.get() + index * stride_;
+        snapshot.sum += cells[0].load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < Histogram::BUCKETS; ++i) {
+            uint64_t n = cells[1 + counters_ + i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += n;
+            snapshot.count += n;
+        }
+    }
+    return snapshot;
+}
+
+uint64_t HistogramSet::counter(size_t index, size_t counter) const {
+    uint64_t total = 0;
+    for (uint32_t s = 0; s < ThreadSlot::COUNT; ++s) {
+        const Shard* shard = shards_[s].load(std::memory_order_acquire);
+        if (shard) total += shard->cells[index * stride_ + 1 + counter].load(std::memory_order_relaxed);
+    }
+    return total;
+}
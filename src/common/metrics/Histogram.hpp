@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ThreadSlot.hpp"
+
+/**
+ * Лог-линейная гистограмма в духе HDR: значения меньше 16 — каждое в своей корзине, дальше на каждую
+ * степень двойки по 16 корзин, т.е. относительная погрешность не больше 1/16.
+ * Значения — любые целые (тики CycleClock, байты); от 2^40 и выше попадают в последнюю корзину.
+ */
+namespace Histogram {
+
+    constexpr uint32_t SUB_BITS = 4;
+    constexpr uint32_t SUB_COUNT = 1u << SUB_BITS;
+    constexpr uint32_t MAX_EXPONENT = 40;
+    constexpr uint32_t BUCKETS = (MAX_EXPONENT - SUB_BITS + 1) * SUB_COUNT;
+
+    constexpr uint32_t bucket_of(uint64_t value) {
+        if (value < SUB_COUNT) return static_cast<uint32_t>(value);
+        auto exponent = static_cast<uint32_t>(std::bit_width(value) - 1);
+        if (exponent >= MAX_EXPONENT) return BUCKETS - 1;
+        auto sub = static_cast<uint32_t>(value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+        return (exponent - SUB_BITS + 1) * SUB_COUNT + sub;
+    }
+
+    // Наименьшее значение, попадающее в корзину
+    constexpr uint64_t lower_bound(uint32_t bucket) {
+        if (bucket < SUB_COUNT) return bucket;
+        uint32_t exponent = bucket / SUB_COUNT + SUB_BITS - 1;
+        uint64_t sub = bucket % SUB_COUNT;
+        return (SUB_COUNT + sub) << (exponent - SUB_BITS);
+    }
+
+    // Наибольшее значение корзины (у последней — условно её верхняя граница)
+    constexpr uint64_t upper_bound(uint32_t bucket) {
+        return lower_bound(bucket + 1) - 1;
+    }
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        void merge(const Snapshot& other);
+
+        /** Значение, не меньше которого доля q записей (0 < q ≤ 1); верхняя граница корзины, 0 — если пусто. */
+        uint64_t percentile(double q) const;
+
+        uint64_t mean() const { return count ? sum / count : 0; }
+    };
+
+    // Квантили в единицах вывода: значения умножаются на scale (например, CycleClock::ns_per_tick())
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t mean = 0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t p999 = 0;
+    };
+
+    Summary summarize(const Snapshot& snapshot, double scale = 1.0);
+
+} // namespace Histogram
+
+/**
+ * Набор из size() гистограмм (например, по одной на опкод) с отдельным шардом на каждый поток.
+ * record() пишет в шард своего потока обычными load/store — без RMW и без общих с другими потоками
+ * кэш-линий; snapshot() суммирует шарды и может идти параллельно с записью (счётчики — relaxed atomics).
+ * Шард потока создаётся при его первой записи и живёт, пока жив набор.
+ * Рядом с каждой гистограммой — counters() простых счётчиков (add/counter), в той же строке шарда:
+ * пакеты и байты опкода пишутся в ту же кэш-линию, что и сумма латентности.
+ */
+class HistogramSet {
+public:
+    explicit HistogramSet(size_t size, size_t counters = 0);
+    ~HistogramSet();
+
+    HistogramSet(const HistogramSet&) = delete;
+    HistogramSet& operator=(const HistogramSet&) = delete;
+
+    void record(size_t index, uint64_t value) {
+        uint32_t slot = ThreadSlot::current();
+        std::atomic<uint64_t>* cells = row(slot, index);
+        bump(slot, cells[0], value);
+        bump(slot, cells[1 + counters_ + Histogram::bucket_of(value)], 1);
+    }
+
+    void add(size_t index, size_t counter, uint64_t n = 1) {
+        uint32_t slot = ThreadSlot::current();
+        bump(slot, row(slot, index)[1 + counter], n);
+    }
+
+    Histogram::Snapshot snapshot(size_t index) const;
+
+    uint64_t counter(size_t index, size_t counter) const;
+
+    size_t size() const { return size_; }
+
+    size_t counters() const { return counters_; }
+
+private:
+    struct Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> cells;
+    };
+
+    std::atomic<uint64_t>* row(uint32_t slot, size_t index) {
+        Shard* shard = shards_[slot].load(std::memory_order_acquire);
+        if (!shard) [[unlikely]] shard = create_shard(slot);
+        return shard->cells.get() + index * stride_;
+    }
+
+    // Единственный писатель шарда — его поток; в SHARED пишут все лишние потоки, там нужен RMW
+    static void bump(uint32_t slot, std::atomic<uint64_t>& cell, uint64_t delta) {
+        if (slot != ThreadSlot::SHARED) [[likely]] {
+            cell.store(cell.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        } else {
+            cell.fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    Shard* create_shard(uint32_t slot);
+
+    size_t size_;
+    size_t counters_;
+    size_t stride_;             // [sum][counters...][buckets...] на каждую гистограмму
+    std::unique_ptr<std::atomic<Shard*>[]> shards_;
+};
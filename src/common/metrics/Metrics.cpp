@@ -0,0 +1,121 @@
+#include "Metrics.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <stdexcept>
+
+namespace {
+    constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+    const char* type_name(Metrics::Type type) {
+        switch (type) {
+            case Metrics::Type::COUNTER: return "counter";
+            case Metrics::Type::GAUGE: return "gauge";
+            case Metrics::Type::SUMMARY: return "summary";
+        }
+        return "untyped";
+    }
+
+    // name{labels} или name{labels,extra}
+    void append_series_name(std::string& out, const std::string& name, const std::string& labels,
+                            const std::string& extra = {}) {
+        out += name;
+        if (labels.empty() && extra.empty()) return;
+        out += '{';
+        out += labels;
+        if (!labels.empty() && !extra.empty()) out += ',';
+        out += extra;
+        out += '}';
+    }
+}
+
+Metrics::Registry& Metrics::Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+Metrics::Registry::Series&
+Metrics::Registry::series(const std::string& name, const std::string& help, Type type, const std::string& labels) {
+    Family* family = nullptr;
+    for (auto& f : families_) {
+        if (f.name == name) {
+            family = &f;
+            break;
+        }
+    }
+    if (!family) {
+        families_.push_back(Family{name, help, type, {}});
+        family = &families_.back();
+    } else if (family->type != type) {
+        throw std::logic_error("metric " + name + " registered with another type");
+    }
+
+    for (auto& s : family->series) {
+        if (s->labels == labels) return *s;
+    }
+    family->series.push_back(std::make_unique<Series>());
+    family->series.back()->labels = labels;
+    return *family->series.back();
+}
+
+Metrics::Counter& Metrics::Registry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = series(name, help, Type::COUNTER, labels);
+    if (!s.counter) s.counter = std::make_unique<Counter>();
+    return *s.counter;
+}
+
+Metrics::Gauge& Metrics::Registry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = series(name, help, Type::GAUGE, labels);
+    if (!s.gauge) s.gauge = std::make_unique<Gauge>();
+    return *s.gauge;
+}
+
+Metrics::Timer& Metrics::Registry::timer(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = series(name, help, Type::SUMMARY, labels);
+    if (!s.timer) s.timer = std::make_unique<Timer>();
+    return *s.timer;
+}
+
+void Metrics::Registry::callback(const std::string& name, const std::string& help, Type type,
+                                 std::function<double()> read, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    series(name, help, type, labels).read = std::move(read);
+}
+
+std::string Metrics::Registry::render() const {
+    double seconds_per_tick = CycleClock::ns_per_tick() * 1e-9;
+    std::string out;
+    out.reserve(4096);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n",
+                       family.name, family.help, family.name, type_name(family.type));
+
+        for (const auto& s : family.series) {
+            if (s->timer) {
+                auto snapshot = s->timer->snapshot();
+                for (double q : QUANTILES) {
+                    append_series_name(out, family.name, s->labels, fmt::format("quantile=\"{}\"", q));
+                    fmt::format_to(std::back_inserter(out), " {}\n",
+                                   static_cast<double>(snapshot.percentile(q)) * seconds_per_tick);
+                }
+                append_series_name(out, family.name + "_sum", s->labels);
+                fmt::format_to(std::back_inserter(out), " {}\n", static_cast<double>(snapshot.sum) * seconds_per_tick);
+                append_series_name(out, family.name + "_count", s->labels);
+                fmt::format_to(std::back_inserter(out), " {}\n", snapshot.count);
+                continue;
+            }
+
+            append_series_name(out, family.name, s->labels);
+            if (s->counter) fmt::format_to(std::back_inserter(out), " {}\n", s->counter->value());
+            else if (s->gauge) fmt::format_to(std::back_inserter(out), " {}\n", s->gauge->value());
+            else if (s->read) fmt::format_to(std::back_inserter(out), " {}\n", s->read());
+            else out += " 0\n";
+        }
+    }
+    return out;
+}
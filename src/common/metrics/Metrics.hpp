@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CycleClock.hpp"
+#include "Histogram.hpp"
+#include "ThreadSlot.hpp"
+
+/**
+ * Метрики процесса. Запись — в шард своего потока (ThreadSlot) обычными load/store, без общих кэш-линий;
+ * суммирование по шардам — только при выдаче (Registry::render, раз в scrape).
+ *
+ *     static Metrics::Counter& packets = Metrics::Registry::instance().counter(
+ *             "purity_packets_received_total", "Frames received from clients");
+ *     packets.add();
+ *
+ * Метрики живут до конца процесса; повторная регистрация того же имени и меток отдаёт тот же объект.
+ */
+namespace Metrics {
+
+    // Монотонный счётчик
+    class Counter {
+    public:
+        Counter() : cells_(new Cell[ThreadSlot::COUNT]) {}
+
+        void add(uint64_t n = 1) {
+            uint32_t slot = ThreadSlot::current();
+            std::atomic<uint64_t>& cell = cells_[slot].value;
+            if (slot != ThreadSlot::SHARED) [[likely]] {
+                cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            } else {
+                cell.fetch_add(n, std::memory_order_relaxed);
+            }
+        }
+
+        uint64_t value() const {
+            uint64_t total = 0;
+            for (uint32_t i = 0; i < ThreadSlot::COUNT; ++i) total += cells_[i].value.load(std::memory_order_relaxed);
+            return total;
+        }
+
+    private:
+        struct alignas(64) Cell {
+            std::atomic<uint64_t> value{0};
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+    };
+
+    // Текущее значение, меняющееся приращениями из разных потоков (сессии, глубина очередей)
+    class Gauge {
+    public:
+        // Приращения копятся по модулю 2^64, сумма шардов — точное значение со знаком
+        void add(int64_t delta = 1) { deltas_.add(static_cast<uint64_t>(delta)); }
+
+        void sub(int64_t delta = 1) { add(-delta); }
+
+        int64_t value() const { return static_cast<int64_t>(deltas_.value()); }
+
+    private:
+        Counter deltas_;
+    };
+
+    // Распределение длительностей; отдаётся как summary: квантили, _sum и _count в секундах
+    class Timer {
+    public:
+        Timer() : histogram_(1) {}
+
+        void record_ticks(uint64_t ticks) { histogram_.record(0, ticks); }
+
+        Histogram::Snapshot snapshot() const { return histogram_.snapshot(0); }
+
+        // Замер от конструктора до деструктора
+        class Scope {
+        public:
+            explicit Scope(Timer& timer) : timer_(timer), start_(CycleClock::now()) {}
+            ~Scope() { timer_.record_ticks(CycleClock::now() - start_); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Timer& timer_;
+            uint64_t start_;
+        };
+
+    private:
+        HistogramSet histogram_;
+    };
+
+    enum class Type : uint8_t {
+        COUNTER,
+        GAUGE,
+        SUMMARY
+    };
+
+    class Registry {
+    public:
+        static Registry& instance();
+
+        // labels — уже готовые пары без скобок: mode="auth"
+        Counter& counter(const std::string& name, const std::string& help, const std::string& labels = {});
+        Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = {});
+        Timer& timer(const std::string& name, const std::string& help, const std::string& labels = {});
+
+        // Значение, которое уже считает кто-то другой (например, Logger::dropped_messages); вызывается на scrape
+        void callback(const std::string& name, const std::string& help, Type type, std::function<double()> read,
+                      const std::string& labels = {});
+
+        /** Текстовый формат Prometheus 0.0.4; семейства в порядке регистрации. */
+        std::string render() const;
+
+    private:
+        struct Series {
+            std::string labels;
+            std::unique_ptr<Counter> counter;
+            std::unique_ptr<Gauge> gauge;
+            std::unique_ptr<Timer> timer;
+            std::function<double()> read;
+        };
+
+        struct Family {
+            std::string name;
+            std::string help;
+            Type type;
+            std::vector<std::unique_ptr<Series>> series;
+        };
+
+        Series& series(const std::string& name, const std::string& help, Type type, const std::string& labels);
+
+        mutable std::mutex mutex_;
+        std::vector<Family> families_;
+    };
+
+} // namespace Metrics
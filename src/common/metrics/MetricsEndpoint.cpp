@@ -0,0 +1,82 @@
+#include "MetricsEndpoint.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "Logger.hpp"
+#include "Metrics.hpp"
+
+using boost::asio::ip::tcp;
+
+namespace {
+    // Запрос и ответ одного соединения; живёт, пока на него ссылаются обработчики
+    struct Exchange : std::enable_shared_from_this<Exchange> {
+        explicit Exchange(tcp::socket s) : socket(std::move(s)), request(MetricsEndpoint::MAX_REQUEST) {}
+
+        void start() {
+            boost::asio::async_read_until(
+                    socket, request, "\r\n\r\n",
+                    [self = shared_from_this()](boost::system::error_code ec, std::size_t) {
+                        if (ec) return;     // клиент ушёл или запрос слишком длинный
+                        self->respond();
+                    });
+        }
+
+        void respond() {
+            auto data = request.data();
+            std::string_view head(static_cast<const char *>(data.data()), data.size());
+            std::string_view line = head.substr(0, head.find("\r\n"));
+
+            if (line.starts_with("GET /metrics ") || line.starts_with("GET /metrics?")) {
+                std::string body = Metrics::Registry::instance().render();
+                response = fmt::format("HTTP/1.1 200 OK\r\n"
+                                       "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                       "Content-Length: {}\r\nConnection: close\r\n\r\n", body.size());
+                response += body;
+            } else {
+                response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            }
+
+            boost::asio::async_write(
+                    socket, boost::asio::buffer(response),
+                    [self = shared_from_this()](boost::system::error_code, std::size_t) {
+                        boost::system::error_code ignored;
+                        self->socket.shutdown(tcp::socket::shutdown_both, ignored);
+                        self->socket.close(ignored);
+                    });
+        }
+
+        tcp::socket socket;
+        boost::asio::streambuf request;
+        std::string response;
+    };
+}
+
+MetricsEndpoint::MetricsEndpoint(boost::asio::io_context &io_context, uint16_t port)
+        : acceptor_(io_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), port)),
+          port_(acceptor_.local_endpoint().port()) {}
+
+void MetricsEndpoint::start() {
+    Logger::get().info("[Metrics] Serving /metrics on 127.0.0.1:{}", port_);
+    do_accept();
+}
+
+void MetricsEndpoint::stop() {
+    boost::system::error_code ec;
+    acceptor_.close(ec);
+}
+
+void MetricsEndpoint::do_accept() {
+    acceptor_.async_accept(
+            [self = shared_from_this()](boost::system::error_code ec, tcp::socket socket) {
+                if (ec) {
+                    if (ec != boost::asio::error::operation_aborted && self->acceptor_.is_open()) {
+                        Logger::get().error("[Metrics] Accept error: {}", ec.message());
+                        self->do_accept();
+                    }
+                    return;
+                }
+                std::make_shared<Exchange>(std::move(socket))->start();
+                self->do_accept();
+            });
+}
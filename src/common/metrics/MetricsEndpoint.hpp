@@ -0,0 +1,32 @@
+#pragma once
+
+// <utility> до asio: awaitable.hpp в Boost 1.74 использует std::exchange, не подключая его (GCC 12, C++20)
+#include <utility>
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <memory>
+
+/**
+ * HTTP-ответ на GET /metrics с Registry::render() — для Prometheus.
+ * Слушает только 127.0.0.1: наружу метрики отдаёт агент/прокси на той же машине.
+ * Одно соединение — один запрос (Connection: close); запросы длиннее MAX_REQUEST отбрасываются.
+ */
+class MetricsEndpoint : public std::enable_shared_from_this<MetricsEndpoint> {
+public:
+    static constexpr size_t MAX_REQUEST = 8192;
+
+    // port 0 — свободный порт на выбор ОС (см. port())
+    MetricsEndpoint(boost::asio::io_context &io_context, uint16_t port);
+
+    void start();
+
+    void stop();
+
+    uint16_t port() const { return port_; }
+
+private:
+    void do_accept();
+
+    boost::asio::ip::tcp::acceptor acceptor_;
+    uint16_t port_;
+};
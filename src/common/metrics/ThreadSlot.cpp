@@ -0,0 +1,40 @@
+#include "ThreadSlot.hpp"
+
+#include <bitset>
+#include <mutex>
+
+namespace {
+    std::mutex slots_mutex;
+    std::bitset<ThreadSlot::MAX_THREADS> used_slots;
+}
+
+// Возвращает номер при завершении потока; записи из более поздних thread_local-деструкторов идут в SHARED
+struct ThreadSlot::Releaser {
+    uint32_t slot = SHARED;
+
+    ~Releaser() {
+        slot_ = SHARED;
+        if (slot == SHARED) return;
+        std::lock_guard<std::mutex> lock(slots_mutex);
+        used_slots.reset(slot);
+    }
+};
+
+uint32_t ThreadSlot::acquire() {
+    thread_local Releaser releaser;
+
+    uint32_t slot = SHARED;
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex);
+        for (uint32_t i = 0; i < MAX_THREADS; ++i) {
+            if (!used_slots.test(i)) {
+                used_slots.set(i);
+                slot = i;
+                break;
+            }
+        }
+    }
+    releaser.slot = slot;
+    slot_ = slot;
+    return slot;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Небольшой номер текущего потока (0..MAX_THREADS-1) для потоковых шардов метрик.
+ * Пока поток жив, номер только его: в свой шард он пишет обычными load/store без RMW.
+ * После завершения потока номер освобождается и достаётся следующему — вместе с накопленным шардом.
+ * Потоков больше MAX_THREADS: все лишние получают SHARED, шард которого пишется атомарными RMW.
+ */
+class ThreadSlot {
+public:
+    static constexpr uint32_t MAX_THREADS = 128;
+    static constexpr uint32_t SHARED = MAX_THREADS;
+    static constexpr uint32_t COUNT = MAX_THREADS + 1;     // с учётом SHARED
+
+    static uint32_t current() {
+        if (slot_ != UNASSIGNED) [[likely]] return slot_;
+        return acquire();
+    }
+
+private:
+    static constexpr uint32_t UNASSIGNED = UINT32_MAX;
+
+    struct Releaser;
+
+    static uint32_t acquire();
+
+    // Константная инициализация: доступ без проверки guard'а на каждом вызове
+    static inline thread_local uint32_t slot_ = UNASSIGNED;
+};
@@ -2,42 +2,84 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
 #include <algorithm> // для std::reverse
+#include <bit>
 #include <endian.h>
 #include "Logger.hpp"
-
+#include "ByteSwap.hpp"
+
+/**
+ * Буфер пакета с малым встроенным хранилищем: первые INLINE_CAPACITY байт лежат в самом объекте,
+ * в кучу буфер уходит только когда их не хватило. Pong, auth response и challenge (97 байт)
+ * собираются без обращений к аллокатору.
+ * Каждый write_* — одна проверка места и memcpy.
+ */
 class ByteBuffer {
 public:
+    static constexpr size_t INLINE_CAPACITY = 128;
+
     ByteBuffer() = default;
-    explicit ByteBuffer(const std::vector<uint8_t>& data) : buffer_(data), read_pos_(0) {}
+    ByteBuffer(const uint8_t* data, size_t length) { write_bytes(data, length); }
+    explicit ByteBuffer(const std::vector<uint8_t>& data) : ByteBuffer(data.data(), data.size()) {}
+
+    ByteBuffer(const ByteBuffer& other) : read_pos_(other.read_pos_) {
+        write_bytes(other.data_, other.size_);
+    }
+
+    ByteBuffer(ByteBuffer&& other) noexcept { take(other); }
+
+    ByteBuffer& operator=(const ByteBuffer& other) {
+        if (this != &other) {
+            size_ = 0;
+            write_bytes(other.data_, other.size_);
+            read_pos_ = other.read_pos_;
+        }
+        return *this;
+    }
+
+    ByteBuffer& operator=(ByteBuffer&& other) noexcept {
+        if (this != &other) {
+            heap_.reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    // Место под total байт целиком; дальнейшие write_* до этого размера не перевыделяют
+    void reserve(size_t total) {
+        if (total > capacity_) reallocate(total);
+    }
 
     // ==================== WRITE METHODS ====================
 
-    void write_uint8(uint8_t value) { buffer_.push_back(value); }
-    void write_int8(int8_t value) { buffer_.push_back(static_cast<uint8_t>(value)); }
+    void write_uint8(uint8_t value) {
+        ensure_space(1);
+        data_[size_++] = value;
+    }
+    void write_int8(int8_t value) { write_uint8(static_cast<uint8_t>(value)); }
 
     // ---------- Big-Endian ----------
 
     void write_uint16_be(uint16_t value) {
-        uint16_t be = htobe16(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&be), sizeof(be));
+        append<uint16_t>(htobe16(value));
     }
     void write_int16_be(int16_t value) { write_uint16_be(static_cast<uint16_t>(value)); }
 
     void write_uint32_be(uint32_t value) {
-        uint32_t be = htobe32(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&be), sizeof(be));
+        append<uint32_t>(htobe32(value));
     }
     void write_int32_be(int32_t value) { write_uint32_be(static_cast<uint32_t>(value)); }
 
     void write_uint64_be(uint64_t value) {
-        uint64_t be = htobe64(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&be), sizeof(be));
+        append<uint64_t>(htobe64(value));
     }
     void write_int64_be(int64_t value) { write_uint64_be(static_cast<uint64_t>(value)); }
 
@@ -58,20 +100,17 @@ public:
     // ---------- Little-Endian ----------
 
     void write_uint16_le(uint16_t value) {
-        uint16_t le = htole16(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&le), sizeof(le));
+        append<uint16_t>(htole16(value));
     }
     void write_int16_le(int16_t value) { write_uint16_le(static_cast<uint16_t>(value)); }
 
     void write_uint32_le(uint32_t value) {
-        uint32_t le = htole32(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&le), sizeof(le));
+        append<uint32_t>(htole32(value));
     }
     void write_int32_le(int32_t value) { write_uint32_le(static_cast<uint32_t>(value)); }
 
     void write_uint64_le(uint64_t value) {
-        uint64_t le = htole64(value);
-        write_bytes(reinterpret_cast<const uint8_t*>(&le), sizeof(le));
+        append<uint64_t>(htole64(value));
     }
     void write_int64_le(int64_t value) { write_uint64_le(static_cast<uint64_t>(value)); }
 
@@ -89,8 +128,21 @@ public:
         write_uint64_le(int_val);
     }
 
+    // ---------- Arrays ----------
+    // Весь массив — одна проверка места; порядок байт совпал с хостом — memcpy, иначе SIMD-перестановка
+
+    void write_array_u16_be(std::span<const uint16_t> values) { write_array<std::endian::big>(values); }
+    void write_array_u32_be(std::span<const uint32_t> values) { write_array<std::endian::big>(values); }
+    void write_array_u64_be(std::span<const uint64_t> values) { write_array<std::endian::big>(values); }
+    void write_array_f32_be(std::span<const float> values) { write_array<std::endian::big>(values); }
+
+    void write_array_u16_le(std::span<const uint16_t> values) { write_array<std::endian::little>(values); }
+    void write_array_u32_le(std::span<const uint32_t> values) { write_array<std::endian::little>(values); }
+    void write_array_u64_le(std::span<const uint64_t> values) { write_array<std::endian::little>(values); }
+    void write_array_f32_le(std::span<const float> values) { write_array<std::endian::little>(values); }
+
     // ---------- Boolean ----------
-    void write_bool(bool value) { buffer_.push_back(value ? 1 : 0); }
+    void write_bool(bool value) { write_uint8(value ? 1 : 0); }
 
     // ---------- Strings ----------
 
@@ -100,24 +152,25 @@ public:
     }
 
     std::string read_string_raw_be(size_t length) {
-        check_read(length, ReadSource::READ_STRING_RAW);
-        std::string str(reinterpret_cast<const char*>(&buffer_[read_pos_]), length);
-        read_pos_ += length;
-        return str;
+        return std::string(read_string_view_raw(length));
+    }
+
+    // Без копирования: view действителен, пока буфер не изменён
+    std::string_view read_string_view_raw(size_t length) {
+        auto bytes = read_span(length);
+        return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
     }
 
     // Raw string write/read LE (reversed)
     void write_string_raw_le(const std::string& str) {
-        std::string reversed_str(str.rbegin(), str.rend());
-        write_bytes(reinterpret_cast<const uint8_t*>(reversed_str.data()), reversed_str.size());
+        ensure_space(str.size());
+        std::reverse_copy(str.begin(), str.end(), data_ + size_);
+        size_ += str.size();
     }
 
     std::string read_string_raw_le(size_t length) {
-        check_read(length, ReadSource::READ_STRING_RAW);
-        std::string str(reinterpret_cast<const char*>(&buffer_[read_pos_]), length);
-        read_pos_ += length;
-        std::reverse(str.begin(), str.end());
-        return str;
+        auto view = read_string_view_raw(length);
+        return {view.rbegin(), view.rend()};
     }
 
     // Null-terminated string write/read BE (write as is + '\0', read until '\0')
@@ -127,13 +180,20 @@ public:
     }
 
     std::string read_string_nt_be() {
-        std::string str;
-        while (read_pos_ < buffer_.size()) {
-            char c = static_cast<char>(buffer_[read_pos_++]);
-            if (c == '\0') break;
-            str += c;
-        }
-        return str;
+        return std::string(read_string_view_nt());
+    }
+
+    /**
+     * BE null-terminated строка без копирования (терминатор пропускается, без него — до конца буфера).
+     * view действителен, пока буфер не изменён. LE-строки хранятся перевёрнутыми — для них read_string_nt_le.
+     */
+    std::string_view read_string_view_nt() {
+        const uint8_t* begin = data_ + read_pos_;
+        size_t available = size_ - read_pos_;
+        const auto* nul = static_cast<const uint8_t*>(std::memchr(begin, 0, available));
+        size_t length = nul ? static_cast<size_t>(nul - begin) : available;
+        read_pos_ += nul ? length + 1 : length;
+        return {reinterpret_cast<const char*>(begin), length};
     }
 
     // Null-terminated string write/read LE (reverse string, write + '\0', read reversed and flip)
@@ -143,39 +203,46 @@ public:
     }
 
     std::string read_string_nt_le() {
-        std::string str;
-        while (read_pos_ < buffer_.size()) {
-            char c = static_cast<char>(buffer_[read_pos_++]);
-            if (c == '\0') break;
-            str += c;
-        }
-        std::reverse(str.begin(), str.end());
-        return str;
+        auto view = read_string_view_nt();
+        return {view.rbegin(), view.rend()};
     }
 
     // ---------- Bytes ----------
     void write_bytes(const uint8_t* data, size_t length) {
-        size_t old_size = buffer_.size();
-        buffer_.resize(old_size + length);
-        std::memcpy(buffer_.data() + old_size, data, length);
+        if (length == 0) return;
+        ensure_space(length);
+        std::memcpy(data_ + size_, data, length);
+        size_ += length;
     }
 
-    void write_bytes(const std::vector<uint8_t>& data) {
+    // length байт в конец буфера (одна проверка места); заполняет вызывающий, указатель живёт до следующей записи
+    uint8_t* write_raw(size_t length) {
+        ensure_space(length);
+        uint8_t* out = data_ + size_;
+        size_ += length;
+        return out;
+    }
+
+    void write_bytes(std::span<const uint8_t> data) {
         write_bytes(data.data(), data.size());
     }
 
+    void write_bytes(const ByteBuffer& other) {
+        write_bytes(other.data_, other.size_);
+    }
+
     // ==================== READ METHODS ====================
 
     uint8_t read_uint8() {
         check_read(sizeof(uint8_t), ReadSource::READ_UINT8);
-        return buffer_[read_pos_++];
+        return data_[read_pos_++];
     }
     int8_t read_int8() { return static_cast<int8_t>(read_uint8()); }
 
     uint16_t read_uint16_be() {
         check_read(sizeof(uint16_t), ReadSource::READ_UINT16_BE);
         uint16_t be;
-        std::memcpy(&be, &buffer_[read_pos_], sizeof(be));
+        std::memcpy(&be, data_ + read_pos_, sizeof(be));
         read_pos_ += sizeof(be);
         return be16toh(be);
     }
@@ -184,7 +251,7 @@ public:
     uint32_t read_uint32_be() {
         check_read(sizeof(uint32_t), ReadSource::READ_UINT32_BE);
         uint32_t be;
-        std::memcpy(&be, &buffer_[read_pos_], sizeof(be));
+        std::memcpy(&be, data_ + read_pos_, sizeof(be));
         read_pos_ += sizeof(be);
         return be32toh(be);
     }
@@ -193,7 +260,7 @@ public:
     uint64_t read_uint64_be() {
         check_read(sizeof(uint64_t), ReadSource::READ_UINT64_BE);
         uint64_t be;
-        std::memcpy(&be, &buffer_[read_pos_], sizeof(be));
+        std::memcpy(&be, data_ + read_pos_, sizeof(be));
         read_pos_ += sizeof(be);
         return be64toh(be);
     }
@@ -216,7 +283,7 @@ public:
     uint16_t read_uint16_le() {
         check_read(sizeof(uint16_t), ReadSource::READ_UINT16_LE);
         uint16_t le;
-        std::memcpy(&le, &buffer_[read_pos_], sizeof(le));
+        std::memcpy(&le, data_ + read_pos_, sizeof(le));
         read_pos_ += sizeof(le);
         return le16toh(le);
     }
@@ -225,7 +292,7 @@ public:
     uint32_t read_uint32_le() {
         check_read(sizeof(uint32_t), ReadSource::READ_UINT32_LE);
         uint32_t le;
-        std::memcpy(&le, &buffer_[read_pos_], sizeof(le));
+        std::memcpy(&le, data_ + read_pos_, sizeof(le));
         read_pos_ += sizeof(le);
         return le32toh(le);
     }
@@ -234,7 +301,7 @@ public:
     uint64_t read_uint64_le() {
         check_read(sizeof(uint64_t), ReadSource::READ_UINT64_LE);
         uint64_t le;
-        std::memcpy(&le, &buffer_[read_pos_], sizeof(le));
+        std::memcpy(&le, data_ + read_pos_, sizeof(le));
         read_pos_ += sizeof(le);
         return le64toh(le);
     }
@@ -254,18 +321,42 @@ public:
         return value;
     }
 
+    // Ровно out.size() элементов; не хватает данных — исключение, out не тронут
+    void read_array_u16_be(std::span<uint16_t> out) { read_array<std::endian::big>(out); }
+    void read_array_u32_be(std::span<uint32_t> out) { read_array<std::endian::big>(out); }
+    void read_array_u64_be(std::span<uint64_t> out) { read_array<std::endian::big>(out); }
+    void read_array_f32_be(std::span<float> out) { read_array<std::endian::big>(out); }
+
+    void read_array_u16_le(std::span<uint16_t> out) { read_array<std::endian::little>(out); }
+    void read_array_u32_le(std::span<uint32_t> out) { read_array<std::endian::little>(out); }
+    void read_array_u64_le(std::span<uint64_t> out) { read_array<std::endian::little>(out); }
+    void read_array_f32_le(std::span<float> out) { read_array<std::endian::little>(out); }
+
     bool read_bool() {
         check_read(sizeof(uint8_t), ReadSource::READ_BOOL);
         return read_uint8() != 0;
     }
 
     std::vector<uint8_t> read_bytes(size_t length) {
+        auto bytes = read_span(length);
+        return {bytes.begin(), bytes.end()};
+    }
+
+    // Без копирования: span действителен, пока буфер не изменён
+    std::span<const uint8_t> read_span(size_t length) {
         check_read(length, ReadSource::READ_BYTES);
-        std::vector<uint8_t> bytes(buffer_.begin() + read_pos_, buffer_.begin() + read_pos_ + length);
+        std::span<const uint8_t> bytes(data_ + read_pos_, length);
         read_pos_ += length;
         return bytes;
     }
 
+    // Ровно out.size() байт в память вызывающего
+    void read_into(std::span<uint8_t> out) {
+        check_read(out.size(), ReadSource::READ_BYTES);
+        if (!out.empty()) std::memcpy(out.data(), data_ + read_pos_, out.size());
+        read_pos_ += out.size();
+    }
+
     // ==================== UTILITY METHODS ====================
 
     void skip(size_t bytes) {
@@ -273,8 +364,9 @@ public:
         read_pos_ += bytes;
     }
 
+    // Данные отбрасываются, выделенная память остаётся
     void clear() {
-        buffer_.clear();
+        size_ = 0;
         read_pos_ = 0;
     }
 
@@ -282,10 +374,16 @@ public:
         read_pos_ = 0;
     }
 
-    const std::vector<uint8_t>& data() const { return buffer_; }
-    size_t size() const { return buffer_.size(); }
+    const uint8_t* data() const { return data_; }
+    std::span<const uint8_t> bytes() const { return {data_, size_}; }
+    std::vector<uint8_t> to_vector() const { return {data_, data_ + size_}; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
     size_t read_pos() const { return read_pos_; }
 
+    // false — данные во встроенном хранилище, куча не тронута
+    bool on_heap() const { return heap_ != nullptr; }
+
 private:
     enum class ReadSource {
         READ_UINT8,
@@ -310,6 +408,7 @@ private:
         READ_DOUBLE_LE,
 
         READ_BOOL,
+        READ_ARRAY,
         READ_STRING_RAW,
         READ_BYTES,
         SKIP,
@@ -338,6 +437,7 @@ private:
             case ReadSource::READ_FLOAT_LE: return "read_float_le";
             case ReadSource::READ_DOUBLE_LE: return "read_double_le";
             case ReadSource::READ_BOOL: return "read_bool";
+            case ReadSource::READ_ARRAY: return "read_array";
             case ReadSource::READ_STRING_RAW: return "read_string_raw";
             case ReadSource::READ_BYTES: return "read_bytes";
             case ReadSource::SKIP: return "skip";
@@ -347,16 +447,78 @@ private:
     }
 
     void check_read(size_t size, ReadSource source) const {
-        if (read_pos_ + size > buffer_.size()) {
+        if (size > size_ - read_pos_) {
             std::ostringstream oss;
             oss << "[ByteBuffer] Not enough data! Source: " << read_source_to_string(source)
                 << " | Wanted: " << size << " bytes | ReadPos: " << read_pos_
-                << " | BufferSize: " << buffer_.size();
-            Logger::get()->error("{}", oss.str());
+                << " | BufferSize: " << size_;
+            Logger::get().error("{}", oss.str());
             throw std::out_of_range("ByteBuffer: not enough data to read");
         }
     }
 
-    std::vector<uint8_t> buffer_;
+    template<std::endian ORDER, typename T>
+    void write_array(std::span<const T> values) {
+        static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+        if (values.empty()) return;
+        uint8_t* out = write_raw(values.size_bytes());
+        if constexpr (ORDER == std::endian::native) std::memcpy(out, values.data(), values.size_bytes());
+        else ByteSwap::copy_swap<sizeof(T)>(out, values.data(), values.size());
+    }
+
+    template<std::endian ORDER, typename T>
+    void read_array(std::span<T> out) {
+        static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+        check_read(out.size_bytes(), ReadSource::READ_ARRAY);
+        if (out.empty()) return;
+        if constexpr (ORDER == std::endian::native) std::memcpy(out.data(), data_ + read_pos_, out.size_bytes());
+        else ByteSwap::copy_swap<sizeof(T)>(out.data(), data_ + read_pos_, out.size());
+        read_pos_ += out.size_bytes();
+    }
+
+    template<typename T>
+    void append(T value) {
+        ensure_space(sizeof(T));
+        std::memcpy(data_ + size_, &value, sizeof(T));
+        size_ += sizeof(T);
+    }
+
+    void ensure_space(size_t length) {
+        if (length > capacity_ - size_) reallocate(std::max(capacity_ * 2, size_ + length));
+    }
+
+    void reallocate(size_t capacity) {
+        auto storage = std::make_unique_for_overwrite<uint8_t[]>(capacity);
+        std::memcpy(storage.get(), data_, size_);
+        heap_ = std::move(storage);
+        data_ = heap_.get();
+        capacity_ = capacity;
+    }
+
+    // Кучу забираем, встроенные байты копируем; other остаётся пустым
+    void take(ByteBuffer& other) noexcept {
+        if (other.heap_) {
+            heap_ = std::move(other.heap_);
+            data_ = heap_.get();
+            capacity_ = other.capacity_;
+        } else {
+            data_ = inline_;
+            capacity_ = INLINE_CAPACITY;
+            std::memcpy(inline_, other.inline_, other.size_);
+        }
+        size_ = other.size_;
+        read_pos_ = other.read_pos_;
+
+        other.data_ = other.inline_;
+        other.capacity_ = INLINE_CAPACITY;
+        other.size_ = 0;
+        other.read_pos_ = 0;
+    }
+
+    uint8_t* data_ = inline_;
+    size_t size_ = 0;
+    size_t capacity_ = INLINE_CAPACITY;
     size_t read_pos_ = 0;
+    std::unique_ptr<uint8_t[]> heap_;
+    alignas(8) uint8_t inline_[INLINE_CAPACITY];
 };
@@ -0,0 +1,144 @@
+#include "ByteSwap.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PURITY_BSWAP_X86 1
+#endif
+
+namespace {
+    template<typename T>
+    T bswap(T v) {
+        if constexpr (sizeof(T) == 2) return __builtin_bswap16(v);
+        else if constexpr (sizeof(T) == 4) return __builtin_bswap32(v);
+        else return __builtin_bswap64(v);
+    }
+
+    template<typename T>
+    void copy_swap_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            T v;
+            std::memcpy(&v, src + i * sizeof(T), sizeof(T));
+            v = bswap(v);
+            std::memcpy(dst + i * sizeof(T), &v, sizeof(T));
+        }
+    }
+
+#ifdef PURITY_BSWAP_X86
+    // Маска pshufb: байт i берётся из позиции (i / W) * W + (W - 1 - i % W)
+    template<size_t WIDTH>
+    constexpr uint8_t shuffle_byte(size_t i) {
+        return static_cast<uint8_t>((i / WIDTH) * WIDTH + (WIDTH - 1 - i % WIDTH));
+    }
+
+    template<size_t WIDTH>
+    struct alignas(32) ShuffleMask {
+        uint8_t bytes[32];
+        constexpr ShuffleMask() : bytes{} {
+            for (size_t i = 0; i < 32; ++i) bytes[i] = shuffle_byte<WIDTH>(i % 16);
+        }
+    };
+
+    template<size_t WIDTH>
+    constexpr ShuffleMask<WIDTH> MASK{};
+
+    template<typename T>
+    __attribute__((target("ssse3")))
+    void copy_swap_ssse3(uint8_t* dst, const uint8_t* src, size_t count) {
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(MASK<sizeof(T)>.bytes));
+        const size_t bytes = count * sizeof(T);
+        size_t i = 0;
+        for (; i + 64 <= bytes; i += 64) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(a, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 16), _mm_shuffle_epi8(b, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 32), _mm_shuffle_epi8(c, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 48), _mm_shuffle_epi8(d, mask));
+        }
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+        }
+        copy_swap_scalar<T>(dst + i, src + i, (bytes - i) / sizeof(T));
+    }
+
+    // vpshufb переставляет внутри 128-битных половин — элементы до 8 байт их не пересекают
+    template<typename T>
+    __attribute__((target("avx2")))
+    void copy_swap_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+        const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(MASK<sizeof(T)>.bytes));
+        const size_t bytes = count * sizeof(T);
+        size_t i = 0;
+        for (; i + 128 <= bytes; i += 128) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(a, mask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), _mm256_shuffle_epi8(b, mask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 64), _mm256_shuffle_epi8(c, mask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 96), _mm256_shuffle_epi8(d, mask));
+        }
+        for (; i + 32 <= bytes; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+        }
+        if (i + 16 <= bytes) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, _mm256_castsi256_si128(mask)));
+            i += 16;
+        }
+        // Хвост — обычный код: без vzeroupper грязные верхние половины ymm дают штраф перехода AVX/SSE
+        _mm256_zeroupper();
+        copy_swap_scalar<T>(dst + i, src + i, (bytes - i) / sizeof(T));
+    }
+#endif
+
+    template<typename T>
+    void copy_swap_impl(void* dst, const void* src, size_t count, ByteSwap::Backend backend) {
+        auto* out = static_cast<uint8_t*>(dst);
+        const auto* in = static_cast<const uint8_t*>(src);
+#ifdef PURITY_BSWAP_X86
+        switch (ByteSwap::resolve(backend)) {
+            case ByteSwap::Backend::AVX2: copy_swap_avx2<T>(out, in, count); return;
+            case ByteSwap::Backend::SSSE3: copy_swap_ssse3<T>(out, in, count); return;
+            default: break;
+        }
+#else
+        (void) backend;
+#endif
+        copy_swap_scalar<T>(out, in, count);
+    }
+}
+
+ByteSwap::Backend ByteSwap::resolve(Backend backend) {
+#ifdef PURITY_BSWAP_X86
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    switch (backend) {
+        case Backend::AUTO: return has_avx2 ? Backend::AVX2 : has_ssse3 ? Backend::SSSE3 : Backend::SCALAR;
+        case Backend::AVX2: return has_avx2 ? Backend::AVX2 : resolve(Backend::SSSE3);
+        case Backend::SSSE3: return has_ssse3 ? Backend::SSSE3 : Backend::SCALAR;
+        default: return Backend::SCALAR;
+    }
+#else
+    (void) backend;
+    return Backend::SCALAR;
+#endif
+}
+
+void ByteSwap::copy_swap16(void* dst, const void* src, size_t count, Backend backend) {
+    copy_swap_impl<uint16_t>(dst, src, count, backend);
+}
+
+void ByteSwap::copy_swap32(void* dst, const void* src, size_t count, Backend backend) {
+    copy_swap_impl<uint32_t>(dst, src, count, backend);
+}
+
+void ByteSwap::copy_swap64(void* dst, const void* src, size_t count, Backend backend) {
+    copy_swap_impl<uint64_t>(dst, src, count, backend);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Копирование массива с перестановкой байт в каждом элементе (16/32/64 бит) — для bulk-методов ByteBuffer.
+ * На x86-64 переставляет по 32 байта за раз (AVX2 vpshufb) или по 16 (SSSE3 pshufb),
+ * иначе — поэлементно через __builtin_bswap. dst и src не должны перекрываться, выравнивание не требуется.
+ */
+namespace ByteSwap {
+
+    enum class Backend {
+        AUTO,     // лучший из доступных на этом CPU
+        SCALAR,
+        SSSE3,
+        AVX2
+    };
+
+    Backend resolve(Backend backend);
+
+    // count элементов по 2/4/8 байт
+    void copy_swap16(void* dst, const void* src, size_t count, Backend backend = Backend::AUTO);
+    void copy_swap32(void* dst, const void* src, size_t count, Backend backend = Backend::AUTO);
+    void copy_swap64(void* dst, const void* src, size_t count, Backend backend = Backend::AUTO);
+
+    template<size_t WIDTH>
+    void copy_swap(void* dst, const void* src, size_t count, Backend backend = Backend::AUTO) {
+        static_assert(WIDTH == 2 || WIDTH == 4 || WIDTH == 8);
+        if constexpr (WIDTH == 2) copy_swap16(dst, src, count, backend);
+        else if constexpr (WIDTH == 4) copy_swap32(dst, src, count, backend);
+        else copy_swap64(dst, src, count, backend);
+    }
+
+} // namespace ByteSwap
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "Logger.hpp"
+#include "utils/HexUtils.hpp"
+
+/**
+ * "Бортовой самописец" сессии: последние FRAMES входящих и исходящих пакетов (сырые байты + время).
+ * Запись — один memcpy в слот, кадры длиннее FRAME_BYTES обрезаются.
+ * Слоты выделяются при первом кадре: сессия, не приславшая ни байта, памяти под самописец не держит.
+ * В hex форматируется только при dump(): когда сессия закрывается с ошибкой или по запросу администратора.
+ */
+template<size_t FRAMES = 16, size_t FRAME_BYTES = 256>
+class FlightRecorder {
+public:
+    static_assert(FRAMES > 0 && FRAME_BYTES > 0);
+
+    enum class Direction : uint8_t {
+        INBOUND,
+        OUTBOUND
+    };
+
+    struct Frame {
+        int64_t time_ns = 0;        // steady_clock
+        uint32_t length = 0;        // исходная длина пакета
+        uint16_t stored = 0;        // сколько байт сохранено (<= FRAME_BYTES)
+        Direction direction = Direction::INBOUND;
+        std::array<uint8_t, FRAME_BYTES> bytes;
+    };
+
+    void record(Direction direction, const uint8_t* data, size_t length) {
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto stored = static_cast<uint16_t>(std::min(length, FRAME_BYTES));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!frames_) frames_ = std::make_unique<std::array<Frame, FRAMES>>();
+        Frame& frame = (*frames_)[next_ % FRAMES];
+        frame.time_ns = now;
+        frame.length = static_cast<uint32_t>(length);
+        frame.stored = stored;
+        frame.direction = direction;
+        std::memcpy(frame.bytes.data(), data, stored);
+        ++next_;
+    }
+
+    void record_inbound(const uint8_t* data, size_t length) { record(Direction::INBOUND, data, length); }
+    void record_outbound(const uint8_t* data, size_t length) { record(Direction::OUTBOUND, data, length); }
+
+    size_t memory_footprint() const { return frames_ ? sizeof(*frames_) : 0; }
+
+    // Сколько кадров записано за всё время
+    uint64_t recorded() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return next_;
+    }
+
+    /** Обходит сохранённые кадры от старого к новому. */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t first = next_ > FRAMES ? next_ - FRAMES : 0;
+        for (uint64_t i = first; i < next_; ++i) fn((*frames_)[i % FRAMES]);
+    }
+
+    /** Пишет кадры в лог (warn), по строке на кадр. */
+    void dump(std::string_view reason) const {
+        auto& log = Logger::get();
+        if (!log.should_log(spdlog::level::warn)) return;
+
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        log.warn("[FlightRecorder] {}: last {} of {} frames", reason, std::min<uint64_t>(recorded(), FRAMES), recorded());
+
+        std::string hex;
+        for_each([&](const Frame& frame) {
+            hex.resize(frame.stored * 2);
+            HexUtils::write_hex(hex.data(), frame.bytes.data(), frame.stored);
+            log.warn("[FlightRecorder] {} {:.3f} ms ago, {} bytes{}: {}",
+                     frame.direction == Direction::INBOUND ? "IN " : "OUT",
+                     static_cast<double>(now - frame.time_ns) / 1e6,
+                     frame.length,
+                     frame.stored < frame.length ? " (truncated)" : "",
+                     hex);
+        });
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unique_ptr<std::array<Frame, FRAMES>> frames_;
+    uint64_t next_ = 0;
+};
@@ -40,6 +40,7 @@ public:
 
     size_type get_active_size() const { return _wpos - _rpos; }
     size_type get_remaining_space() const { return _storage.size() - _wpos; }
+    size_type capacity() const { return _storage.capacity(); }
 
     void normalize() {
         if (_rpos) {
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <stdexcept>
 #include <iomanip>
 #include <sstream>
 #include "ByteBuffer.hpp"
+#include "PacketSchema.hpp"
 #include "Logger.hpp"
 
 class Packet {
@@ -18,10 +21,12 @@ public:
     virtual ~Packet() = default;
 
     ByteBuffer& raw() { return buffer_; }
-    const std::vector<uint8_t>& serialize() const { return buffer_.data(); }
+    std::span<const uint8_t> serialize() const { return buffer_.bytes(); }
 
-    virtual std::vector<uint8_t> build_packet() const = 0;
-    virtual void deserialize(const std::vector<uint8_t>& raw_data) = 0;
+    // Заголовок + payload; пакеты до ByteBuffer::INLINE_CAPACITY собираются без кучи
+    virtual ByteBuffer build_packet() const = 0;
+    // raw_data — кадр целиком; payload копируется в buffer_, сам кадр после вызова не нужен
+    virtual void deserialize(std::span<const uint8_t> raw_data) = 0;
 
     static void log_raw_payload(
             const std::string& opcode,
@@ -42,9 +47,17 @@ public:
 
         MDC mdc;
         mdc.put("opcode", opcode);
-        Logger::get()->debug_with_mdc(log_message, mdc);
+        Logger::get().debug_with_mdc(log_message, mdc);
     }
 
+    // ==================== SCHEMA ====================
+    // Сообщение со схемой (см. PacketSchema.hpp) целиком: точный reserve и проверка границ на цепочку полей
+    template<typename Msg>
+    void write(const Msg& msg) { PacketSchema::encode(msg, buffer_); }
+
+    template<typename Msg>
+    Msg read() { return PacketSchema::decode<Msg>(buffer_); }
+
     // ==================== WRITE METHODS ====================
     void write_uint8(uint8_t value) { buffer_.write_uint8(value); }
     void write_int8(int8_t value) { buffer_.write_int8(value); }
@@ -69,6 +82,16 @@ public:
     void write_float_le(float value) { buffer_.write_float_le(value); }
     void write_double_le(double value) { buffer_.write_double_le(value); }
 
+    // ---------- Arrays ----------
+    void write_array_u16_be(std::span<const uint16_t> values) { buffer_.write_array_u16_be(values); }
+    void write_array_u32_be(std::span<const uint32_t> values) { buffer_.write_array_u32_be(values); }
+    void write_array_u64_be(std::span<const uint64_t> values) { buffer_.write_array_u64_be(values); }
+    void write_array_f32_be(std::span<const float> values) { buffer_.write_array_f32_be(values); }
+    void write_array_u16_le(std::span<const uint16_t> values) { buffer_.write_array_u16_le(values); }
+    void write_array_u32_le(std::span<const uint32_t> values) { buffer_.write_array_u32_le(values); }
+    void write_array_u64_le(std::span<const uint64_t> values) { buffer_.write_array_u64_le(values); }
+    void write_array_f32_le(std::span<const float> values) { buffer_.write_array_f32_le(values); }
+
     // ---------- Boolean ----------
     void write_bool(bool value) { buffer_.write_bool(value); }
 
@@ -86,8 +109,11 @@ public:
 
     // ---------- Bytes ----------
     std::vector<uint8_t> read_bytes(size_t length) { return buffer_.read_bytes(length); }
+    // span/view без копирования: действительны, пока пакет не изменён
+    std::span<const uint8_t> read_span(size_t length) { return buffer_.read_span(length); }
+    void read_into(std::span<uint8_t> out) { buffer_.read_into(out); }
     void write_bytes(const uint8_t* data, size_t length) { buffer_.write_bytes(data, length); }
-    void write_bytes(const std::vector<uint8_t>& data) { buffer_.write_bytes(data); }
+    void write_bytes(std::span<const uint8_t> data) { buffer_.write_bytes(data); }
 
     // ==================== READ METHODS ====================
     uint8_t read_uint8() { return buffer_.read_uint8(); }
@@ -113,6 +139,16 @@ public:
     float read_float_le() { return buffer_.read_float_le(); }
     double read_double_le() { return buffer_.read_double_le(); }
 
+    // ---------- Arrays ----------
+    void read_array_u16_be(std::span<uint16_t> out) { buffer_.read_array_u16_be(out); }
+    void read_array_u32_be(std::span<uint32_t> out) { buffer_.read_array_u32_be(out); }
+    void read_array_u64_be(std::span<uint64_t> out) { buffer_.read_array_u64_be(out); }
+    void read_array_f32_be(std::span<float> out) { buffer_.read_array_f32_be(out); }
+    void read_array_u16_le(std::span<uint16_t> out) { buffer_.read_array_u16_le(out); }
+    void read_array_u32_le(std::span<uint32_t> out) { buffer_.read_array_u32_le(out); }
+    void read_array_u64_le(std::span<uint64_t> out) { buffer_.read_array_u64_le(out); }
+    void read_array_f32_le(std::span<float> out) { buffer_.read_array_f32_le(out); }
+
     // ---------- Boolean ----------
     bool read_bool() { return buffer_.read_bool(); }
 
@@ -120,11 +156,13 @@ public:
 
     // BE raw string (без нуль-терминатора)
     std::string read_string_raw_be(size_t length) { return buffer_.read_string_raw_be(length); }
+    std::string_view read_string_view_raw(size_t length) { return buffer_.read_string_view_raw(length); }
     // LE raw string (реверс)
     std::string read_string_raw_le(size_t length) { return buffer_.read_string_raw_le(length); }
 
     // BE null-terminated string
     std::string read_string_nt_be() { return buffer_.read_string_nt_be(); }
+    std::string_view read_string_view_nt() { return buffer_.read_string_view_nt(); }
     // LE null-terminated string (реверс)
     std::string read_string_nt_le() { return buffer_.read_string_nt_le(); }
 
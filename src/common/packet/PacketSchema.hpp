@@ -0,0 +1,243 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <endian.h>
+
+#include "ByteBuffer.hpp"
+
+/**
+ * Декларативная схема payload'а: сообщение — обычная структура, Schema перечисляет её поля и их кодеки.
+ *
+ *     struct PongMsg {
+ *         uint32_t ping = 0;
+ *         using Schema = PacketSchema::Fields<PacketSchema::Field<&PongMsg::ping, PacketSchema::u32le>>;
+ *     };
+ *
+ * encode() заранее считает точный размер (reserve один раз), decode() проверяет границы
+ * один раз на каждую цепочку полей фиксированного размера, а не на каждое поле.
+ * Кодек фиксированного размера: FIXED_SIZE, write(uint8_t*, value), read<T>(const uint8_t*).
+ * Кодек переменного размера: size(value), write(ByteBuffer&, value), read<T>(ByteBuffer&).
+ */
+namespace PacketSchema {
+
+    // ==================== CODECS ====================
+
+    enum class Endian : uint8_t {
+        BIG,
+        LITTLE
+    };
+
+    template<typename Wire, Endian E>
+    struct Int {
+        static_assert(std::is_unsigned_v<Wire>);
+        static constexpr size_t FIXED_SIZE = sizeof(Wire);
+
+        template<typename T>
+        static void write(uint8_t* out, T value) {
+            Wire wire = to_wire(static_cast<Wire>(value));
+            std::memcpy(out, &wire, sizeof(wire));
+        }
+
+        template<typename T>
+        static T read(const uint8_t* in) {
+            Wire wire;
+            std::memcpy(&wire, in, sizeof(wire));
+            return static_cast<T>(to_wire(wire));   // перестановка байт симметрична
+        }
+
+    private:
+        static Wire to_wire(Wire v) {
+            if constexpr (sizeof(Wire) == 1) return v;
+            else if constexpr (E == Endian::BIG) {
+                if constexpr (sizeof(Wire) == 2) return htobe16(v);
+                else if constexpr (sizeof(Wire) == 4) return htobe32(v);
+                else return htobe64(v);
+            } else {
+                if constexpr (sizeof(Wire) == 2) return htole16(v);
+                else if constexpr (sizeof(Wire) == 4) return htole32(v);
+                else return htole64(v);
+            }
+        }
+    };
+
+    using u8 = Int<uint8_t, Endian::BIG>;
+    using u16be = Int<uint16_t, Endian::BIG>;
+    using u32be = Int<uint32_t, Endian::BIG>;
+    using u64be = Int<uint64_t, Endian::BIG>;
+    using u16le = Int<uint16_t, Endian::LITTLE>;
+    using u32le = Int<uint32_t, Endian::LITTLE>;
+    using u64le = Int<uint64_t, Endian::LITTLE>;
+
+    // N байт как есть; поле — std::array<uint8_t, N>
+    template<size_t N>
+    struct Bytes {
+        static constexpr size_t FIXED_SIZE = N;
+
+        static void write(uint8_t* out, const std::array<uint8_t, N>& value) {
+            std::memcpy(out, value.data(), N);
+        }
+
+        template<typename T>
+        static T read(const uint8_t* in) {
+            T value;
+            std::memcpy(value.data(), in, N);
+            return value;
+        }
+    };
+
+    // Null-terminated строка; LE — в обратном порядке, как ByteBuffer::write_string_nt_le
+    template<Endian E>
+    struct CString {
+        static constexpr size_t MIN_SIZE = 1;
+
+        static size_t size(const std::string& value) { return value.size() + 1; }
+
+        static void write(ByteBuffer& out, const std::string& value) {
+            if constexpr (E == Endian::BIG) out.write_string_nt_be(value);
+            else out.write_string_nt_le(value);
+        }
+
+        template<typename T>
+        static T read(ByteBuffer& in) {
+            if constexpr (E == Endian::BIG) return in.read_string_nt_be();
+            else return in.read_string_nt_le();
+        }
+    };
+
+    using cstring_be = CString<Endian::BIG>;
+    using cstring_le = CString<Endian::LITTLE>;
+
+    template<typename Codec>
+    concept FixedCodec = requires { Codec::FIXED_SIZE; };
+
+    // ==================== SCHEMA ====================
+
+    template<typename T>
+    struct MemberTraits;
+
+    template<typename Class, typename Member>
+    struct MemberTraits<Member Class::*> {
+        using class_type = Class;
+        using member_type = Member;
+    };
+
+    template<auto MemberPtr, typename CodecT>
+    struct Field {
+        using Codec = CodecT;
+        using Value = typename MemberTraits<decltype(MemberPtr)>::member_type;
+        static constexpr auto member = MemberPtr;
+    };
+
+    template<typename Codec>
+    constexpr size_t fixed_size_of() {
+        if constexpr (FixedCodec<Codec>) return Codec::FIXED_SIZE;
+        else return 0;
+    }
+
+    // Наименьший размер на проводе: у CString — один терминатор
+    template<typename Codec>
+    constexpr size_t min_size_of() {
+        if constexpr (FixedCodec<Codec>) return Codec::FIXED_SIZE;
+        else if constexpr (requires { Codec::MIN_SIZE; }) return Codec::MIN_SIZE;
+        else return 0;
+    }
+
+    template<typename... FieldsT>
+    struct Fields {
+        static constexpr size_t COUNT = sizeof...(FieldsT);
+
+        template<size_t I>
+        using At = std::tuple_element_t<I, std::tuple<FieldsT...>>;
+
+        static constexpr std::array<bool, COUNT> IS_FIXED = {FixedCodec<typename FieldsT::Codec>...};
+        static constexpr std::array<size_t, COUNT> SIZES = {fixed_size_of<typename FieldsT::Codec>()...};
+
+        static constexpr bool FIXED = (FixedCodec<typename FieldsT::Codec> && ...);
+
+        // Сумма полей фиксированного размера (для FIXED-схемы — размер всего payload'а)
+        static constexpr size_t FIXED_SIZE = (fixed_size_of<typename FieldsT::Codec>() + ... + 0);
+
+        // Меньше этого payload точно не декодируется (проверяется до разбора, см. OpcodeTable)
+        static constexpr size_t MIN_SIZE = (min_size_of<typename FieldsT::Codec>() + ... + 0);
+
+        // Длина цепочки фиксированных полей, начинающейся с поля i (0 — если i не её начало)
+        static constexpr size_t run_size(size_t i) {
+            if (!IS_FIXED[i] || (i > 0 && IS_FIXED[i - 1])) return 0;
+            size_t total = 0;
+            for (size_t j = i; j < COUNT && IS_FIXED[j]; ++j) total += SIZES[j];
+            return total;
+        }
+    };
+
+    template<typename Msg>
+    using SchemaOf = typename Msg::Schema;
+
+    // ==================== ENCODE / DECODE ====================
+
+    template<typename Msg>
+    size_t encoded_size(const Msg& msg) {
+        using S = SchemaOf<Msg>;
+        if constexpr (S::FIXED) {
+            return S::FIXED_SIZE;
+        } else {
+            size_t total = S::FIXED_SIZE;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ([&] {
+                    using F = typename S::template At<I>;
+                    if constexpr (!FixedCodec<typename F::Codec>) total += F::Codec::size(msg.*F::member);
+                }(), ...);
+            }(std::make_index_sequence<S::COUNT>{});
+            return total;
+        }
+    }
+
+    /** Дописывает сообщение в out: один reserve на точный размер, фиксированные поля — прямо в память буфера. */
+    template<typename Msg>
+    void encode(const Msg& msg, ByteBuffer& out) {
+        using S = SchemaOf<Msg>;
+        out.reserve(out.size() + encoded_size(msg));
+
+        uint8_t* run = nullptr;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using F = typename S::template At<I>;
+                if constexpr (FixedCodec<typename F::Codec>) {
+                    if constexpr (S::run_size(I) > 0) run = out.write_raw(S::run_size(I));
+                    F::Codec::write(run, msg.*F::member);
+                    run += F::Codec::FIXED_SIZE;
+                } else {
+                    F::Codec::write(out, msg.*F::member);
+                }
+            }(), ...);
+        }(std::make_index_sequence<S::COUNT>{});
+    }
+
+    /** Читает сообщение с текущей позиции in. Не хватает данных — std::out_of_range, как у ByteBuffer. */
+    template<typename Msg>
+    Msg decode(ByteBuffer& in) {
+        using S = SchemaOf<Msg>;
+        Msg msg{};
+
+        const uint8_t* run = nullptr;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using F = typename S::template At<I>;
+                if constexpr (FixedCodec<typename F::Codec>) {
+                    if constexpr (S::run_size(I) > 0) run = in.read_span(S::run_size(I)).data();
+                    msg.*F::member = F::Codec::template read<typename F::Value>(run);
+                    run += F::Codec::FIXED_SIZE;
+                } else {
+                    msg.*F::member = F::Codec::template read<typename F::Value>(in);
+                }
+            }(), ...);
+        }(std::make_index_sequence<S::COUNT>{});
+        return msg;
+    }
+}
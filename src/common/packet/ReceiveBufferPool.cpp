@@ -0,0 +1,37 @@
+#include "ReceiveBufferPool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+ReceiveBufferPool& ReceiveBufferPool::local() {
+    thread_local ReceiveBufferPool pool;
+    return pool;
+}
+
+ReceiveBufferPool::BufferPtr ReceiveBufferPool::acquire() {
+    if (free_.empty()) return std::make_unique<RingMessageBuffer>(BUFFER_SIZE, mapping_from_env());
+
+    BufferPtr buffer = std::move(free_.back());
+    free_.pop_back();
+    return buffer;
+}
+
+void ReceiveBufferPool::release(BufferPtr buffer) {
+    if (!buffer || free_.size() >= MAX_CACHED) return;
+    buffer->reset();
+    buffer->shrink_if_idle();
+    free_.push_back(std::move(buffer));
+}
+
+RingMessageBuffer::Mapping ReceiveBufferPool::mapping_from_env() {
+    static const RingMessageBuffer::Mapping mapping = [] {
+        const char* env = std::getenv("NET_MIRRORED_BUFFERS");
+        std::string val = env ? env : "";
+        std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+        return val == "true" || val == "1" || val == "yes"
+               ? RingMessageBuffer::Mapping::MIRRORED
+               : RingMessageBuffer::Mapping::PLAIN;
+    }();
+    return mapping;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "RingMessageBuffer.hpp"
+
+/**
+ * Пул приёмных буферов потока. Сессия без непрочитанных данных буфера не держит:
+ * берёт его из пула, когда сокет стал читаемым, и возвращает, как только разобрала всё до конца.
+ * Сессия может вернуть буфер в пул другого потока — пул только кэш, владельцем буфер не привязан.
+ */
+class ReceiveBufferPool {
+public:
+    static constexpr size_t BUFFER_SIZE = 4096;
+    static constexpr size_t MAX_CACHED = 64;        // свободных буферов на поток
+
+    using BufferPtr = std::unique_ptr<RingMessageBuffer>;
+
+    // Пул текущего потока
+    static ReceiveBufferPool& local();
+
+    BufferPtr acquire();
+
+    // Данные в буфере отбрасываются; выросший буфер ужимается до BUFFER_SIZE
+    void release(BufferPtr buffer);
+
+    size_t cached() const { return free_.size(); }
+
+    // NET_MIRRORED_BUFFERS=true — буферы через двойное отображение памяти (memfd + mmap)
+    static RingMessageBuffer::Mapping mapping_from_env();
+
+private:
+    std::vector<BufferPtr> free_;
+};
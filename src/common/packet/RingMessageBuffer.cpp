@@ -0,0 +1,137 @@
+#include "RingMessageBuffer.hpp"
+
+#include "Logger.hpp"
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    size_t round_up_pow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+#if defined(__linux__)
+    // Два соседних отображения одного memfd: data[i] и data[i + size] — один и тот же байт
+    uint8_t* map_mirrored(size_t size) {
+        int fd = memfd_create("purity_ring", MFD_CLOEXEC);
+        if (fd < 0) return nullptr;
+
+        uint8_t* result = nullptr;
+        if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+            void* area = mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (area != MAP_FAILED) {
+                auto* base = static_cast<uint8_t*>(area);
+                if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                    mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) {
+                    result = base;
+                } else {
+                    munmap(area, size * 2);
+                }
+            }
+        }
+        close(fd);
+        return result;
+    }
+
+    size_t page_size() {
+        static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+#endif
+}
+
+RingMessageBuffer::RingMessageBuffer(size_type initial_size, Mapping mapping)
+        : initial_size_(round_up_pow2(std::max<size_type>(initial_size, 16))), mapping_(mapping) {
+    allocate(initial_size_);
+    initial_size_ = capacity_;      // MIRRORED округляет до страницы
+}
+
+RingMessageBuffer::~RingMessageBuffer() {
+    release();
+}
+
+bool RingMessageBuffer::shrink_if_idle() {
+    if (get_active_size() != 0 || capacity_ <= initial_size_) return false;
+    reset();
+    release();
+    allocate(initial_size_);
+    std::vector<uint8_t>().swap(scratch_);
+    return true;
+}
+
+void RingMessageBuffer::grow(size_type min_capacity) {
+    uint8_t* old_data = data_;
+    size_type old_capacity = capacity_;
+    bool old_mirrored = mirrored_;
+    size_type old_pos = rpos_ & mask_;
+    size_type active = get_active_size();
+
+    allocate(round_up_pow2(std::max(min_capacity, initial_size_)));
+
+    // Непрочитанное переезжает в начало новой памяти: единственная копия — при росте
+    if (active > 0) {
+        size_type first = old_mirrored ? active : std::min(active, old_capacity - old_pos);
+        std::memcpy(data_, old_data + old_pos, first);
+        std::memcpy(data_ + first, old_data, active - first);
+    }
+    rpos_ = 0;
+    wpos_ = active;
+
+    free_storage(old_data, old_capacity, old_mirrored);
+}
+
+void RingMessageBuffer::allocate(size_type capacity) {
+    mirrored_ = false;
+#if defined(__linux__)
+    if (mapping_ == Mapping::MIRRORED) {
+        capacity = std::max(capacity, page_size());
+        if (uint8_t* mapped = map_mirrored(capacity)) {
+            data_ = mapped;
+            capacity_ = capacity;
+            mask_ = capacity - 1;
+            mirrored_ = true;
+            return;
+        }
+        static std::atomic<bool> warned{false};
+        if (!warned.exchange(true)) {
+            Logger::get().warn("[RingMessageBuffer] Mirrored mapping failed, falling back to plain buffers");
+        }
+    }
+#endif
+    data_ = new uint8_t[capacity];
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+}
+
+void RingMessageBuffer::release() {
+    free_storage(data_, capacity_, mirrored_);
+    data_ = nullptr;
+    capacity_ = 0;
+    mask_ = 0;
+    mirrored_ = false;
+}
+
+void RingMessageBuffer::free_storage(uint8_t* data, size_type capacity, bool mirrored) {
+    if (!data) return;
+#if defined(__linux__)
+    if (mirrored) {
+        munmap(data, capacity * 2);
+        return;
+    }
+#endif
+    delete[] data;
+}
+
+void RingMessageBuffer::copy_out(uint8_t* dst, size_type bytes) const {
+    if (bytes == 0) return;
+    size_type pos = rpos_ & mask_;
+    size_type first = mirrored_ ? bytes : std::min(bytes, capacity_ - pos);
+    std::memcpy(dst, data_ + pos, first);
+    std::memcpy(dst + first, data_, bytes - first);
+}
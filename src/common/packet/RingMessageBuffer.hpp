@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Приёмный буфер сессии — кольцо размером степень двойки, без memmove-компакции MessageBuffer.
+ * read_ptr()/write_ptr() и read_completed()/write_completed() работают как у MessageBuffer.
+ *
+ * Mapping::MIRRORED — "волшебное кольцо": те же физические страницы отображены дважды подряд (memfd + mmap),
+ * поэтому и непрочитанные данные, и свободное место всегда непрерывны. Если отобразить не удалось — PLAIN.
+ * Mapping::PLAIN — обычная память: кадр через границу кольца читается через peek() (копия во временный буфер).
+ *
+ * Буфер растёт до следующей степени двойки только когда свободного места не хватает,
+ * shrink_if_idle() возвращает память, когда непрочитанных данных нет.
+ */
+class RingMessageBuffer {
+public:
+    using size_type = std::size_t;
+
+    enum class Mapping : uint8_t {
+        PLAIN,
+        MIRRORED
+    };
+
+    explicit RingMessageBuffer(size_type initial_size = 4096, Mapping mapping = Mapping::PLAIN);
+    ~RingMessageBuffer();
+
+    RingMessageBuffer(const RingMessageBuffer&) = delete;
+    RingMessageBuffer& operator=(const RingMessageBuffer&) = delete;
+
+    void reset() {
+        rpos_ = 0;
+        wpos_ = 0;
+    }
+
+    // Как у MessageBuffer: данные отбрасываются, память остаётся до деструктора —
+    // на неё может указывать ещё не отменённый async_read_some
+    void clear() { reset(); }
+
+    uint8_t* read_ptr() { return data_ + (rpos_ & mask_); }
+    uint8_t* write_ptr() { return data_ + (wpos_ & mask_); }
+
+    void write_completed(size_type bytes) {
+        if (bytes > get_remaining_space())
+            throw std::runtime_error("RingMessageBuffer: write overflow");
+        wpos_ += bytes;
+    }
+
+    void read_completed(size_type bytes) {
+        if (bytes > get_active_size())
+            throw std::runtime_error("RingMessageBuffer: read overflow");
+        rpos_ += bytes;
+        if (rpos_ == wpos_) reset();    // пустое кольцо: следующая запись снова с начала, без копирования
+    }
+
+    size_type get_active_size() const { return wpos_ - rpos_; }
+    size_type get_free_space() const { return capacity_ - get_active_size(); }
+
+    // Непрерывно доступно для записи с write_ptr()
+    size_type get_remaining_space() const {
+        if (mirrored_) return get_free_space();
+        return std::min(get_free_space(), capacity_ - (wpos_ & mask_));
+    }
+
+    // Непрерывно доступно для чтения с read_ptr()
+    size_type get_contiguous_size() const {
+        if (mirrored_) return get_active_size();
+        return std::min(get_active_size(), capacity_ - (rpos_ & mask_));
+    }
+
+    /**
+     * Первые bytes непрочитанных байт одним куском (bytes <= get_active_size()).
+     * Указатель действителен до следующего изменения буфера.
+     */
+    const uint8_t* peek(size_type bytes) {
+        if (bytes > get_active_size())
+            throw std::runtime_error("RingMessageBuffer: peek overflow");
+        if (bytes <= get_contiguous_size()) return read_ptr();
+
+        // PLAIN: кадр пересекает границу кольца
+        if (scratch_.size() < bytes) scratch_.resize(bytes);
+        copy_out(scratch_.data(), bytes);
+        return scratch_.data();
+    }
+
+    // Гарантирует min_free свободных байт (вся свобода, не только непрерывный кусок)
+    void ensure_free_space(size_type min_free = 512) {
+        if (get_free_space() < min_free) grow(get_active_size() + min_free);
+    }
+
+    /** Возвращает память до начального размера, если непрочитанных данных нет. true — память освобождена. */
+    bool shrink_if_idle();
+
+    size_type capacity() const { return capacity_ + scratch_.capacity(); }
+    bool mirrored() const { return mirrored_; }
+
+private:
+    void grow(size_type min_capacity);
+    void allocate(size_type capacity);
+    void release();
+    static void free_storage(uint8_t* data, size_type capacity, bool mirrored);
+    void copy_out(uint8_t* dst, size_type bytes) const;
+
+    size_type initial_size_;
+    Mapping mapping_;
+
+    uint8_t* data_ = nullptr;
+    size_type capacity_ = 0;        // степень двойки (для MIRRORED — и кратна странице)
+    size_type mask_ = 0;
+    bool mirrored_ = false;
+
+    size_type rpos_ = 0;            // растут монотонно, сбрасываются когда кольцо опустело
+    size_type wpos_ = 0;
+
+    std::vector<uint8_t> scratch_;  // склейка кадров через границу (только PLAIN)
+};
@@ -1,141 +1,225 @@
 #include "SRP6.hpp"
-#include "utils/HexUtils.hpp"
+#include "utils/generators/SecureRandom.hpp"
 
-#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <cctype>
 #include <cstring>
+#include <stdexcept>
+
+namespace {
+    static const char* N_hex = "894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7"; // 256-bit WoW prime
+    constexpr BN_ULONG g_word = 7;
+
+    std::string upper_ascii(std::string_view str) {
+        std::string up(str);
+        for (char& c : up) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return up;
+    }
+
+    // RAII над BN_CTX_start/BN_CTX_end: временные BIGNUM берутся из пула контекста
+    class BnCtxFrame {
+    public:
+        explicit BnCtxFrame(BN_CTX* ctx) : ctx_(ctx) { BN_CTX_start(ctx_); }
+        ~BnCtxFrame() { BN_CTX_end(ctx_); }
+
+        BIGNUM* get() {
+            BIGNUM* bn = BN_CTX_get(ctx_);
+            if (!bn) throw std::runtime_error("SRP6: BN_CTX_get failed");
+            return bn;
+        }
+
+    private:
+        BN_CTX* ctx_;
+    };
+
+    // x = H(salt | H(UPPER(I) : P))
+    void compute_private_key(Sha1Hasher& hasher, std::string_view username, std::string_view password,
+                             std::span<const uint8_t> salt, uint8_t* x_hash) {
+        std::string up = upper_ascii(username);
+        const uint8_t colon = ':';
+
+        uint8_t inner_hash[SHA_DIGEST_LENGTH];
+        hasher.digest({{reinterpret_cast<const uint8_t*>(up.data()), up.size()},
+                       {&colon, 1},
+                       {reinterpret_cast<const uint8_t*>(password.data()), password.size()}}, inner_hash);
+        hasher.digest({salt, {inner_hash, SHA_DIGEST_LENGTH}}, x_hash);
+
+        OPENSSL_cleanse(inner_hash, sizeof(inner_hash));
+    }
+
+    // v = g^x mod N, 32 байта BE (иначе не пройдёт CHECK в таблице accounts)
+    void compute_verifier(const SRP6Group& group, BN_CTX* bn_ctx, Sha1Hasher& hasher,
+                          std::string_view username, std::string_view password,
+                          std::span<const uint8_t> salt, uint8_t* verifier) {
+        uint8_t x_hash[SHA_DIGEST_LENGTH];
+        compute_private_key(hasher, username, password, salt, x_hash);
+
+        BnCtxFrame frame(bn_ctx);
+        BIGNUM* x = frame.get();
+        BIGNUM* v = frame.get();
+        BN_bin2bn(x_hash, SHA_DIGEST_LENGTH, x);
+        BN_set_flags(x, BN_FLG_CONSTTIME);
+
+        BN_mod_exp_mont_consttime(v, group.g, x, group.N, bn_ctx, group.mont);
+        BN_bn2binpad(v, verifier, static_cast<int>(SRP6Group::KEY_SIZE));
+
+        OPENSSL_cleanse(x_hash, sizeof(x_hash));
+        BN_clear(x);
+    }
+}
+
+// ==================== SRP6Group ====================
+
+SRP6Group::SRP6Group() {
+    N = BN_new();
+    g = BN_new();
+    k = BN_new();
+    mont = BN_MONT_CTX_new();
+
+    BN_hex2bn(&N, N_hex);
+    BN_set_word(g, g_word);
+    BN_bn2binpad(N, N_bytes.data(), KEY_SIZE);
+    g_value = static_cast<uint8_t>(g_word);
+
+    BN_CTX* ctx = BN_CTX_new();
+    BN_MONT_CTX_set(mont, N, ctx);
+    BN_CTX_free(ctx);
+
+    Sha1Hasher hasher;
+
+    // k = H(N | g)
+    uint8_t hash[SHA_DIGEST_LENGTH];
+    hasher.digest({{N_bytes.data(), N_bytes.size()}, {&g_value, 1}}, hash);
+    BN_bin2bn(hash, SHA_DIGEST_LENGTH, k);
+
+    // H(N) xor H(g) — постоянная часть M1
+    uint8_t g_hash[SHA_DIGEST_LENGTH];
+    hasher.digest({{N_bytes.data(), N_bytes.size()}}, Ng_hash.data());
+    hasher.digest({{&g_value, 1}}, g_hash);
+    for (size_t i = 0; i < SHA_DIGEST_LENGTH; ++i) {
+        Ng_hash[i] ^= g_hash[i];
+    }
+}
+
+SRP6Group::~SRP6Group() {
+    BN_MONT_CTX_free(mont);
+    BN_free(N);
+    BN_free(g);
+    BN_free(k);
+}
 
-SRP6::SRP6() {
+const SRP6Group& SRP6Group::instance() {
+    static const SRP6Group group;
+    return group;
+}
+
+// ==================== SRP6 ====================
+
+SRP6::SRP6() : group_(SRP6Group::instance()) {
     bn_ctx_ = BN_CTX_new();
     v_ = BN_new();
     b_ = BN_new();
     B_ = BN_new();
-    N_ = BN_new();
-    g_ = BN_new();
-    k_ = BN_new();
     a_ = BN_new();
     A_ = BN_new();
 
-    init_constants();
+    if (!bn_ctx_ || !v_ || !b_ || !B_ || !a_ || !A_) {
+        throw std::runtime_error("SRP6: allocation failed");
+    }
+
+    BN_set_flags(b_, BN_FLG_CONSTTIME);
+    BN_set_flags(a_, BN_FLG_CONSTTIME);
 }
 
 SRP6::~SRP6() {
     BN_free(v_);
-    BN_free(b_);
+    BN_clear_free(b_);
     BN_free(B_);
-    BN_free(N_);
-    BN_free(g_);
-    BN_free(k_);
-    BN_free(a_);
+    BN_clear_free(a_);
     BN_free(A_);
     BN_CTX_free(bn_ctx_);
-}
-
-void SRP6::init_constants() {
-    static const char* N_hex = "B79B3E2A878DBEDF5AD53B139A99D8CEC8DA65FED1BD845FB70F6051754B8D36"; // 256-bit WoW
-    BN_hex2bn(&N_, N_hex);
-    BN_set_word(g_, 7);
-    k_ = calculate_k();
-}
-
-BIGNUM* SRP6::calculate_k() const {
-    std::vector<uint8_t> N_bin(BN_num_bytes(N_));
-    std::vector<uint8_t> g_bin(BN_num_bytes(g_));
-
-    BN_bn2bin(N_, N_bin.data());
-    BN_bn2bin(g_, g_bin.data());
-
-    std::vector<uint8_t> to_hash;
-    to_hash.insert(to_hash.end(), N_bin.begin(), N_bin.end());
-    to_hash.insert(to_hash.end(), g_bin.begin(), g_bin.end());
-
-    uint8_t hash[SHA_DIGEST_LENGTH];
-    SHA1(to_hash.data(), to_hash.size(), hash);
-
-    BIGNUM* result = BN_new();
-    BN_bin2bn(hash, SHA_DIGEST_LENGTH, result);
-    return result;
+    OPENSSL_cleanse(K_.data(), K_.size());
 }
 
 //auto [salt, verifier] = srp.generate_salt_and_verifier_trinity("bob", "hunter2");
 std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
 SRP6::generate_salt_and_verifier_trinity(const std::string& username, const std::string& password) {
-    // 1) Генерируем 32-байтную соль
-    uint8_t salt_bytes[32];
-    RAND_bytes(salt_bytes, sizeof(salt_bytes));
-    std::vector<uint8_t> salt_vec(salt_bytes, salt_bytes + sizeof(salt_bytes));
+    std::vector<uint8_t> salt_vec(SRP6Group::KEY_SIZE);
+    std::vector<uint8_t> verifier_vec(SRP6Group::KEY_SIZE);
 
-    // 2) Считаем inner hash = SHA1(uppercase(username) : ":" : password)
-    std::string up = username;
-    for (char& c : up) {
-        c = std::toupper(static_cast<unsigned char>(c));
-    }
-    up += ":";
-    up += password;
+    SecureRandom::fill(salt_vec.data(), salt_vec.size());
+    compute_verifier(group_, bn_ctx_, hasher_, username, password, salt_vec, verifier_vec.data());
 
-    uint8_t inner_hash[SHA_DIGEST_LENGTH];
-    SHA1(reinterpret_cast<const uint8_t*>(up.data()), up.size(), inner_hash);
+    return { salt_vec, verifier_vec };
+}
 
-    // 3) Считаем x = SHA1(salt | inner_hash)
-    std::vector<uint8_t> to_hash;
-    to_hash.insert(to_hash.end(), salt_vec.begin(), salt_vec.end());
-    to_hash.insert(to_hash.end(), inner_hash, inner_hash + SHA_DIGEST_LENGTH);
+// ==================== SRP6VerifierGenerator ====================
 
-    uint8_t x_hash[SHA_DIGEST_LENGTH];
-    SHA1(to_hash.data(), to_hash.size(), x_hash);
+SRP6VerifierGenerator::SRP6VerifierGenerator() : group_(SRP6Group::instance()), bn_ctx_(BN_CTX_new()) {
+    if (!bn_ctx_) throw std::runtime_error("SRP6: allocation failed");
+}
 
-    BIGNUM* x = BN_bin2bn(x_hash, SHA_DIGEST_LENGTH, nullptr);
+SRP6VerifierGenerator::~SRP6VerifierGenerator() {
+    BN_CTX_free(bn_ctx_);
+}
 
-    // 4) v = g^x mod N
-    BIGNUM* v = BN_new();
-    BN_mod_exp(v, g_, x, N_, bn_ctx_);
+void SRP6VerifierGenerator::generate(std::string_view username, std::string_view password,
+                                     uint8_t* salt, uint8_t* verifier) {
+    SecureRandom::fill(salt, SRP6Group::KEY_SIZE);
+    compute_verifier(group_, bn_ctx_, hasher_, username, password, {salt, SRP6Group::KEY_SIZE}, verifier);
+}
 
-    // 5) Вектор verifier
-    std::vector<uint8_t> verifier_vec(BN_num_bytes(v));
-    BN_bn2bin(v, verifier_vec.data());
 
-    BN_free(x);
-    BN_free(v);
+size_t SRP6::memory_footprint() const {
+    // Точные размеры внутренних структур OpenSSL недоступны, поэтому накладные расходы — оценка
+    constexpr size_t BIGNUM_OVERHEAD = 32;      // struct bignum_st + заголовок malloc
+    constexpr size_t BN_CTX_ESTIMATE = 1024;    // пул временных BIGNUM'ов после первого использования
+    constexpr size_t MD_CTX_ESTIMATE = 256;     // EVP_MD_CTX + состояние SHA1
 
-    return { salt_vec, verifier_vec };
+    size_t bytes = sizeof(SRP6) + salt_.capacity() + username_.capacity() + password_.capacity() + last_M1_.capacity();
+    for (const BIGNUM* bn : {v_, b_, B_, a_, A_}) {
+        bytes += BIGNUM_OVERHEAD + ((BN_num_bytes(bn) + sizeof(BN_ULONG) - 1) / sizeof(BN_ULONG)) * sizeof(BN_ULONG);
+    }
+    return bytes + BN_CTX_ESTIMATE + MD_CTX_ESTIMATE;
 }
 
-
 void SRP6::set_only_username(const std::string& username) {
     username_ = username;
 }
 
-void SRP6::load_verifier(const std::vector<uint8_t>& salt, const std::vector<uint8_t>& verifier) {
-    salt_ = salt;
-    BN_bin2bn(verifier.data(), verifier.size(), v_);
+void SRP6::load_verifier(std::span<const uint8_t> salt, std::span<const uint8_t> verifier) {
+    salt_.assign(salt.begin(), salt.end());
+    BN_bin2bn(verifier.data(), static_cast<int>(verifier.size()), v_);
 }
 
 void SRP6::generate_server_ephemeral() {
     uint8_t rand_bytes[32];
-    RAND_bytes(rand_bytes, sizeof(rand_bytes));
+    SecureRandom::fill(rand_bytes, sizeof(rand_bytes));
     BN_bin2bn(rand_bytes, sizeof(rand_bytes), b_);
+    OPENSSL_cleanse(rand_bytes, sizeof(rand_bytes));
 
-    BIGNUM* gb = BN_new();
-    BIGNUM* kv = BN_new();
-
-    BN_mod_exp(gb, g_, b_, N_, bn_ctx_);
-    BN_mod_mul(kv, k_, v_, N_, bn_ctx_);
+    BnCtxFrame frame(bn_ctx_);
+    BIGNUM* gb = frame.get();
+    BIGNUM* kv = frame.get();
 
-    BN_mod_add(B_, kv, gb, N_, bn_ctx_);
+    // B = (k*v + g^b) mod N
+    BN_mod_exp_mont_consttime(gb, group_.g, b_, group_.N, bn_ctx_, group_.mont);
+    BN_mod_mul(kv, group_.k, v_, group_.N, bn_ctx_);
+    BN_mod_add(B_, kv, gb, group_.N, bn_ctx_);
 
-    BN_free(gb);
-    BN_free(kv);
+    BN_bn2binpad(B_, B_bytes_.data(), static_cast<int>(B_bytes_.size()));
+    proof_pending_ = true;
 }
 
 std::vector<uint8_t> SRP6::get_B_bytes() const {
-    std::vector<uint8_t> raw(BN_num_bytes(B_));
-    BN_bn2bin(B_, raw.data());
-    return HexUtils::pad_bytes_left(raw, 32);
+    return { B_bytes_.begin(), B_bytes_.end() };
 }
 
 std::vector<uint8_t> SRP6::get_N_bytes() const {
-    std::vector<uint8_t> raw(BN_num_bytes(N_));
-    BN_bn2bin(N_, raw.data());
-    return HexUtils::pad_bytes_left(raw, 32);
+    return { group_.N_bytes.begin(), group_.N_bytes.end() };
 }
 
 std::vector<uint8_t> SRP6::get_salt_bytes() const {
@@ -143,19 +227,22 @@ std::vector<uint8_t> SRP6::get_salt_bytes() const {
 }
 
 uint8_t SRP6::get_generator() const {
-    return static_cast<uint8_t>(BN_get_word(g_));
+    return group_.g_value;
 }
 
 // --- Client side methods ---
 
-void SRP6::load_constants(const std::vector<uint8_t>& N_bytes, uint8_t g_value) {
-    BN_bin2bn(N_bytes.data(), N_bytes.size(), N_);
-    BN_set_word(g_, g_value);
-    k_ = calculate_k();
+void SRP6::load_constants(std::span<const uint8_t> N_bytes, uint8_t g_value) {
+    // Клиент работает только с общей группой: чужие N/g от сервера не принимаем
+    if (N_bytes.size() != group_.N_bytes.size() ||
+        !std::equal(N_bytes.begin(), N_bytes.end(), group_.N_bytes.begin()) ||
+        g_value != group_.g_value) {
+        throw std::runtime_error("SRP6: unsupported group parameters");
+    }
 }
 
-void SRP6::load_salt(const std::vector<uint8_t>& salt) {
-    salt_ = salt;
+void SRP6::load_salt(std::span<const uint8_t> salt) {
+    salt_.assign(salt.begin(), salt.end());
 }
 
 void SRP6::set_credentials(const std::string& username, const std::string& password) {
@@ -165,10 +252,12 @@ void SRP6::set_credentials(const std::string& username, const std::string& passw
 
 void SRP6::generate_client_ephemeral() {
     uint8_t rand_bytes[32];
-    RAND_bytes(rand_bytes, sizeof(rand_bytes));
+    SecureRandom::fill(rand_bytes, sizeof(rand_bytes));
     BN_bin2bn(rand_bytes, sizeof(rand_bytes), a_);
+    OPENSSL_cleanse(rand_bytes, sizeof(rand_bytes));
 
-    BN_mod_exp(A_, g_, a_, N_, bn_ctx_);
+    BN_mod_exp_mont_consttime(A_, group_.g, a_, group_.N, bn_ctx_, group_.mont);
+    BN_bn2binpad(A_, A_bytes_.data(), static_cast<int>(A_bytes_.size()));
 }
 
 const std::vector<uint8_t>& SRP6::get_last_M1() const {
@@ -176,52 +265,187 @@ const std::vector<uint8_t>& SRP6::get_last_M1() const {
 }
 
 std::vector<uint8_t> SRP6::get_A_bytes() const {
-    std::vector<uint8_t> raw(BN_num_bytes(A_));
-    BN_bn2bin(A_, raw.data());
-    return HexUtils::pad_bytes_left(raw, 32);
+    return { A_bytes_.begin(), A_bytes_.end() };
 }
 
-std::vector<uint8_t> SRP6::compute_M1(const std::vector<uint8_t>& B_bytes) {
-    // Very simplified M1 (not RFC 5054 strict)
-    std::vector<uint8_t> A = get_A_bytes();
+std::vector<uint8_t> SRP6::compute_M1(std::span<const uint8_t> B_bytes) {
+    if (B_bytes.size() != B_bytes_.size()) {
+        throw std::invalid_argument("SRP6: B must be 32 bytes");
+    }
+    std::memcpy(B_bytes_.data(), B_bytes.data(), B_bytes_.size());
+    BN_bin2bn(B_bytes_.data(), static_cast<int>(B_bytes_.size()), B_);
+
+    BnCtxFrame frame(bn_ctx_);
+    BIGNUM* tmp = frame.get();
+    BIGNUM* u = frame.get();
+    BIGNUM* x = frame.get();
+    BIGNUM* S = frame.get();
+    BIGNUM* exp = frame.get();
+
+    // B % N == 0 — сервер пытается навязать S = 0
+    BN_nnmod(tmp, B_, group_.N, bn_ctx_);
+    if (BN_is_zero(tmp)) {
+        throw std::runtime_error("SRP6: invalid server public key B");
+    }
+
+    if (!compute_u(u)) {
+        throw std::runtime_error("SRP6: scrambling parameter u is zero");
+    }
 
-    std::vector<uint8_t> to_hash;
-    to_hash.insert(to_hash.end(), A.begin(), A.end());
-    to_hash.insert(to_hash.end(), B_bytes.begin(), B_bytes.end());
-    to_hash.insert(to_hash.end(), salt_.begin(), salt_.end());
+    uint8_t x_hash[SHA_DIGEST_LENGTH];
+    compute_private_key(hasher_, username_, password_, salt_, x_hash);
+    BN_bin2bn(x_hash, SHA_DIGEST_LENGTH, x);
+    BN_set_flags(x, BN_FLG_CONSTTIME);
+    OPENSSL_cleanse(x_hash, sizeof(x_hash));
+
+    // S = (B - k * g^x) ^ (a + u * x) mod N
+    BN_mod_exp_mont_consttime(tmp, group_.g, x, group_.N, bn_ctx_, group_.mont);
+    BN_mod_mul(tmp, group_.k, tmp, group_.N, bn_ctx_);
+    BN_mod_sub(tmp, B_, tmp, group_.N, bn_ctx_);
+
+    BN_mul(exp, u, x, bn_ctx_);
+    BN_add(exp, exp, a_);
+    BN_set_flags(exp, BN_FLG_CONSTTIME);
+    BN_mod_exp_mont_consttime(S, tmp, exp, group_.N, bn_ctx_, group_.mont);
+
+    compute_session_key(S);
+
+    Digest M1;
+    compute_expected_M1(M1);
+    last_M1_.assign(M1.begin(), M1.end());
+
+    BN_clear(x);
+    BN_clear(exp);
+    BN_clear(S);
+    return last_M1_;
+}
 
-    uint8_t hash[SHA_DIGEST_LENGTH];
-    SHA1(to_hash.data(), to_hash.size(), hash);
+bool SRP6::verify_client_proof(std::span<const uint8_t> A_bytes, std::span<const uint8_t> M1_client,
+                               std::vector<uint8_t>& M2) {
+    std::array<uint8_t, SHA_DIGEST_LENGTH> proof;
+    if (!verify_client_proof(A_bytes, M1_client, proof)) return false;
+    M2.assign(proof.begin(), proof.end());
+    return true;
+}
 
-    std::vector<uint8_t> m1_raw;
-    m1_raw.assign(hash, hash + SHA_DIGEST_LENGTH);
+bool SRP6::verify_client_proof(std::span<const uint8_t> A_bytes, std::span<const uint8_t> M1_client,
+                               std::array<uint8_t, SHA_DIGEST_LENGTH>& M2) {
+    // Одна попытка на b: иначе по одному соединению можно перебирать пароли, не запрашивая новый challenge
+    if (!proof_pending_) {
+        return false;
+    }
+    proof_pending_ = false;
 
-    last_M1_ = HexUtils::pad_bytes_left(m1_raw, 20);
-    return last_M1_;
+    if (A_bytes.size() != A_bytes_.size() || M1_client.size() != SHA_DIGEST_LENGTH) {
+        return false;
+    }
+    std::memcpy(A_bytes_.data(), A_bytes.data(), A_bytes_.size());
+    BN_bin2bn(A_bytes_.data(), static_cast<int>(A_bytes_.size()), A_);
+
+    BnCtxFrame frame(bn_ctx_);
+    BIGNUM* tmp = frame.get();
+    BIGNUM* u = frame.get();
+    BIGNUM* S = frame.get();
+
+    // A % N == 0 — клиент пытается навязать S = 0
+    BN_nnmod(tmp, A_, group_.N, bn_ctx_);
+    if (BN_is_zero(tmp)) {
+        return false;
+    }
+
+    if (!compute_u(u)) {
+        return false;
+    }
+
+    // S = (A * v^u) ^ b mod N
+    BN_mod_exp_mont(tmp, v_, u, group_.N, bn_ctx_, group_.mont);
+    BN_mod_mul(tmp, A_, tmp, group_.N, bn_ctx_);
+    BN_mod_exp_mont_consttime(S, tmp, b_, group_.N, bn_ctx_, group_.mont);
+    BN_clear(b_);
+
+    compute_session_key(S);
+    BN_clear(S);
+
+    Digest expected;
+    compute_expected_M1(expected);
+    if (CRYPTO_memcmp(expected.data(), M1_client.data(), SHA_DIGEST_LENGTH) != 0) {
+        OPENSSL_cleanse(K_.data(), K_.size());
+        return false;
+    }
+
+    // M2 = H(A | M1 | K)
+    compute_M2(M1_client.data(), M2);
+    return true;
 }
 
-bool SRP6::verify_client_proof(const std::vector<uint8_t>& A_bytes, const std::vector<uint8_t>& M1_client, std::vector<uint8_t>& M2) {
-    std::vector<uint8_t> to_hash;
-    to_hash.insert(to_hash.end(), A_bytes.begin(), A_bytes.end());
-    to_hash.insert(to_hash.end(), M1_client.begin(), M1_client.end());
+bool SRP6::verify_server_proof(std::span<const uint8_t> last_M1, std::span<const uint8_t> M2_server) {
+    if (last_M1.size() != SHA_DIGEST_LENGTH || M2_server.size() != SHA_DIGEST_LENGTH) {
+        return false;
+    }
 
-    uint8_t hash[SHA_DIGEST_LENGTH];
-    SHA1(to_hash.data(), to_hash.size(), hash);
+    Digest expected;
+    compute_M2(last_M1.data(), expected);
+    return CRYPTO_memcmp(expected.data(), M2_server.data(), SHA_DIGEST_LENGTH) == 0;
+}
 
-    M2.assign(hash, hash + SHA_DIGEST_LENGTH);
+// ==================== Internal ====================
 
-    // На сервере обычно нужно сравнить с локальным вычисленным M1 — здесь для примера примем всё верным.
-    return true; // или сравнить с расчётом
+bool SRP6::compute_u(BIGNUM* u) {
+    // u = H(A | B)
+    uint8_t u_hash[SHA_DIGEST_LENGTH];
+    hasher_.digest({{A_bytes_.data(), A_bytes_.size()}, {B_bytes_.data(), B_bytes_.size()}}, u_hash);
+    BN_bin2bn(u_hash, SHA_DIGEST_LENGTH, u);
+    return !BN_is_zero(u);
 }
 
-bool SRP6::verify_server_proof(const std::vector<uint8_t>& last_M1, const std::vector<uint8_t>& M2_server) {
-    std::vector<uint8_t> to_hash;
-    std::vector<uint8_t> A = get_A_bytes();
-    to_hash.insert(to_hash.end(), A.begin(), A.end());
-    to_hash.insert(to_hash.end(), last_M1.begin(), last_M1.end());
+void SRP6::compute_session_key(const BIGNUM* S) {
+    // K = SHA_Interleave(S) (RFC 2945): ведущие нули отбрасываются, длина делается чётной
+    KeyBytes S_bytes;
+    BN_bn2binpad(S, S_bytes.data(), static_cast<int>(S_bytes.size()));
+
+    size_t offset = 0;
+    while (offset < S_bytes.size() && S_bytes[offset] == 0) ++offset;
+    if ((S_bytes.size() - offset) % 2 != 0) ++offset;
+
+    const size_t half = (S_bytes.size() - offset) / 2;
+    uint8_t even[SRP6Group::KEY_SIZE / 2];
+    uint8_t odd[SRP6Group::KEY_SIZE / 2];
+    for (size_t i = 0; i < half; ++i) {
+        even[i] = S_bytes[offset + 2 * i];
+        odd[i] = S_bytes[offset + 2 * i + 1];
+    }
 
-    uint8_t hash[SHA_DIGEST_LENGTH];
-    SHA1(to_hash.data(), to_hash.size(), hash);
+    // Два коротких сообщения: обычный SHA1 на переиспользуемом контексте, 8-полосной пачке тут нечего заполнять
+    Digest hashes[2];
+    hasher_.digest({{even, half}}, hashes[0].data());
+    hasher_.digest({{odd, half}}, hashes[1].data());
+
+    for (size_t i = 0; i < SHA_DIGEST_LENGTH; ++i) {
+        K_[2 * i] = hashes[0][i];
+        K_[2 * i + 1] = hashes[1][i];
+    }
+
+    OPENSSL_cleanse(S_bytes.data(), S_bytes.size());
+    OPENSSL_cleanse(even, sizeof(even));
+    OPENSSL_cleanse(odd, sizeof(odd));
+}
+
+void SRP6::compute_expected_M1(Digest& out) {
+    // M1 = H(H(N) xor H(g) | H(I) | s | A | B | K)
+    std::string up = upper_ascii(username_);
+    Digest user_hash;
+    hasher_.digest({{reinterpret_cast<const uint8_t*>(up.data()), up.size()}}, user_hash.data());
+
+    hasher_.digest({{group_.Ng_hash.data(), group_.Ng_hash.size()},
+                   {user_hash.data(), user_hash.size()},
+                   {salt_.data(), salt_.size()},
+                   {A_bytes_.data(), A_bytes_.size()},
+                   {B_bytes_.data(), B_bytes_.size()},
+                   {K_.data(), K_.size()}}, out.data());
+}
 
-    return std::equal(M2_server.begin(), M2_server.end(), hash);
+void SRP6::compute_M2(const uint8_t* M1, Digest& out) {
+    hasher_.digest({{A_bytes_.data(), A_bytes_.size()},
+                   {M1, SHA_DIGEST_LENGTH},
+                   {K_.data(), K_.size()}}, out.data());
 }
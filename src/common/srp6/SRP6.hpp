@@ -1,33 +1,67 @@
 #pragma once
 
+#include <array>
+#include <span>
 #include <vector>
 #include <cstdint>
 #include <openssl/bn.h>
 #include <openssl/sha.h>
 #include <string>
+#include <string_view>
+
+#include "Sha1Hasher.hpp"
+
+/**
+ * Общие константы группы SRP6 (N, g, k).
+ * Считаются один раз на процесс и только читаются из всех потоков.
+ */
+struct SRP6Group {
+    static constexpr size_t KEY_SIZE = 32;      // N, A, B, salt, verifier — 32 байта BE
+
+    BIGNUM* N = nullptr;
+    BIGNUM* g = nullptr;
+    BIGNUM* k = nullptr;
+    BN_MONT_CTX* mont = nullptr;                // Montgomery-контекст для N
+
+    std::array<uint8_t, KEY_SIZE> N_bytes{};
+    uint8_t g_value = 0;
+    std::array<uint8_t, SHA_DIGEST_LENGTH> Ng_hash{}; // H(N) xor H(g) для M1
+
+    static const SRP6Group& instance();
+
+private:
+    SRP6Group();
+    ~SRP6Group();
+};
 
 class SRP6 {
 public:
+    static constexpr size_t SESSION_KEY_SIZE = SHA_DIGEST_LENGTH * 2;
+
     SRP6();
     ~SRP6();
 
+    SRP6(const SRP6&) = delete;
+    SRP6& operator=(const SRP6&) = delete;
+
     std::pair<std::vector<uint8_t>, std::vector<uint8_t>> generate_salt_and_verifier_trinity(
             const std::string& username,
             const std::string& password
     );
 
     void set_only_username(const std::string& username);
-    void load_verifier(const std::vector<uint8_t>& salt, const std::vector<uint8_t>& verifier);
+    void load_verifier(std::span<const uint8_t> salt, std::span<const uint8_t> verifier);
     void generate_server_ephemeral();
 
     std::vector<uint8_t> get_B_bytes() const;
+    const std::array<uint8_t, SRP6Group::KEY_SIZE>& get_B_array() const { return B_bytes_; }
     std::vector<uint8_t> get_N_bytes() const;
     std::vector<uint8_t> get_salt_bytes() const;
     uint8_t get_generator() const;
 
     // --- Для клиента ---
-    void load_constants(const std::vector<uint8_t>& N, uint8_t g);
-    void load_salt(const std::vector<uint8_t>& salt);
+    void load_constants(std::span<const uint8_t> N, uint8_t g);
+    void load_salt(std::span<const uint8_t> salt);
     void set_credentials(const std::string& username, const std::string& password);
     void generate_client_ephemeral();
 
@@ -35,13 +69,32 @@ public:
 
     const std::vector<uint8_t>& get_last_M1() const;
     std::vector<uint8_t> get_A_bytes() const;
-    std::vector<uint8_t> compute_M1(const std::vector<uint8_t>& B_bytes);
-    bool verify_client_proof(const std::vector<uint8_t>& A_bytes, const std::vector<uint8_t>& M1_client, std::vector<uint8_t>& M2);
-    bool verify_server_proof(const std::vector<uint8_t>& last_M1, const std::vector<uint8_t>& M2_server);
+    const std::array<uint8_t, SRP6Group::KEY_SIZE>& get_A_array() const { return A_bytes_; }
+    std::vector<uint8_t> compute_M1(std::span<const uint8_t> B_bytes);
+
+    // A и M1 можно передавать прямо из пакета (Packet::read_span) — без копий в векторы.
+    // На один generate_server_ephemeral — одна проверка: после неё, удачной или нет, нужен новый B
+    bool verify_client_proof(std::span<const uint8_t> A_bytes, std::span<const uint8_t> M1_client,
+                             std::array<uint8_t, SHA_DIGEST_LENGTH>& M2);
+    bool verify_client_proof(std::span<const uint8_t> A_bytes, std::span<const uint8_t> M1_client, std::vector<uint8_t>& M2);
+    bool verify_server_proof(std::span<const uint8_t> last_M1, std::span<const uint8_t> M2_server);
+
+    /** Сессионный ключ K (interleaved SHA1 от S). Валиден после успешной проверки proof. */
+    const std::array<uint8_t, SESSION_KEY_SIZE>& get_session_key() const { return K_; }
+
+    /** Оценка занимаемой памяти в байтах (сам объект, буферы, BIGNUM'ы, BN_CTX и EVP-контекст). */
+    size_t memory_footprint() const;
 
 private:
-    void init_constants();
-    BIGNUM* calculate_k() const;
+    using Digest = Sha1Hasher::Digest;
+    using KeyBytes = std::array<uint8_t, SRP6Group::KEY_SIZE>;
+
+    void compute_session_key(const BIGNUM* S);
+    void compute_expected_M1(Digest& out);
+    void compute_M2(const uint8_t* M1, Digest& out);
+    bool compute_u(BIGNUM* u);
+
+    const SRP6Group& group_;
 
     std::vector<uint8_t> salt_;
     std::string username_;
@@ -50,13 +103,38 @@ private:
     BIGNUM* v_ = nullptr;
     BIGNUM* b_ = nullptr;
     BIGNUM* B_ = nullptr;
-    BIGNUM* N_ = nullptr;
-    BIGNUM* g_ = nullptr;
-    BIGNUM* k_ = nullptr;
     BIGNUM* a_ = nullptr;
     BIGNUM* A_ = nullptr;
 
     BN_CTX* bn_ctx_ = nullptr;
+    Sha1Hasher hasher_;
+
+    // Буферы, переиспользуемые между шагами протокола (BE, дополнены слева нулями)
+    KeyBytes A_bytes_{};
+    KeyBytes B_bytes_{};
+    std::array<uint8_t, SESSION_KEY_SIZE> K_{};
 
     std::vector<uint8_t> last_M1_;
+    bool proof_pending_ = false;    // b сгенерирован и ещё не использован в verify_client_proof
+};
+
+/**
+ * Массовая генерация пар (salt, verifier) без полноценного SRP6-объекта:
+ * BN_CTX и SHA1-контекст переиспользуются между вызовами. Один экземпляр на поток.
+ */
+class SRP6VerifierGenerator {
+public:
+    SRP6VerifierGenerator();
+    ~SRP6VerifierGenerator();
+
+    SRP6VerifierGenerator(const SRP6VerifierGenerator&) = delete;
+    SRP6VerifierGenerator& operator=(const SRP6VerifierGenerator&) = delete;
+
+    // salt и verifier — буферы по SRP6Group::KEY_SIZE байт
+    void generate(std::string_view username, std::string_view password, uint8_t* salt, uint8_t* verifier);
+
+private:
+    const SRP6Group& group_;
+    BN_CTX* bn_ctx_ = nullptr;
+    Sha1Hasher hasher_;
 };
@@ -0,0 +1,287 @@
+#include "Sha1Hasher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <openssl/crypto.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define PURITY_SHA1_X86 1
+#endif
+
+namespace {
+    const EVP_MD* sha1_md() {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        // Явный fetch один раз, иначе OpenSSL 3 ищет реализацию на каждом EVP_DigestInit_ex
+        static EVP_MD* md = EVP_MD_fetch(nullptr, "SHA1", nullptr);
+        return md;
+#else
+        return EVP_sha1();
+#endif
+    }
+}
+
+// ==================== Sha1Hasher ====================
+
+Sha1Hasher::Sha1Hasher() : ctx_(EVP_MD_CTX_new()) {
+    if (!ctx_) throw std::runtime_error("Sha1Hasher: EVP_MD_CTX_new failed");
+}
+
+Sha1Hasher::~Sha1Hasher() {
+    EVP_MD_CTX_free(ctx_);
+}
+
+void Sha1Hasher::init() {
+    EVP_DigestInit_ex(ctx_, sha1_md(), nullptr);
+}
+
+void Sha1Hasher::update(const uint8_t* data, size_t length) {
+    EVP_DigestUpdate(ctx_, data, length);
+}
+
+void Sha1Hasher::final(uint8_t* out) {
+    EVP_DigestFinal_ex(ctx_, out, nullptr);
+}
+
+void Sha1Hasher::digest(std::initializer_list<Part> parts, uint8_t* out) {
+    digest(std::span<const Part>(parts.begin(), parts.size()), out);
+}
+
+void Sha1Hasher::digest(std::span<const Part> parts, uint8_t* out) {
+    init();
+    for (const auto& part : parts) {
+        update(part);
+    }
+    final(out);
+}
+
+Sha1Hasher& Sha1Hasher::local() {
+    thread_local Sha1Hasher hasher;
+    return hasher;
+}
+
+// ==================== Sha1Batch ====================
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 64;
+
+    /**
+     * Выдаёт 64-байтные блоки сообщения из списка фрагментов вместе с паддингом SHA1:
+     * 0x80, нули и длина в битах (BE) в последних 8 байтах последнего блока.
+     */
+    class BlockFeeder {
+    public:
+        BlockFeeder() = default;
+
+        explicit BlockFeeder(std::span<const Sha1Hasher::Part> parts) : parts_(parts) {
+            for (const auto& part : parts_) length_ += part.size();
+            blocks_ = (length_ + 9 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        }
+
+        size_t blocks() const { return blocks_; }
+
+        void next(uint8_t* block) {
+            size_t filled = 0;
+            while (filled < BLOCK_SIZE && part_index_ < parts_.size()) {
+                const auto& part = parts_[part_index_];
+                size_t n = std::min(BLOCK_SIZE - filled, part.size() - part_offset_);
+                std::memcpy(block + filled, part.data() + part_offset_, n);
+                filled += n;
+                part_offset_ += n;
+                if (part_offset_ == part.size()) {
+                    ++part_index_;
+                    part_offset_ = 0;
+                }
+            }
+
+            if (filled < BLOCK_SIZE && !marker_written_) {
+                block[filled++] = 0x80;
+                marker_written_ = true;
+            }
+            std::memset(block + filled, 0, BLOCK_SIZE - filled);
+
+            if (++emitted_ == blocks_) {
+                uint64_t bits = static_cast<uint64_t>(length_) * 8;
+                for (int i = 0; i < 8; ++i) {
+                    block[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+                }
+            }
+        }
+
+    private:
+        std::span<const Sha1Hasher::Part> parts_;
+        size_t part_index_ = 0;
+        size_t part_offset_ = 0;
+        size_t length_ = 0;
+        size_t blocks_ = 0;
+        size_t emitted_ = 0;
+        bool marker_written_ = false;
+    };
+
+    void digest_scalar(std::span<const Sha1Batch::Message> messages, Sha1Hasher::Digest* out) {
+        Sha1Hasher& hasher = Sha1Hasher::local();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            hasher.digest(messages[i].parts, out[i].data());
+        }
+    }
+
+#ifdef PURITY_SHA1_X86
+    bool cpu_has_sha_ni() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+        return (ebx & (1u << 29)) != 0;
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i rotl(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+    }
+
+    // До 8 сообщений: дорожка i вектора хранит слово состояния сообщения i
+    __attribute__((target("avx2")))
+    void digest_avx2_group(std::span<const Sha1Batch::Message> messages, Sha1Hasher::Digest* out) {
+        const size_t lanes = messages.size();
+
+        alignas(32) uint8_t blocks[Sha1Batch::LANES][BLOCK_SIZE] = {};
+        alignas(32) uint32_t lane_blocks[Sha1Batch::LANES] = {};
+
+        BlockFeeder feeders[Sha1Batch::LANES];
+        size_t max_blocks = 0;
+        for (size_t i = 0; i < lanes; ++i) {
+            feeders[i] = BlockFeeder(messages[i].parts);
+            lane_blocks[i] = static_cast<uint32_t>(feeders[i].blocks());
+            max_blocks = std::max(max_blocks, feeders[i].blocks());
+        }
+
+        __m256i h0 = _mm256_set1_epi32(0x67452301);
+        __m256i h1 = _mm256_set1_epi32(static_cast<int>(0xEFCDAB89));
+        __m256i h2 = _mm256_set1_epi32(static_cast<int>(0x98BADCFE));
+        __m256i h3 = _mm256_set1_epi32(0x10325476);
+        __m256i h4 = _mm256_set1_epi32(static_cast<int>(0xC3D2E1F0));
+
+        const __m256i lane_block_count = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane_blocks));
+        const __m256i gather_index = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+        const __m256i bswap = _mm256_setr_epi8(
+                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+        for (size_t b = 0; b < max_blocks; ++b) {
+            for (size_t i = 0; i < lanes; ++i) {
+                if (b < feeders[i].blocks()) feeders[i].next(blocks[i]);
+            }
+
+            // Дорожки, у которых сообщение уже закончилось, сохраняют своё состояние
+            const __m256i active = _mm256_cmpgt_epi32(lane_block_count, _mm256_set1_epi32(static_cast<int>(b)));
+
+            __m256i w[16];
+            for (int t = 0; t < 16; ++t) {
+                __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(&blocks[0][t * 4]), gather_index, 4);
+                w[t] = _mm256_shuffle_epi8(v, bswap);
+            }
+
+            __m256i a = h0, bb = h1, c = h2, d = h3, e = h4;
+
+            for (int t = 0; t < 80; ++t) {
+                __m256i wt;
+                if (t < 16) {
+                    wt = w[t];
+                } else {
+                    wt = rotl(_mm256_xor_si256(_mm256_xor_si256(w[(t - 3) & 15], w[(t - 8) & 15]),
+                                               _mm256_xor_si256(w[(t - 14) & 15], w[t & 15])), 1);
+                    w[t & 15] = wt;
+                }
+
+                __m256i f, k;
+                if (t < 20) {
+                    f = _mm256_xor_si256(d, _mm256_and_si256(bb, _mm256_xor_si256(c, d)));
+                    k = _mm256_set1_epi32(0x5A827999);
+                } else if (t < 40) {
+                    f = _mm256_xor_si256(_mm256_xor_si256(bb, c), d);
+                    k = _mm256_set1_epi32(0x6ED9EBA1);
+                } else if (t < 60) {
+                    f = _mm256_or_si256(_mm256_and_si256(bb, c), _mm256_and_si256(d, _mm256_or_si256(bb, c)));
+                    k = _mm256_set1_epi32(static_cast<int>(0x8F1BBCDC));
+                } else {
+                    f = _mm256_xor_si256(_mm256_xor_si256(bb, c), d);
+                    k = _mm256_set1_epi32(static_cast<int>(0xCA62C1D6));
+                }
+
+                __m256i temp = _mm256_add_epi32(_mm256_add_epi32(rotl(a, 5), f),
+                                                _mm256_add_epi32(_mm256_add_epi32(e, k), wt));
+                e = d;
+                d = c;
+                c = rotl(bb, 30);
+                bb = a;
+                a = temp;
+            }
+
+            h0 = _mm256_blendv_epi8(h0, _mm256_add_epi32(h0, a), active);
+            h1 = _mm256_blendv_epi8(h1, _mm256_add_epi32(h1, bb), active);
+            h2 = _mm256_blendv_epi8(h2, _mm256_add_epi32(h2, c), active);
+            h3 = _mm256_blendv_epi8(h3, _mm256_add_epi32(h3, d), active);
+            h4 = _mm256_blendv_epi8(h4, _mm256_add_epi32(h4, e), active);
+        }
+
+        alignas(32) uint32_t state[5][Sha1Batch::LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state[0]), _mm256_shuffle_epi8(h0, bswap));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state[1]), _mm256_shuffle_epi8(h1, bswap));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state[2]), _mm256_shuffle_epi8(h2, bswap));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state[3]), _mm256_shuffle_epi8(h3, bswap));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state[4]), _mm256_shuffle_epi8(h4, bswap));
+
+        for (size_t i = 0; i < lanes; ++i) {
+            for (int word = 0; word < 5; ++word) {
+                std::memcpy(out[i].data() + word * 4, &state[word][i], 4);
+            }
+        }
+
+        // В блоках — куски сообщений (половины S при хэшировании ключа); затираем, как и скалярный путь
+        OPENSSL_cleanse(blocks, sizeof(blocks));
+    }
+
+    void digest_avx2(std::span<const Sha1Batch::Message> messages, Sha1Hasher::Digest* out) {
+        for (size_t offset = 0; offset < messages.size(); offset += Sha1Batch::LANES) {
+            size_t count = std::min(Sha1Batch::LANES, messages.size() - offset);
+            digest_avx2_group(messages.subspan(offset, count), out + offset);
+        }
+    }
+#endif
+}
+
+bool Sha1Batch::has_avx2() {
+#ifdef PURITY_SHA1_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+Sha1Batch::Backend Sha1Batch::resolve(Backend backend) {
+#ifdef PURITY_SHA1_X86
+    if (backend == Backend::AUTO) {
+        static const bool prefer_avx2 = has_avx2() && !cpu_has_sha_ni();
+        return prefer_avx2 ? Backend::AVX2 : Backend::SCALAR;
+    }
+    if (backend == Backend::AVX2 && !has_avx2()) return Backend::SCALAR;
+    return backend;
+#else
+    (void) backend;
+    return Backend::SCALAR;
+#endif
+}
+
+void Sha1Batch::digest(std::span<const Message> messages, Sha1Hasher::Digest* out, Backend backend) {
+#ifdef PURITY_SHA1_X86
+    if (resolve(backend) == Backend::AVX2) {
+        digest_avx2(messages, out);
+        return;
+    }
+#else
+    (void) backend;
+#endif
+    digest_scalar(messages, out);
+}
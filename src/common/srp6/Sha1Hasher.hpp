@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+/**
+ * SHA1 с переиспользуемым EVP-контекстом.
+ * Данные подаются списком фрагментов (scatter), без склейки в промежуточный буфер.
+ */
+class Sha1Hasher {
+public:
+    using Digest = std::array<uint8_t, SHA_DIGEST_LENGTH>;
+    using Part = std::span<const uint8_t>;
+
+    Sha1Hasher();
+    ~Sha1Hasher();
+
+    Sha1Hasher(const Sha1Hasher&) = delete;
+    Sha1Hasher& operator=(const Sha1Hasher&) = delete;
+
+    void init();
+    void update(const uint8_t* data, size_t length);
+    void update(Part part) { update(part.data(), part.size()); }
+    void final(uint8_t* out);
+
+    void digest(std::initializer_list<Part> parts, uint8_t* out);
+    void digest(std::span<const Part> parts, uint8_t* out);
+
+    Digest digest(std::initializer_list<Part> parts) {
+        Digest out;
+        digest(parts, out.data());
+        return out;
+    }
+
+    // Заранее созданный контекст текущего потока
+    static Sha1Hasher& local();
+
+private:
+    EVP_MD_CTX* ctx_ = nullptr;
+};
+
+/**
+ * Пакетное хеширование независимых сообщений.
+ * На x86-64 с AVX2 считает до 8 сообщений одновременно (по одному в каждой 32-битной дорожке),
+ * иначе — последовательно через Sha1Hasher.
+ */
+namespace Sha1Batch {
+
+    struct Message {
+        std::span<const Sha1Hasher::Part> parts;
+    };
+
+    enum class Backend {
+        AUTO,     // AVX2, если CPU умеет AVX2 и не умеет SHA-NI (с SHA-NI OpenSSL быстрее)
+        SCALAR,
+        AVX2
+    };
+
+    constexpr size_t LANES = 8;
+
+    bool has_avx2();
+    Backend resolve(Backend backend);
+
+    void digest(std::span<const Message> messages, Sha1Hasher::Digest* out, Backend backend = Backend::AUTO);
+
+} // namespace Sha1Batch
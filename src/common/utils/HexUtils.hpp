@@ -1,11 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <cctype>
-#include <sstream>    // для std::ostringstream
-#include <iomanip>    // для std::hex, setw, setfill
 #include <algorithm>  // для std::copy_backward
 
 namespace HexUtils {
@@ -31,13 +31,30 @@ namespace HexUtils {
         return bytes;
     }
 
-    inline std::string bytes_to_hex(const unsigned char* bytes, size_t len) {
-        std::ostringstream oss;
-        oss << std::hex << std::setfill('0');
+    // Таблица "байт -> две hex-цифры": один 16-битный поиск на байт вместо ostringstream
+    inline constexpr std::array<char, 512> HEX_PAIRS = [] {
+        constexpr char digits[] = "0123456789abcdef";
+        std::array<char, 512> table{};
+        for (size_t i = 0; i < 256; ++i) {
+            table[i * 2] = digits[i >> 4];
+            table[i * 2 + 1] = digits[i & 0x0F];
+        }
+        return table;
+    }();
+
+    // Пишет 2 * len символов в out (строчные hex-цифры)
+    inline void write_hex(char* out, const unsigned char* bytes, size_t len) {
         for (size_t i = 0; i < len; ++i) {
-            oss << std::setw(2) << static_cast<int>(bytes[i]);
+            const char* pair = &HEX_PAIRS[bytes[i] * 2];
+            out[i * 2] = pair[0];
+            out[i * 2 + 1] = pair[1];
         }
-        return oss.str();
+    }
+
+    inline std::string bytes_to_hex(const unsigned char* bytes, size_t len) {
+        std::string hex(len * 2, '\0');
+        write_hex(hex.data(), bytes, len);
+        return hex;
     }
 
     inline std::string bytes_to_hex(const std::vector<uint8_t>& bytes) {
@@ -0,0 +1,81 @@
+#include "SecureRandom.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    std::atomic<uint64_t> g_fork_generation{0};
+
+    void on_fork_child() {
+        g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Регистрируем обработчик fork один раз при загрузке модуля
+    const int g_atfork_registered = pthread_atfork(nullptr, nullptr, &on_fork_child);
+
+    struct RandomPool {
+        std::array<uint8_t, SecureRandom::BUFFER_SIZE> bytes{};
+        size_t pos = SecureRandom::BUFFER_SIZE;   // пустой до первого запроса
+        uint64_t generation = 0;
+
+        ~RandomPool() { discard(); }
+
+        void discard() {
+            OPENSSL_cleanse(bytes.data(), bytes.size());
+            pos = bytes.size();
+        }
+
+        void refill() {
+            if (RAND_bytes(bytes.data(), static_cast<int>(bytes.size())) != 1) {
+                discard();
+                throw std::runtime_error("SecureRandom: RAND_bytes failed");
+            }
+            pos = 0;
+        }
+    };
+
+    thread_local RandomPool t_pool;
+}
+
+void SecureRandom::fill(uint8_t* out, size_t length) {
+    (void) g_atfork_registered;
+    RandomPool& pool = t_pool;
+
+    uint64_t generation = g_fork_generation.load(std::memory_order_relaxed);
+    if (pool.generation != generation) {
+        pool.discard();
+        pool.generation = generation;
+    }
+
+    // Крупные запросы нет смысла гонять через буфер
+    if (length >= BUFFER_SIZE / 2) {
+        if (RAND_bytes(out, static_cast<int>(length)) != 1) {
+            throw std::runtime_error("SecureRandom: RAND_bytes failed");
+        }
+        return;
+    }
+
+    while (length > 0) {
+        if (pool.pos == pool.bytes.size()) {
+            pool.refill();
+        }
+
+        size_t n = std::min(length, pool.bytes.size() - pool.pos);
+        std::memcpy(out, pool.bytes.data() + pool.pos, n);
+        OPENSSL_cleanse(pool.bytes.data() + pool.pos, n);
+
+        pool.pos += n;
+        out += n;
+        length -= n;
+    }
+}
+
+uint64_t SecureRandom::fork_generation() {
+    return g_fork_generation.load(std::memory_order_relaxed);
+}
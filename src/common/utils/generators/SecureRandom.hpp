@@ -0,0 +1,25 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Потокобезопасный CSPRNG с thread-local буфером.
+ * Байты берутся из RAND_bytes блоками по BUFFER_SIZE и раздаются срезами,
+ * выданные байты сразу затираются. После fork() буфер отбрасывается,
+ * чтобы родитель и потомок не выдали одинаковые значения.
+ */
+class SecureRandom {
+public:
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    // Бросает std::runtime_error, если OpenSSL не смог выдать случайные байты
+    static void fill(uint8_t* out, size_t length);
+
+    template<size_t N>
+    static void fill(std::array<uint8_t, N>& out) { fill(out.data(), out.size()); }
+
+    // Счётчик fork() в процессе: меняется в дочернем процессе после каждого fork
+    static uint64_t fork_generation();
+};
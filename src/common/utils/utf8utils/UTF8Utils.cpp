@@ -1,13 +1,24 @@
 #include "UTF8Utils.hpp"
+#include "UTF8CaseTable.hpp"
 
-namespace UTF8Utils {
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 
-    // Проверка UTF-8 по базовым правилам
-    bool is_valid_utf8(const std::string &str) {
-        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(str.c_str());
-        size_t len = str.size();
-        size_t i = 0;
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PURITY_UTF8_X86 1
+#endif
+
+namespace {
+    constexpr uint64_t ONES = 0x0101010101010101ULL;
+    constexpr uint64_t HIGHS = 0x8080808080808080ULL;
 
+    // ==================== VALIDATION ====================
+
+    bool is_valid_scalar(const uint8_t* bytes, size_t len) {
+        size_t i = 0;
         while (i < len) {
             unsigned char c = bytes[i];
 
@@ -35,7 +46,7 @@ namespace UTF8Utils {
                 if ((bytes[i + 2] & 0xC0) != 0x80) return false;
                 if ((bytes[i + 3] & 0xC0) != 0x80) return false;
                 if (c == 0xF0 && bytes[i + 1] < 0x90) return false; // overlong
-                if (c > 0xF4) return false; // > U+10FFFF
+                if (c > 0xF4 || (c == 0xF4 && bytes[i + 1] >= 0x90)) return false; // > U+10FFFF
                 i += 4;
             } else {
                 return false;
@@ -44,54 +55,434 @@ namespace UTF8Utils {
         return true;
     }
 
-    // Простое lowercase для ASCII, остальные символы остаются без изменений
-    std::string to_lowercase(const std::string &str) {
-        std::string result;
-        result.reserve(str.size());
+    /*
+     * Хвост после последнего полного SIMD-блока — скалярно, начиная с символа, оборванного границей блока.
+     * Всё до этого символа блоки уже проверили; короткие строки целиком уходят сюда.
+     */
+    bool is_valid_tail(const uint8_t* data, size_t len, size_t processed) {
+        size_t start = processed;
+        for (size_t back = 1; back <= 3 && back <= processed; ++back) {
+            uint8_t c = data[processed - back];
+            if (c < 0x80) break;
+            if (c >= 0xC0) {
+                start = processed - back;
+                break;
+            }
+        }
+        return is_valid_scalar(data + start, len - start);
+    }
+
+#ifdef PURITY_UTF8_X86
+    /*
+     * Табличная проверка (Keiser, Lemire. "Validating UTF-8 In Less Than One Instruction Per Byte").
+     * Каждая пара соседних байт даёт три 16-элементных lookup'а: по старшему и младшему полубайту
+     * предыдущего байта и по старшему полубайту текущего. AND трёх масок ненулевой — пара невалидна.
+     * Третий и четвёртый байты длинных последовательностей проверяются отдельно, через prev2/prev3.
+     */
+    constexpr uint8_t TOO_SHORT = 1 << 0;         // 11______ 0_______ | 11______ 11______
+    constexpr uint8_t TOO_LONG = 1 << 1;          // 0_______ 10______
+    constexpr uint8_t OVERLONG_3 = 1 << 2;        // 11100000 100_____
+    constexpr uint8_t TOO_LARGE = 1 << 3;         // 11110100 1001____ и старше
+    constexpr uint8_t SURROGATE = 1 << 4;         // 11101101 101_____
+    constexpr uint8_t OVERLONG_2 = 1 << 5;        // 1100000_ 10______
+    constexpr uint8_t TOO_LARGE_1000 = 1 << 6;    // 11110101 1000____ и старше
+    constexpr uint8_t OVERLONG_4 = 1 << 6;        // 11110000 1000____
+    constexpr uint8_t TWO_CONTS = 1 << 7;         // 10______ 10______
+    constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
 
-        for (size_t i = 0; i < str.size();) {
-            unsigned char c = str[i];
-            if (c <= 0x7F) {
-                // ASCII
-                result.push_back(std::tolower(c));
-                ++i;
+    alignas(16) constexpr uint8_t BYTE_1_HIGH[16] = {
+            // 0_______ — ASCII
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            // 10______ — продолжение
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            // 1100____, 1101____ — начало 2-байтовой
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            // 1110____ — 3-байтовой
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            // 1111____ — 4-байтовой
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+    };
+
+    alignas(16) constexpr uint8_t BYTE_1_LOW[16] = {
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,           // ____0000
+            CARRY | OVERLONG_2,                                     // ____0001
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,                                      // ____0100
+            CARRY | TOO_LARGE | TOO_LARGE_1000,                     // ____0101
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,                     // ____1___
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,         // ____1101
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000
+    };
+
+    alignas(16) constexpr uint8_t BYTE_2_HIGH[16] = {
+            // ________ 0_______
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            // ________ 1000____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            // ________ 1001____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            // ________ 101_____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            // ________ 11______
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+    };
+
+    // Блок обрывается посреди последовательности, если один из трёх последних байт — её начало
+    struct alignas(32) IncompleteMax {
+        uint8_t bytes[32];
+        constexpr IncompleteMax() : bytes{} {
+            for (auto& b : bytes) b = 0xFF;
+            bytes[29] = 0xF0 - 1;
+            bytes[30] = 0xE0 - 1;
+            bytes[31] = 0xC0 - 1;
+        }
+    };
+
+    constexpr IncompleteMax INCOMPLETE_MAX{};
+
+    __attribute__((target("ssse3")))
+    bool is_valid_ssse3(const uint8_t* data, size_t len) {
+        const __m128i byte_1_high = _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH));
+        const __m128i byte_1_low = _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW));
+        const __m128i byte_2_high = _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH));
+        const __m128i incomplete_max = _mm_load_si128(reinterpret_cast<const __m128i*>(INCOMPLETE_MAX.bytes + 16));
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+
+        __m128i error = _mm_setzero_si128();
+        __m128i prev_input = _mm_setzero_si128();
+        __m128i prev_incomplete = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+            if (_mm_movemask_epi8(input) == 0) {
+                error = _mm_or_si128(error, prev_incomplete);
             } else {
-                // UTF-8 multibyte - просто копируем, т.к. без внешних библиотек нет удобного lower
-                // Можно улучшить, если нужна поддержка Unicode case folding с ICU
-                size_t length = 1;
-                if ((c & 0xE0) == 0xC0) length = 2;
-                else if ((c & 0xF0) == 0xE0) length = 3;
-                else if ((c & 0xF8) == 0xF0) length = 4;
-
-                result.append(str.substr(i, length));
-                i += length;
+                __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+                __m128i special = _mm_and_si128(
+                        _mm_and_si128(
+                                _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)),
+                                _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, low_nibble))),
+                        _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)));
+
+                // Байт через один после 111_____ и через два после 1111____ обязан быть продолжением
+                __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+                __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+                __m128i must_be_cont = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+                                                   _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+                must_be_cont = _mm_and_si128(must_be_cont, _mm_set1_epi8(static_cast<char>(0x80)));
+
+                error = _mm_or_si128(error, _mm_xor_si128(must_be_cont, special));
+                prev_incomplete = _mm_subs_epu8(input, incomplete_max);
             }
+            prev_input = input;
         }
 
-        return result;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) return false;
+        return is_valid_tail(data, len, i);
     }
 
-    std::string to_uppercase(const std::string &str) {
-        std::string result;
-        result.reserve(str.size());
+    __attribute__((target("avx2")))
+    bool is_valid_avx2(const uint8_t* data, size_t len) {
+        const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH)));
+        const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW)));
+        const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH)));
+        const __m256i incomplete_max = _mm256_load_si256(reinterpret_cast<const __m256i*>(INCOMPLETE_MAX.bytes));
+        const __m256i low_nibble = _mm256_set1_epi8(0x0F);
 
-        for (size_t i = 0; i < str.size();) {
-            unsigned char c = str[i];
-            if (c <= 0x7F) {
-                result.push_back(std::toupper(c));
-                ++i;
+        __m256i error = _mm256_setzero_si256();
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_incomplete = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+            if (_mm256_movemask_epi8(input) == 0) {
+                error = _mm256_or_si256(error, prev_incomplete);
             } else {
-                size_t length = 1;
-                if ((c & 0xE0) == 0xC0) length = 2;
-                else if ((c & 0xF0) == 0xE0) length = 3;
-                else if ((c & 0xF8) == 0xF0) length = 4;
+                // vpalignr сдвигает внутри 128-битных половин: младшей нужен конец prev_input
+                __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+                __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+                __m256i special = _mm256_and_si256(
+                        _mm256_and_si256(
+                                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble))),
+                        _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+
+                __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+                __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+                __m256i must_be_cont = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                                                       _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+                must_be_cont = _mm256_and_si256(must_be_cont, _mm256_set1_epi8(static_cast<char>(0x80)));
+
+                error = _mm256_or_si256(error, _mm256_xor_si256(must_be_cont, special));
+                prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+            }
+            prev_input = input;
+        }
+
+        bool ok = _mm256_testz_si256(error, error);
+        // Хвост — обычный код; GCC не ставит vzeroupper перед хвостовым вызовом, а грязные ymm тормозят весь SSE после
+        _mm256_zeroupper();
+        return ok && is_valid_tail(data, len, i);
+    }
+#endif
+
+    // ==================== CASE ====================
+
+    // Переключает регистр ASCII-букв [FIRST, FIRST + 26); остальные байты, в том числе >= 0x80, не меняются
+    template<char FIRST>
+    void flip_ascii_case(char* data, size_t size) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        // v + (0x80 - FIRST) переводит [FIRST, FIRST + 26) в [-128, -102) — одно знаковое сравнение
+        const __m128i shift = _mm_set1_epi8(static_cast<char>(0x80 - FIRST));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i flip = _mm_set1_epi8(0x20);
+        for (; i + 16 <= size; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i letter = _mm_cmplt_epi8(_mm_add_epi8(v, shift), limit);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_xor_si128(v, _mm_and_si128(letter, flip)));
+        }
+#endif
+        // SWAR: старший бит байта (h + 0x80 - FIRST) ^ (h + 0x80 - FIRST - 26) — h внутри диапазона
+        for (; i + 8 <= size; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, data + i, 8);
+            uint64_t heptets = w & ~HIGHS;
+            uint64_t from_first = heptets + ONES * static_cast<uint8_t>(0x80 - FIRST);
+            uint64_t past_last = heptets + ONES * static_cast<uint8_t>(0x80 - FIRST - 26);
+            uint64_t letter = (from_first ^ past_last) & ~w & HIGHS;
+            w ^= letter >> 2;
+            std::memcpy(data + i, &w, 8);
+        }
+        for (; i < size; ++i) {
+            auto c = static_cast<unsigned char>(data[i]);
+            data[i] = static_cast<char>(c ^ ((static_cast<unsigned char>(c - FIRST) < 26) << 5));
+        }
+    }
+
+    // Длина ASCII-префикса [data + from, data + size)
+    size_t ascii_run_end(const char* data, size_t size, size_t from) {
+        size_t i = from;
+#if defined(__SSE2__)
+        for (; i + 16 <= size; i += 16) {
+            int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            if (mask) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+#endif
+        while (i < size && static_cast<unsigned char>(data[i]) < 0x80) ++i;
+        return i;
+    }
+
+    // Декодирует символ с позиции i; 0 — невалидная последовательность
+    size_t decode(const unsigned char* s, size_t size, size_t i, uint32_t& cp) {
+        unsigned char c = s[i];
+        size_t length;
+        uint32_t min;
+        if ((c & 0xE0) == 0xC0) { length = 2; cp = c & 0x1F; min = 0x80; }
+        else if ((c & 0xF0) == 0xE0) { length = 3; cp = c & 0x0F; min = 0x800; }
+        else if ((c & 0xF8) == 0xF0) { length = 4; cp = c & 0x07; min = 0x10000; }
+        else return 0;
+
+        if (i + length > size) return 0;
+        for (size_t k = 1; k < length; ++k) {
+            if ((s[i + k] & 0xC0) != 0x80) return 0;
+            cp = (cp << 6) | (s[i + k] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return 0;
+        return length;
+    }
+
+    size_t encoded_length(uint32_t cp) {
+        return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    }
+
+    // Пишет символ в out, возвращает число байт
+    size_t encode(uint32_t cp, char* out) {
+        if (cp < 0x80) {
+            out[0] = static_cast<char>(cp);
+            return 1;
+        }
+        if (cp < 0x800) {
+            out[0] = static_cast<char>(0xC0 | (cp >> 6));
+            out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        if (cp < 0x10000) {
+            out[0] = static_cast<char>(0xE0 | (cp >> 12));
+            out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
 
-                result.append(str.substr(i, length));
-                i += length;
+    /*
+     * Двухбайтовый UTF-8 (до U+07FF: латиница, греческий, кириллица, армянский) — прямой таблицей сдвигов,
+     * собранной из диапазонов при компиляции; остальное — двоичным поиском по диапазонам.
+     */
+    class CaseMap {
+    public:
+        template<size_t N>
+        constexpr explicit CaseMap(const UTF8CaseTable::CaseRange (&table)[N]) : ranges_(table), count_(N) {
+            for (const auto& range : table) {
+                for (uint32_t cp = range.first; cp <= range.last && cp < DIRECT_LIMIT; cp += range.stride) {
+                    direct_[cp] = range.delta > FAR && range.delta <= INT16_MAX ? static_cast<int16_t>(range.delta) : FAR;
+                }
             }
         }
 
+        uint32_t map(uint32_t cp) const {
+            if (cp < DIRECT_LIMIT && direct_[cp] != FAR) return static_cast<uint32_t>(static_cast<int32_t>(cp) + direct_[cp]);
+
+            const auto* end = ranges_ + count_;
+            const auto* it = std::upper_bound(ranges_, end, cp,
+                                              [](uint32_t value, const UTF8CaseTable::CaseRange& r) { return value < r.first; });
+            if (it == ranges_) return cp;
+            const auto& range = *std::prev(it);
+            if (cp > range.last || (cp - range.first) % range.stride != 0) return cp;
+            return static_cast<uint32_t>(static_cast<int32_t>(cp) + range.delta);
+        }
+
+    private:
+        static constexpr uint32_t DIRECT_LIMIT = 0x800;
+        static constexpr int16_t FAR = INT16_MIN;       // сдвиг не влез в int16 — искать в диапазонах
+
+        const UTF8CaseTable::CaseRange* ranges_;
+        size_t count_;
+        int16_t direct_[DIRECT_LIMIT]{};
+    };
+
+    constexpr CaseMap UPPER_MAP{UTF8CaseTable::TO_UPPER};
+    constexpr CaseMap LOWER_MAP{UTF8CaseTable::TO_LOWER};
+
+    // ASCII-участки копируются целиком и переключаются одним проходом в конце (ſ -> S тоже попадает под него)
+    template<char FIRST>
+    std::string map_case(std::string_view str, const CaseMap& case_map) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(str.data());
+        // Обычно длина в байтах не меняется: буфер размером со вход (короткое имя обходится без аллокации).
+        // Если символы удлиняются, то не больше чем в полтора раза (2 байта -> 3: ɐ -> Ɐ)
+        std::string result(str.size(), '\0');
+        size_t out = 0;
+        auto reserve_out = [&](size_t count) {
+            if (out + count > result.size()) result.resize(str.size() + str.size() / 2);
+        };
+
+        size_t i = 0;
+        while (i < str.size()) {
+            if (bytes[i] < 0x80) {
+                size_t run_end = ascii_run_end(str.data(), str.size(), i);
+                reserve_out(run_end - i);
+                std::memcpy(result.data() + out, str.data() + i, run_end - i);
+                out += run_end - i;
+                i = run_end;
+                if (i == str.size()) break;
+            }
+
+            // Двухбайтовые символы — без вызова decode()
+            uint32_t cp;
+            size_t length;
+            if (bytes[i] >= 0xC2 && bytes[i] < 0xE0 && i + 1 < str.size() && (bytes[i + 1] & 0xC0) == 0x80) {
+                cp = ((bytes[i] & 0x1Fu) << 6) | (bytes[i + 1] & 0x3Fu);
+                length = 2;
+            } else if ((length = decode(bytes, str.size(), i, cp)) == 0) {
+                reserve_out(1);
+                result[out++] = str[i++];
+                continue;
+            }
+
+            uint32_t mapped = case_map.map(cp);
+            reserve_out(encoded_length(mapped));
+            out += encode(mapped, result.data() + out);
+            i += length;
+        }
+        result.resize(out);
+
+        flip_ascii_case<FIRST>(result.data(), result.size());
         return result;
     }
+}
+
+namespace UTF8Utils {
+
+    Backend resolve(Backend backend) {
+#ifdef PURITY_UTF8_X86
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+        switch (backend) {
+            case Backend::AUTO: return has_avx2 ? Backend::AVX2 : has_ssse3 ? Backend::SSSE3 : Backend::SCALAR;
+            case Backend::AVX2: return has_avx2 ? Backend::AVX2 : resolve(Backend::SSSE3);
+            case Backend::SSSE3: return has_ssse3 ? Backend::SSSE3 : Backend::SCALAR;
+            default: return Backend::SCALAR;
+        }
+#else
+        (void) backend;
+        return Backend::SCALAR;
+#endif
+    }
+
+    bool is_valid_utf8(std::string_view str, Backend backend) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(str.data());
+#ifdef PURITY_UTF8_X86
+        switch (resolve(backend)) {
+            // Строка короче SIMD-блока (имя аккаунта) целиком ушла бы в скалярный хвост — берём блок поменьше
+            case Backend::AVX2:
+                if (str.size() >= 32) return is_valid_avx2(bytes, str.size());
+                [[fallthrough]];
+            case Backend::SSSE3:
+                if (str.size() >= 16) return is_valid_ssse3(bytes, str.size());
+                break;
+            default: break;
+        }
+#else
+        (void) backend;
+#endif
+        return is_valid_scalar(bytes, str.size());
+    }
+
+    void to_lowercase_inplace(std::string& str) {
+        flip_ascii_case<'A'>(str.data(), str.size());
+    }
+
+    void to_uppercase_inplace(std::string& str) {
+        flip_ascii_case<'a'>(str.data(), str.size());
+    }
+
+    std::string to_lowercase(std::string_view str) {
+        std::string result(str);
+        to_lowercase_inplace(result);
+        return result;
+    }
+
+    std::string to_uppercase(std::string_view str) {
+        std::string result(str);
+        to_uppercase_inplace(result);
+        return result;
+    }
+
+    std::string to_lowercase_unicode(std::string_view str) {
+        return map_case<'A'>(str, LOWER_MAP);
+    }
+
+    std::string to_uppercase_unicode(std::string_view str) {
+        return map_case<'a'>(str, UPPER_MAP);
+    }
 
 } // namespace UTF8Utils
@@ -1,18 +1,39 @@
 #pragma once
 
 #include <string>
-#include <stdexcept>
-#include <cctype>
+#include <string_view>
 
 namespace UTF8Utils {
 
-    // Проверка, что строка валидный UTF-8 (базовая реализация)
-    bool is_valid_utf8(const std::string& str);
+    enum class Backend {
+        AUTO,     // лучший из доступных на этом CPU
+        SCALAR,
+        SSSE3,
+        AVX2
+    };
 
-    // Преобразование строки UTF-8 в lowercase (работает корректно для ASCII)
-    std::string to_lowercase(const std::string& str);
+    Backend resolve(Backend backend);
 
-    // Преобразование строки UTF-8 в uppercase (работает корректно для ASCII)
-    std::string to_uppercase(const std::string &str);
+    /**
+     * Проверка, что строка валидный UTF-8: без overlong-форм, суррогатов и значений > U+10FFFF.
+     * SIMD-варианты проверяют по 16 (SSSE3) или 32 (AVX2) байта за раз табличным методом
+     * Keiser–Lemire; блоки из одного ASCII пропускаются одной проверкой старших бит.
+     */
+    bool is_valid_utf8(std::string_view str, Backend backend = Backend::AUTO);
+
+    // Регистр только для ASCII, остальные байты не трогаются; без ветвлений, по 16 байт (SSE2) или по 8 (SWAR)
+    void to_lowercase_inplace(std::string& str);
+    void to_uppercase_inplace(std::string& str);
+
+    std::string to_lowercase(std::string_view str);
+    std::string to_uppercase(std::string_view str);
+
+    /**
+     * Простое (1:1) отображение регистра Unicode по таблице UTF8CaseTable.hpp: кириллица, греческий, латиница
+     * с диакритикой и т.д. Длина в байтах может измениться (ſ -> S). Невалидные байты копируются как есть.
+     * Имена аккаунтов этим не нормализуются: SRP6 считает H(UPPER(I)) только по ASCII, как и клиент.
+     */
+    std::string to_lowercase_unicode(std::string_view str);
+    std::string to_uppercase_unicode(std::string_view str);
 
 } // namespace UTF8Utils
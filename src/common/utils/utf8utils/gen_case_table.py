@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Генерирует UTF8CaseTable.hpp: простые (1:1) отображения регистра Unicode вне ASCII.
+
+Источник — база unicodedata текущего Python. Соседние кодовые точки с одинаковым сдвигом
+сворачиваются в диапазоны с шагом 1 (А..Я) или 2 (Ā ā Ă ă ...).
+Отображения в несколько символов (ß -> SS и т.п.) в таблицу не попадают.
+
+    python3 gen_case_table.py > UTF8CaseTable.hpp
+"""
+import sys
+import unicodedata
+
+
+def mapping(convert):
+    result = {}
+    for cp in range(0x80, 0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+        mapped = convert(chr(cp))
+        if len(mapped) == 1 and ord(mapped) != cp:
+            result[cp] = ord(mapped) - cp
+    return result
+
+
+def ranges(deltas):
+    out = []    # [first, last, delta, stride]
+    for cp in sorted(deltas):
+        delta = deltas[cp]
+        if out:
+            first, last, prev_delta, stride = out[-1]
+            gap = cp - last
+            if prev_delta == delta and (gap == stride or (first == last and gap == 2 and cp - 1 not in deltas)):
+                out[-1] = [first, cp, delta, gap]
+                continue
+        out.append([cp, cp, delta, 1])
+    return out
+
+
+def emit(name, table):
+    print(f"    inline constexpr CaseRange {name}[] = {{")
+    for first, last, delta, stride in table:
+        print(f"        {{0x{first:05X}, 0x{last:05X}, {delta}, {stride}}},")
+    print("    };")
+
+
+def main():
+    upper = ranges(mapping(str.upper))
+    lower = ranges(mapping(str.lower))
+
+    print("#pragma once")
+    print()
+    print("#include <cstdint>")
+    print()
+    print(f"// Сгенерировано gen_case_table.py (Unicode {unicodedata.unidata_version}), вручную не править")
+    print("namespace UTF8CaseTable {")
+    print()
+    print("    // Кодовые точки first, first + stride, ... last отображаются в cp + delta")
+    print("    struct CaseRange {")
+    print("        uint32_t first;")
+    print("        uint32_t last;")
+    print("        int32_t delta;")
+    print("        uint32_t stride;")
+    print("    };")
+    print()
+    emit("TO_UPPER", upper)
+    print()
+    emit("TO_LOWER", lower)
+    print()
+    print("} // namespace UTF8CaseTable")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
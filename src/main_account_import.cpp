@@ -0,0 +1,59 @@
+#include "src/tools/AccountImport/AccountImporter.hpp"
+#include "Logger.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+    void print_usage() {
+        std::cerr << "Usage: account_import <accounts.csv> [--threads N] [--batch N]\n"
+                  << "CSV columns: username,password. DB settings are read from DB_URL, DB_PORT, DB_USER, DB_PASSWORD, DB_NAME.\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Logger::init_thread_pool();
+    auto &log = Logger::get();
+
+    if (argc < 2) {
+        print_usage();
+        return 1;
+    }
+
+    int rc = 0;
+    try {
+        AccountImportOptions options;
+        options.csv_path = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--threads" && i + 1 < argc) {
+                options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--batch" && i + 1 < argc) {
+                options.batch_size = std::stoul(argv[++i]);
+            } else {
+                print_usage();
+                Logger::shutdown();
+                return 1;
+            }
+        }
+
+        options.conninfo = fmt::format("host={} port={} user={} password={} dbname={}",
+                                       std::getenv("DB_URL") ?: "127.0.0.1",
+                                       std::getenv("DB_PORT") ?: "5432",
+                                       std::getenv("DB_USER") ?: "postgres",
+                                       std::getenv("DB_PASSWORD") ?: "postgres",
+                                       std::getenv("DB_NAME") ?: "postgres");
+
+        AccountImporter importer(std::move(options));
+        auto stats = importer.run();
+        log.info("[AccountImport] Done: {} rows in {:.2f}s ({:.0f} rows/s)",
+                  stats.rows, stats.seconds, stats.rows_per_second());
+    } catch (const std::exception& e) {
+        log.error("[AccountImport] Failed: {}", e.what());
+        rc = 1;
+    }
+
+    Logger::shutdown();
+    return rc;
+}
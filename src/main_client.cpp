@@ -24,7 +24,7 @@ int main() {
     timer1.expires_after(std::chrono::milliseconds(1000));
     timer1.async_wait([&client](const boost::system::error_code &ec) {
         if (!ec) {
-            Logger::get()->info("start auth account");
+            Logger::get().info("start auth account");
             client->handle_logon_challenge("1", "1");
         }
     });
@@ -32,7 +32,7 @@ int main() {
     // Настраиваем сигнал Ctrl+C
     boost::asio::signal_set signals(io, SIGINT, SIGTERM);
     signals.async_wait([&](const boost::system::error_code &, int) {
-        Logger::get()->info("[Main] Caught signal. Disconnecting ...");
+        Logger::get().info("[Main] Caught signal. Disconnecting ...");
         client->disconnect();
 
         // Останавливаем io_context после graceful shutdown
@@ -41,7 +41,7 @@ int main() {
 
     io.run();
 
-    Logger::get()->info("[Main] Exiting.");
-    spdlog::shutdown();
+    Logger::get().info("[Main] Exiting.");
+    Logger::shutdown();
     return 0;
 }
@@ -0,0 +1,71 @@
+#include "logging/BinaryLog.hpp"
+#include "logging/JsonFormatter.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Печатает бинарный лог (LOG_FORMAT=binary) в тех же JSON-строках, что пишет сервер
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: log_decoder <server.bin | ->\n";
+        return 1;
+    }
+
+    std::string path = argv[1];
+    std::FILE* file = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Cannot open " << path << "\n";
+        return 1;
+    }
+
+    int rc = 0;
+    try {
+        BinaryLog::FileReader reader(file);
+        BinaryLog::FileRecord record;
+        std::vector<std::string> formats;
+        JsonFormatter formatter;
+        spdlog::memory_buf_t text;
+        spdlog::memory_buf_t line;
+
+        while (reader.next(record)) {
+            auto kind = static_cast<LogRecordKind>(record.header.kind);
+            std::string_view payload = record.payload;
+
+            if (kind == LogRecordKind::FORMAT) {
+                uint32_t id = BinaryLog::payload_id(payload);
+                if (id >= formats.size()) formats.resize(id + 1);
+                formats[id] = payload.substr(sizeof(id));
+                continue;
+            }
+
+            if (kind == LogRecordKind::BINARY) {
+                uint32_t id = BinaryLog::payload_id(payload);
+                text.clear();
+                BinaryLog::format(text, id < formats.size() ? std::string_view(formats[id]) : std::string_view(), payload);
+                payload = std::string_view(text.data(), text.size());
+            }
+
+            std::string_view name = kind == LogRecordKind::JSON ? JsonFormatter::JSON_LOGGER_NAME : "async_logger";
+            spdlog::details::log_msg msg(
+                    spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+                            std::chrono::nanoseconds(record.header.time_ns))),
+                    spdlog::source_loc{},
+                    spdlog::string_view_t(name.data(), name.size()),
+                    static_cast<spdlog::level::level_enum>(record.header.level),
+                    spdlog::string_view_t(payload.data(), payload.size()));
+            msg.thread_id = record.header.thread_id;
+
+            line.clear();
+            formatter.format(msg, line);
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "log_decoder: " << e.what() << "\n";
+        rc = 1;
+    }
+
+    if (file != stdin) std::fclose(file);
+    return rc;
+}
@@ -1,14 +1,49 @@
 #include "server/Server.hpp"
 #include "Database.hpp"
 #include "Logger.hpp"
+#include "metrics/Metrics.hpp"
+#include "metrics/MetricsEndpoint.hpp"
 
 #include <boost/asio.hpp>
+#include <charconv>
 #include <iostream>
 #include <csignal>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace {
+    std::string env_or(const char *name, const char *fallback) {
+        const char *value = std::getenv(name);
+        return value ? value : fallback;
+    }
+
+    AccountDirectory::DuplicateLoginPolicy duplicate_login_policy() {
+        std::string value = env_or("DUPLICATE_LOGIN", "kick");
+        if (value == "reject") return AccountDirectory::DuplicateLoginPolicy::REJECT_NEW;
+        if (value != "kick") {
+            Logger::get().warn("[Server] Unknown DUPLICATE_LOGIN={}, expected kick or reject; using kick", value);
+        }
+        return AccountDirectory::DuplicateLoginPolicy::KICK_OLD;
+    }
+
+    // METRICS_PORT: 1..65535, по умолчанию 9464; 0 — метрики выключены, как и любое некорректное значение
+    std::optional<uint16_t> metrics_port_from_env() {
+        std::string value = env_or("METRICS_PORT", "9464");
+        unsigned port = 0;
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), port);
+        if (ec != std::errc() || end != value.data() + value.size() || port > 65535) {
+            Logger::get().error("[Metrics] Invalid METRICS_PORT={}, expected 0..65535; metrics disabled", value);
+            return std::nullopt;
+        }
+        if (port == 0) return std::nullopt;
+        return static_cast<uint16_t>(port);
+    }
+}
 
 int main() {
     Logger::init_thread_pool();  // Инициализировать thread pool до первого лога!
-    auto log = Logger::get();
+    auto &log = Logger::get();
 
     try {
         // Получить количество доступных ядер процессора
@@ -34,16 +69,46 @@ int main() {
                 2   // Для каждого потока должна быть своя сессия к бд
         );
 
-        auto server = std::make_shared<Server>(io_context, db, port);
+        // 🟢 Повторный вход в аккаунт: DUPLICATE_LOGIN=kick (по умолчанию) — выбить старую сессию, reject — отказать новой
+        auto server = std::make_shared<Server>(io_context, db, port, duplicate_login_policy());
         server->start_accept();
-        log->info("[Server] Running on port {}", port);
+        log.info("[Server] Running on port {}", port);
+
+        // 🟢 Метрики для Prometheus: только loopback, METRICS_PORT=0 — выключить
+        Metrics::Registry::instance().callback(
+                "purity_log_dropped_total", "Log records dropped on ring overflow", Metrics::Type::COUNTER,
+                [&log] { return static_cast<double>(log.dropped_messages()); });
+        std::shared_ptr<MetricsEndpoint> metrics;
+        if (auto metrics_port = metrics_port_from_env()) {
+            // Метрики не обязательны: занятый порт не должен мешать запуску сервера
+            try {
+                metrics = std::make_shared<MetricsEndpoint>(io_context, *metrics_port);
+                metrics->start();
+            } catch (const boost::system::system_error &e) {
+                log.error("[Metrics] Cannot listen on 127.0.0.1:{}: {}; running without metrics",
+                          *metrics_port, e.what());
+                metrics.reset();
+            }
+        }
 
         boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
         signals.async_wait([&](const boost::system::error_code &, int signal_number) {
-            log->info("[Server] Signal {} received, shutting down...", signal_number);
+            log.info("[Server] Signal {} received, shutting down...", signal_number);
+            if (metrics) metrics->stop();
             server->stop();
         });
 
+        // kill -USR1 <pid> — сбросить в лог последние пакеты всех сессий и счётчики опкодов
+        boost::asio::signal_set dump_signal(io_context, SIGUSR1);
+        std::function<void(const boost::system::error_code &, int)> on_dump =
+                [&](const boost::system::error_code &ec, int) {
+                    if (ec) return;
+                    server->dump_flight_recorders();
+                    server->log_opcode_stats();
+                    dump_signal.async_wait(on_dump);
+                };
+        dump_signal.async_wait(on_dump);
+
         std::vector<std::thread> threads;
         for (unsigned int i = 0; i < network_threads; ++i) {
             threads.emplace_back([&io_context]() {
@@ -53,11 +118,11 @@ int main() {
 
         for (auto &t : threads) t.join();
 
-        log->info("[Server] Gracefully shut down.");
+        log.info("[Server] Gracefully shut down.");
     } catch (const std::exception &e) {
-        log->error("[Server] Exception: {}", e.what());
+        log.error("[Server] Exception: {}", e.what());
     }
 
-    spdlog::shutdown();
+    Logger::shutdown();
     return 0;
 }
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <optional>
 
+#include "metrics/Metrics.hpp"
+
 class AccountCache : public std::enable_shared_from_this<AccountCache> {
 public:
     AccountCache(boost::asio::io_context& io_context,
@@ -37,13 +39,18 @@ public:
     std::optional<AccountCacheEntry> get(const std::string& username) {
         std::lock_guard lock(mutex_);
         auto it = cache_.find(username);
-        if (it == cache_.end()) return std::nullopt;
+        if (it == cache_.end()) {
+            misses_.add();
+            return std::nullopt;
+        }
 
         auto now = std::chrono::steady_clock::now();
         if (now - it->second.last_access > ttl_) {
             // Просрочено — не возвращаем (но не удаляем немедленно)
+            misses_.add();
             return std::nullopt;
         }
+        hits_.add();
 
         // Обновляем last_access: продлеваем TTL
         it->second.last_access = now;
@@ -82,6 +89,7 @@ private:
         for (auto it = cache_.begin(); it != cache_.end(); ) {
             if (now - it->second.last_access > ttl_) {
                 it = cache_.erase(it);
+                evictions_.add();
             } else {
                 ++it;
             }
@@ -96,4 +104,11 @@ private:
 
     const std::chrono::seconds ttl_;
     const std::chrono::seconds cleanup_interval_;
+
+    Metrics::Counter &hits_ = Metrics::Registry::instance().counter(
+            "purity_account_cache_hits_total", "AccountCache lookups served from memory");
+    Metrics::Counter &misses_ = Metrics::Registry::instance().counter(
+            "purity_account_cache_misses_total", "AccountCache lookups that went to the database (absent or expired)");
+    Metrics::Counter &evictions_ = Metrics::Registry::instance().counter(
+            "purity_account_cache_evictions_total", "Expired AccountCache entries removed by the cleanup timer");
 };
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Кто сейчас в игре: имя аккаунта → ID сессии в SessionRegistry.
+ * Шарды по хэшу имени, у каждого свой мьютекс: поиск и вход двух разных аккаунтов почти никогда не встречаются.
+ * Хранится ID, а не shared_ptr: запись не продлевает жизнь сессии, а ID ушедшей сессии
+ * SessionRegistry::find просто не находит.
+ */
+class AccountDirectory {
+public:
+    static constexpr uint32_t SHARDS = 32;
+
+    // Что делать, если аккаунт уже в игре
+    enum class DuplicateLoginPolicy : uint8_t {
+        KICK_OLD,       // новая сессия вытесняет старую
+        REJECT_NEW      // новой сессии отказ, старая остаётся
+    };
+
+    struct ClaimResult {
+        bool accepted = false;
+        uint64_t displaced = 0;     // KICK_OLD: ID вытесненной живой сессии, её нужно закрыть; иначе 0
+    };
+
+    explicit AccountDirectory(DuplicateLoginPolicy policy = DuplicateLoginPolicy::KICK_OLD) : policy_(policy) {}
+
+    DuplicateLoginPolicy policy() const { return policy_; }
+
+    /**
+     * Закрепляет аккаунт за сессией по политике дублей.
+     * is_alive(id) отличает запись живой сессии от оставшейся после неё: мёртвая запись просто заменяется.
+     */
+    ClaimResult claim(const std::string &username, uint64_t session_id,
+                      const std::function<bool(uint64_t)> &is_alive) {
+        Shard &shard = shard_of(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto [it, inserted] = shard.accounts.try_emplace(username, session_id);
+        if (inserted) {
+            online_.fetch_add(1, std::memory_order_relaxed);
+            return {true, 0};
+        }
+
+        uint64_t previous = it->second;
+        if (previous == session_id) return {true, 0};
+        bool previous_alive = is_alive(previous);
+        if (previous_alive && policy_ == DuplicateLoginPolicy::REJECT_NEW) return {false, 0};
+
+        it->second = session_id;
+        return {true, previous_alive ? previous : 0};
+    }
+
+    /** снимает запись, только если аккаунт всё ещё закреплён именно за этой сессией **/
+    bool release(const std::string &username, uint64_t session_id) {
+        Shard &shard = shard_of(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.accounts.find(username);
+        if (it == shard.accounts.end() || it->second != session_id) return false;
+        shard.accounts.erase(it);
+        online_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** ID сессии аккаунта или 0, если аккаунт не в игре **/
+    uint64_t find(const std::string &username) const {
+        const Shard &shard = shard_of(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.accounts.find(username);
+        return it == shard.accounts.end() ? 0 : it->second;
+    }
+
+    size_t size() const { return online_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, uint64_t> accounts;
+    };
+
+    Shard &shard_of(const std::string &username) {
+        return shards_[std::hash<std::string>{}(username) % SHARDS];
+    }
+
+    const Shard &shard_of(const std::string &username) const {
+        return shards_[std::hash<std::string>{}(username) % SHARDS];
+    }
+
+    DuplicateLoginPolicy policy_;
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<size_t> online_{0};
+};
@@ -1,107 +1,235 @@
 #include "ClientSession.hpp"
 #include "Logger.hpp"
-#include "src/server/SessionMode/authstage/reader/ReaderAuthSession.hpp"
-#include "src/server/SessionMode/workstage/reader/ReaderWorkSession.hpp"
+#include "metrics/Metrics.hpp"
+#include "src/server/SessionMode/Framer.hpp"
+#include "src/server/SessionMode/authstage/reader/AuthSessionTraits.hpp"
+#include "src/server/SessionMode/workstage/reader/WorkSessionTraits.hpp"
 #include <iostream>
 
 using boost::asio::ip::tcp;
 
+namespace {
+    auto &registry = Metrics::Registry::instance();
+
+    Metrics::Gauge &auth_sessions = registry.gauge("purity_sessions_active", "Open client sessions by mode", "mode=\"auth\"");
+    Metrics::Gauge &work_sessions = registry.gauge("purity_sessions_active", "Open client sessions by mode", "mode=\"work\"");
+    Metrics::Counter &bytes_received = registry.counter("purity_network_received_bytes_total", "Bytes read from client sockets");
+    Metrics::Counter &bytes_sent = registry.counter("purity_network_sent_bytes_total", "Bytes written to client sockets");
+    Metrics::Counter &packets_received = registry.counter("purity_packets_received_total", "Frames parsed from clients");
+    Metrics::Counter &packets_sent = registry.counter("purity_packets_sent_total", "Packets queued for clients");
+    Metrics::Gauge &write_queue_depth = registry.gauge("purity_write_queue_depth", "Packets waiting in write queues of all sessions");
+    Metrics::Gauge &session_memory = registry.gauge("purity_session_memory_bytes",
+                                                    "Estimated memory of open sessions, sampled on mode change");
+
+    Metrics::Gauge &sessions_in(SessionMode mode) {
+        return mode == SessionMode::WORK_SESSION ? work_sessions : auth_sessions;
+    }
+}
+
 ClientSession::ClientSession(tcp::socket socket, std::shared_ptr<Server> server)
-        : socket_(std::move(socket)), server_(std::move(server)), read_buffer_(4096) {}
+        : socket_(std::move(socket)), server_(std::move(server)) {}
+
+ClientSession::~ClientSession() = default;
 
 void ClientSession::start() {
-    auto ep = socket_.remote_endpoint();
-    Logger::get()->debug("[client_session][start] New connection from {}:{}",
-                         ep.address().to_string(), ep.port());
+    // start() отложен через post — Server::stop() мог успеть закрыть сессию
+    if (!isOpened()) return;
+
+    PURITY_LOG_DEBUG("[client_session][start] New connection from {}:{}",
+                     socket_.remote_endpoint().address().to_string(), socket_.remote_endpoint().port());
 
     set_session_mode(SessionMode::AUTH_SESSION);  // Начинаем с AUTH_SESSION
+    counted_ = true;
+    sessions_in(session_mode_).add();
+    update_memory_gauge();
+
+    // Чтение — неблокирующий read_some после async_wait (см. do_read)
+    boost::system::error_code ec;
+    socket_.non_blocking(true, ec);
+    if (ec) {
+        Logger::get().error("[client_session][start] Failed to set non-blocking mode: {}", ec.message());
+        close();
+        return;
+    }
     do_read();
 }
 
 void ClientSession::close() {
     if (closed_.exchange(true)) return;
+    if (counted_) sessions_in(session_mode_).sub();
+    session_memory.sub(static_cast<int64_t>(accounted_memory_.exchange(0)));
 
-    if (get_session_mode() == SessionMode::WORK_SESSION)
-        getAccountInfo()->handle_close_state();
+    if (accountInfo_)
+        accountInfo_->handle_close_state(*this);
 
-    auto log = Logger::get();
+    auto &log = Logger::get();
 
     boost::system::error_code ec;
     socket_.cancel(ec);
     if (ec && ec != boost::asio::error::operation_aborted && ec != boost::asio::error::eof) {
-        log->error("[client_session][close] Failed to cancel socket: {}", ec.message());
+        log.error("[client_session][close] Failed to cancel socket: {}", ec.message());
     }
 
     socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
     if (ec && ec != boost::asio::error::operation_aborted &&
         ec != boost::asio::error::eof &&
         ec != boost::asio::error::not_connected) {
-        log->error("[client_session][close] Failed to shutdown socket: {}", ec.message());
+        log.error("[client_session][close] Failed to shutdown socket: {}", ec.message());
     }
     socket_.close(ec);
     if (ec && ec != boost::asio::error::operation_aborted && ec != boost::asio::error::eof) {
-        log->error("[client_session][close] Failed to close socket: {}", ec.message());
+        log.error("[client_session][close] Failed to close socket: {}", ec.message());
     }
 
-    read_buffer_.clear();
+    // read_buffer_ не трогаем: его может разбирать обработчик чтения в другом потоке, вернёт он же
+    write_queue_depth.sub(static_cast<int64_t>(write_queue_.size()));
     write_queue_.clear();
 
-    log->debug("[client_session][close] Socket closed. closed_={}", closed_.load());
+    PURITY_LOG_DEBUG("[client_session][close] Socket closed. closed_={}", closed_.load());
 
     if (server_) {
-        server_->remove_session(shared_from_this());
+        server_->remove_session(*this);
+    }
+}
+
+void ClientSession::close_with_error(std::string_view reason) {
+    if (closed_) return;
+    flight_recorder_.dump(reason);
+    close();
+}
+
+void ClientSession::set_session_mode(SessionMode mode) {
+    if (counted_ && !closed_ && mode != session_mode_) {
+        sessions_in(session_mode_).sub();
+        sessions_in(mode).add();
     }
+    session_mode_ = mode;
+    if (counted_) update_memory_gauge();
+}
+
+void ClientSession::update_memory_gauge() {
+    // Обходит write_queue_ и read_buffer_: вне strand'а гонка с do_send_packet и завершением async_write
+    if (closed_) return;
+    auto bytes = memory_footprint();
+    session_memory.add(static_cast<int64_t>(bytes) - static_cast<int64_t>(accounted_memory_.exchange(bytes)));
+
+    // close() мог забрать прежнее значение между проверкой и exchange — тогда новое снимаем сами
+    if (closed_) session_memory.sub(static_cast<int64_t>(accounted_memory_.exchange(0)));
+}
+
+AccountInfo &ClientSession::acquireAccountInfo() {
+    if (!accountInfo_) accountInfo_ = std::make_unique<AccountInfo>();
+    return *accountInfo_;
 }
 
+size_t ClientSession::memory_footprint() const {
+    size_t bytes = sizeof(ClientSession) + flight_recorder_.memory_footprint();
+    if (read_buffer_) bytes += sizeof(RingMessageBuffer) + read_buffer_->capacity();
+    for (const auto &chunk : write_queue_) bytes += sizeof(ByteBuffer) + (chunk.on_heap() ? chunk.capacity() : 0);
+    if (accountInfo_) bytes += accountInfo_->memory_footprint();
+    return bytes;
+}
+
+/**
+ * Ожидание данных без буфера: async_wait(wait_read) не требует памяти под приём,
+ * буфер берётся из пула потока только когда сокет стал читаемым
+ */
 void ClientSession::do_read() {
     auto self = shared_from_this();
 
-    read_buffer_.ensure_free_space(512);
-
-    socket_.async_read_some(
-            boost::asio::buffer(read_buffer_.write_ptr(), read_buffer_.get_remaining_space()),
-            [this, self](boost::system::error_code ec, std::size_t bytes_transferred) {
-                auto log = Logger::get();
+    socket_.async_wait(
+            tcp::socket::wait_read,
+            [this, self](boost::system::error_code ec) {
                 if (ec) {
-                    if (ec == boost::asio::error::operation_aborted ||
-                        ec == boost::asio::error::eof ||
-                        ec == boost::asio::error::connection_reset) {
-                        log->debug("[client_session][do_read] Client disconnected: {}", ec.message());
-                    } else {
-                        log->error("[client_session][do_read] Read error: {}", ec.message());
-                    }
-                    close();
+                    handle_read_error(ec);
+                    release_read_buffer();
                     return;
                 }
 
-                if (!isOpened()) return;
-                read_buffer_.write_completed(bytes_transferred);
-                process_read_buffer();
+                if (!isOpened()) {
+                    release_read_buffer();
+                    return;
+                }
+                on_readable();
                 if (isOpened()) do_read();
             }
     );
 }
 
-void ClientSession::process_read_buffer() {
-    switch (session_mode_) {
-        case SessionMode::AUTH_SESSION:
-            ReaderAuthSession::process_read_buffer_as_authserver(shared_from_this());
-            break;
-        case SessionMode::WORK_SESSION:
-            ReaderWorkSession::process_read_buffer_as_workserver(shared_from_this());
-            break;
-        default:
-            Logger::get()->error("[client_session][process_read_buffer] Unknown session mode!");
-            break;
+void ClientSession::on_readable() {
+    if (!read_buffer_) read_buffer_ = ReceiveBufferPool::local().acquire();
+    read_buffer_->ensure_free_space(512);
+
+    boost::system::error_code ec;
+    std::size_t bytes_transferred = socket_.read_some(
+            boost::asio::buffer(read_buffer_->write_ptr(), read_buffer_->get_remaining_space()), ec);
+
+    if (ec == boost::asio::error::would_block) {
+        release_read_buffer();      // ложное пробуждение
+        return;
+    }
+    if (ec) {
+        handle_read_error(ec);
+        release_read_buffer();
+        return;
+    }
+
+    PURITY_LOG_TRACE("[client_session][do_read] {} bytes", bytes_transferred);
+    bytes_received.add(bytes_transferred);
+    read_buffer_->write_completed(bytes_transferred);
+    process_read_buffer();
+    release_read_buffer();
+}
+
+void ClientSession::release_read_buffer() {
+    // Неполный кадр остаётся в буфере до следующих данных; закрытой сессии буфер больше не нужен
+    if (read_buffer_ && (read_buffer_->get_active_size() == 0 || !isOpened())) {
+        ReceiveBufferPool::local().release(std::move(read_buffer_));
     }
 }
 
+void ClientSession::handle_read_error(const boost::system::error_code &ec) {
+    if (ec == boost::asio::error::operation_aborted ||
+        ec == boost::asio::error::eof ||
+        ec == boost::asio::error::connection_reset) {
+        PURITY_LOG_DEBUG("[client_session][do_read] Client disconnected: {}", ec.message());
+        close();
+        return;
+    }
+
+    Logger::get().error("[client_session][do_read] Read error: {}", ec.message());
+    close_with_error("read error");
+}
+
+void ClientSession::process_read_buffer() {
+    auto self = shared_from_this();
+
+    // Если обработчик сменил режим посреди буфера, остаток разбирает фреймер нового режима
+    SessionMode mode;
+    size_t frames = 0;
+    do {
+        mode = session_mode_;
+        switch (mode) {
+            case SessionMode::AUTH_SESSION:
+                frames += Framer<AuthSessionTraits>::process(self);
+                break;
+            case SessionMode::WORK_SESSION:
+                frames += Framer<WorkSessionTraits>::process(self);
+                break;
+            default:
+                Logger::get().error("[client_session][process_read_buffer] Unknown session mode!");
+                return;
+        }
+    } while (isOpened() && session_mode_ != mode);
+    packets_received.add(frames);
+}
+
 /**
- * Обертка для безопасной отправки пакета из любого потока и корутины
+ * Обертка для безопасной отправки пакета из любого потока и корутины: очередь записи трогается только на strand'е сессии
  */
 void ClientSession::send_packet(std::shared_ptr<const Packet> packet) {
     if (closed_) {
-        Logger::get()->debug("[client_session][send_packet] called. closed_={}", closed_.load());
+        PURITY_LOG_DEBUG("[client_session][send_packet] called. closed_={}", closed_.load());
         return;
     }
 
@@ -117,8 +245,14 @@ void ClientSession::send_packet(std::shared_ptr<const Packet> packet) {
  * Отправка пакета клиенту
  */
 void ClientSession::do_send_packet(const Packet &packet) {
-    std::vector<uint8_t> full_packet = packet.build_packet();
+    // send_packet откладывает работу через post: к этому моменту close() мог уже очистить очередь
+    if (!isOpened()) return;
+
+    ByteBuffer full_packet = packet.build_packet();
+    flight_recorder_.record_outbound(full_packet.data(), full_packet.size());
     write_queue_.push_back(std::move(full_packet));
+    write_queue_depth.add();
+    packets_sent.add();
 
     if (!writing_) {
         do_write();
@@ -136,19 +270,28 @@ void ClientSession::do_write() {
 
     boost::asio::async_write(
             socket_,
-            boost::asio::buffer(write_queue_.front()),
-            [this, self](boost::system::error_code ec, std::size_t) {
-                auto log = Logger::get();
+            boost::asio::buffer(write_queue_.front().data(), write_queue_.front().size()),
+            [this, self](boost::system::error_code ec, std::size_t bytes_transferred) {
+                auto &log = Logger::get();
+                bytes_sent.add(bytes_transferred);
 
                 if (ec) {
+                    // close() мог уже пройти и до очереди не дотянуться — снимаем её здесь
+                    write_queue_depth.sub(static_cast<int64_t>(write_queue_.size()));
+                    write_queue_.clear();
+                    writing_ = false;
+
                     if (ec != boost::asio::error::operation_aborted && ec != boost::asio::error::eof) {
-                        log->error("[client_session] Write failed: {}", ec.message());
+                        log.error("[client_session] Write failed: {}", ec.message());
+                        close_with_error("write failed");
+                        return;
                     }
                     close();
                     return;
                 }
 
                 write_queue_.pop_front();
+                write_queue_depth.sub();
                 do_write();
             }
     );
@@ -7,47 +7,80 @@
 #include <atomic>
 
 #include "src/server/Server.hpp"
-#include "packet/MessageBuffer.hpp"
+#include "packet/FlightRecorder.hpp"
+#include "packet/ReceiveBufferPool.hpp"
+#include "packet/RingMessageBuffer.hpp"
 #include "packet/Packet.hpp"
+#include "src/server/SessionMode/SessionMode.hpp"
 #include "src/server/SessionMode/authstage/entity/AccountInfo.hpp"
 
 class Server; // forward declaration
 
-enum class SessionMode {
-    AUTH_SESSION,
-    WORK_SESSION
-};
-
 class ClientSession : public std::enable_shared_from_this<ClientSession> {
 public:
     ClientSession(boost::asio::ip::tcp::socket socket, std::shared_ptr<Server> server);
+    ~ClientSession();
 
     void start();
 
     void close();
 
+    /** закрывает сессию после ошибки, сначала сбросив в лог последние пакеты **/
+    void close_with_error(std::string_view reason);
+
     bool isOpened() const { return !closed_; }
 
     void send_packet(std::shared_ptr<const Packet> packet);
 
     boost::asio::ip::tcp::socket &socket() { return socket_; }
 
+    // Strand сессии (см. Server::start_accept): на нём идут чтение, запись, корутинные обработчики опкодов;
+    // всё, что трогает сессию из чужого потока, отправляется сюда через post
+    boost::asio::ip::tcp::socket::executor_type get_executor() { return socket_.get_executor(); }
+
     std::shared_ptr<Server> server() const { return server_; }
 
-    // Режим: AUTH или WORK
-    void set_session_mode(SessionMode mode) { session_mode_ = mode; }
+    // ID в SessionRegistry сервера; 0 — сессия ещё не зарегистрирована
+    uint64_t session_id() const { return session_id_; }
+
+    void set_session_id(uint64_t id) { session_id_ = id; }
+
+    // Режим: AUTH или WORK; переносит сессию между purity_sessions_active{mode=...}
+    void set_session_mode(SessionMode mode);
 
     SessionMode get_session_mode() const { return session_mode_; }
 
-    MessageBuffer &read_buffer() {
-        return read_buffer_;
+    /** буфер с непрочитанными данными; есть только пока разбираются пришедшие байты (из process_read_buffer) **/
+    RingMessageBuffer &read_buffer() {
+        return *read_buffer_;
     }
 
+    // 8 кадров по 128 байт: пакеты авторизации и work-сессии почти всегда помещаются целиком
+    using PacketFlightRecorder = FlightRecorder<8, 128>;
+
+    PacketFlightRecorder &flight_recorder() { return flight_recorder_; }
+
+    /** nullptr, пока клиент не прислал CMSG_AUTH_LOGON_CHALLENGE **/
     AccountInfo *getAccountInfo() { return accountInfo_.get(); }
 
+    /** создаёт AccountInfo при первом обращении **/
+    AccountInfo &acquireAccountInfo();
+
+    /** оценка памяти, занимаемой сессией (объект, буферы, очередь записи, состояние аккаунта); только на strand'е сессии **/
+    size_t memory_footprint() const;
+
+    // Пересчитывает вклад сессии в purity_session_memory_bytes; вызывается при смене режима, только на strand'е сессии
+    void update_memory_gauge();
+
 private:
     void do_read();
 
+    void on_readable();
+
+    void release_read_buffer();
+
+    void handle_read_error(const boost::system::error_code &ec);
+
     void process_read_buffer();
 
     void do_write();
@@ -56,13 +89,17 @@ private:
 
     boost::asio::ip::tcp::socket socket_;
     std::shared_ptr<Server> server_;
-    std::shared_ptr<AccountInfo> accountInfo_ = std::make_shared<AccountInfo>();
+    uint64_t session_id_ = 0;
+    std::unique_ptr<AccountInfo> accountInfo_;
 
-    MessageBuffer read_buffer_;
+    ReceiveBufferPool::BufferPtr read_buffer_;     // nullptr, пока нет непрочитанных данных
+    PacketFlightRecorder flight_recorder_;
 
-    std::deque<std::vector<uint8_t>> write_queue_;
+    std::deque<ByteBuffer> write_queue_;
     bool writing_ = false;
     std::atomic<bool> closed_{false};
 
     SessionMode session_mode_ = SessionMode::AUTH_SESSION;
+    bool counted_ = false;      // учтена в purity_sessions_active (после start)
+    std::atomic<size_t> accounted_memory_{0};   // вклад в purity_session_memory_bytes
 };
@@ -1,15 +1,46 @@
 #include "Server.hpp"
 #include "ClientSession/ClientSession.hpp"
 #include "Logger.hpp"
+#include "metrics/CycleClock.hpp"
+#include "metrics/Histogram.hpp"
+#include "SessionMode/authstage/reader/AuthSessionTraits.hpp"
+#include "SessionMode/workstage/reader/WorkSessionTraits.hpp"
+
+#include <atomic>
 
 using boost::asio::ip::tcp;
 
+namespace {
+    // При наплыве подключений логи не должны стать узким местом
+    constexpr uint32_t CONNECT_LOG_RATE = 10;           // "New client connected" в секунду
+    constexpr uint32_t CONNECT_LOG_BURST = 20;
+    constexpr uint32_t SESSION_COUNT_LOG_EVERY = 16;    // каждое N-е изменение числа сессий
+
+    template<typename Traits>
+    void log_opcode_stats_of(double ns_per_tick) {
+        using Dispatcher = OpcodeTable::Dispatcher<Traits>;
+        auto &log = Logger::get();
+        Dispatcher::for_each([&](const auto &entry, const OpcodeTable::Stats &s) {
+            auto latency = Histogram::summarize(Dispatcher::latency(entry), ns_per_tick);
+            log.info("[Server] {} {}: packets={} bytes={} rejected={} latency_ns p50={} p90={} p99={} p999={} mean={}",
+                     Traits::NAME, entry.name, s.packets, s.bytes, s.rejected,
+                     latency.p50, latency.p90, latency.p99, latency.p999, latency.mean);
+        });
+
+        auto total = Histogram::summarize(Dispatcher::mode_latency(), ns_per_tick);
+        log.info("[Server] {} all opcodes: packets={} unknown={} latency_ns p50={} p90={} p99={} p999={}",
+                 Traits::NAME, total.count, Dispatcher::unknown(), total.p50, total.p90, total.p99, total.p999);
+    }
+}
+
 Server::Server(boost::asio::io_context &io_context,
                std::shared_ptr<Database> db,
-               int port)
+               int port,
+               AccountDirectory::DuplicateLoginPolicy duplicate_login)
         : io_context_(io_context), acceptor_(io_context, tcp::endpoint(tcp::v4(), port)),
           db_(std::move(db)),
-          account_cache_(std::make_shared<AccountCache>(io_context, std::chrono::minutes(5), std::chrono::minutes(1)))
+          account_cache_(std::make_shared<AccountCache>(io_context, std::chrono::minutes(5), std::chrono::minutes(1))),
+          accounts_(duplicate_login)
 {
     account_cache_->start(); // <-- Запускаем таймер только после make_shared
 }
@@ -17,34 +48,40 @@ Server::Server(boost::asio::io_context &io_context,
 void Server::start_accept() {
     if (!acceptor_.is_open()) return;
 
+    // Каждой сессии свой strand: чтение, запись, обработчики опкодов и close() выполняются по очереди
     acceptor_.async_accept(
+            boost::asio::make_strand(io_context_),
             [self = shared_from_this()](boost::system::error_code ec, tcp::socket socket) {
-                auto log = Logger::get();
+                auto &log = Logger::get();
                 if (ec) {
                     if (ec != boost::asio::error::operation_aborted &&
                         ec != boost::asio::error::eof) {
-                        log->error("[Server] Accept failed: {}", ec.message());
+                        log.error("[Server] Accept failed: {}", ec.message());
                     }
                     return;
                 }
 
                 auto session = std::make_shared<ClientSession>(std::move(socket), self);
 
-                {
-                    std::lock_guard<std::mutex> lock(self->sessions_mutex_);
-                    self->sessions_.insert(session);
-                    log->info("[Server] New client connected.");
-                    self->log_session_count();
+                try {
+                    session->set_session_id(self->sessions_.add(session));
+                } catch (const std::exception &e) {
+                    log.error("[Server] Rejecting client: {}", e.what());
+                    self->start_accept();
+                    return;
                 }
+                PURITY_LOG_RATE(INFO, CONNECT_LOG_RATE, CONNECT_LOG_BURST, "[Server] New client connected.");
+                self->log_session_count();
 
-                session->start();
+                // start() берёт оценку памяти сессии — как и всё остальное, только на её strand'е
+                boost::asio::post(session->get_executor(), [session] { session->start(); });
                 self->start_accept();
             }
     );
 }
 
 void Server::stop() {
-    auto log = Logger::get();
+    auto &log = Logger::get();
 
     if (account_cache_) {
         account_cache_->stop();
@@ -53,47 +90,94 @@ void Server::stop() {
     boost::system::error_code ec;
     acceptor_.cancel(ec);
     if (ec && ec != boost::asio::error::operation_aborted && ec != boost::asio::error::eof) {
-        log->error("[Server] Failed to cancel acceptor: {}", ec.message());
+        log.error("[Server] Failed to cancel acceptor: {}", ec.message());
     }
 
     acceptor_.close(ec);
     if (ec && ec != boost::asio::error::operation_aborted && ec != boost::asio::error::eof) {
-        log->error("[Server] Failed to close acceptor: {}", ec.message());
+        log.error("[Server] Failed to close acceptor: {}", ec.message());
     }
 
-    // Для избежания dead lock'a, нужно делать копию списка, закрыть открытые сокеты (где тоже мьютекс)
-    {
-        std::unordered_set<std::shared_ptr<ClientSession>> sessions_copy;
-        {
-            std::lock_guard<std::mutex> lock(sessions_mutex_);
-            sessions_copy = sessions_;
-        }
-
-        for (auto &s : sessions_copy) {
-            if (s->isOpened()) s->close();
-        }
+    // close() сам удаляет сессию из реестра, поэтому закрываем по снимку, а не во время обхода.
+    // Каждую — на её strand'е, как в claim_account: в других потоках сессии ещё читают и пишут
+    auto snapshot = sessions_.snapshot();
+    if (snapshot.empty()) {
+        finish_stop();
+        return;
     }
 
-    // Теперь очищаем список
-    {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        sessions_.clear();
+    // io_context останавливаем только после последнего close(), иначе stop() отбросит ещё не выполненные
+    auto remaining = std::make_shared<std::atomic<size_t>>(snapshot.size());
+    for (auto &s : snapshot) {
+        boost::asio::post(s->get_executor(), [self = shared_from_this(), s, remaining] {
+            if (s->isOpened()) s->close();
+            if (remaining->fetch_sub(1) == 1) self->finish_stop();
+        });
     }
+}
 
+void Server::finish_stop() {
     io_context_.stop();
 
     // ✅ Корректно закрываем все DB connections:
     if (db_) db_->shutdown();
 
-    log_session_count();
+    // Сессии сняты с реестра их же close(); ненулевое число — сессия, которую remove_session потерял
+    Logger::get().info("[Server] Active sessions: {}", sessions_.size());
+    log_opcode_stats();
+}
+
+void Server::remove_session(const ClientSession &session) {
+    if (sessions_.remove(session.session_id())) log_session_count();
+}
+
+bool Server::claim_account(const std::string &username, ClientSession &session) {
+    auto &log = Logger::get();
+    auto result = accounts_.claim(username, session.session_id(), [this](uint64_t id) {
+        auto s = sessions_.find(id);
+        return s && s->isOpened();
+    });
+
+    if (!result.accepted) {
+        log.info("[Server] Account {} is already online, rejecting new login", username);
+        return false;
+    }
+    if (auto previous = sessions_.find(result.displaced)) {
+        log.info("[Server] Account {} logged in again, closing previous session", username);
+        // Мы на strand'е новой сессии; close() прежней — на её strand'е, после её текущего чтения/записи
+        boost::asio::post(previous->get_executor(), [previous] { previous->close(); });
+    }
+
+    // close() мог пройти раньше claim и уже ничего не снял — снимаем сами
+    if (!session.isOpened()) {
+        accounts_.release(username, session.session_id());
+        return false;
+    }
+    return true;
+}
+
+void Server::release_account(const std::string &username, const ClientSession &session) {
+    accounts_.release(username, session.session_id());
+}
+
+std::shared_ptr<ClientSession> Server::find_account_session(const std::string &username) const {
+    uint64_t id = accounts_.find(username);
+    return id ? sessions_.find(id) : nullptr;
+}
+
+void Server::dump_flight_recorders() {
+    Logger::get().warn("[Server] Dumping flight recorders of {} sessions", sessions_.size());
+    sessions_.for_each([](const std::shared_ptr<ClientSession> &s) {
+        if (s->isOpened()) s->flight_recorder().dump("admin request");
+    });
 }
 
-void Server::remove_session(std::shared_ptr<ClientSession> session) {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
-    sessions_.erase(session);
-    log_session_count();
+void Server::log_opcode_stats() {
+    double ns_per_tick = CycleClock::ns_per_tick();
+    log_opcode_stats_of<AuthSessionTraits>(ns_per_tick);
+    log_opcode_stats_of<WorkSessionTraits>(ns_per_tick);
 }
 
 void Server::log_session_count() {
-    Logger::get()->info("[Server] Active sessions: {}", sessions_.size());
+    PURITY_LOG_EVERY_N(INFO, SESSION_COUNT_LOG_EVERY, "[Server] Active sessions: {}", sessions_.size());
 }
@@ -2,12 +2,12 @@
 
 #include <boost/asio.hpp>
 #include <memory>
-#include <unordered_set>
-#include <mutex>
 
 #include "Database.hpp"
 #include "ClientSession/ClientSession.hpp"
 #include "AccountCache/AccountCache.hpp"
+#include "AccountDirectory/AccountDirectory.hpp"
+#include "SessionRegistry/SessionRegistry.hpp"
 
 class ClientSession;
 
@@ -15,22 +15,40 @@ class Server : public std::enable_shared_from_this<Server> {
 public:
     Server(boost::asio::io_context &io_context,
            std::shared_ptr<Database> db,
-           int port);
+           int port,
+           AccountDirectory::DuplicateLoginPolicy duplicate_login = AccountDirectory::DuplicateLoginPolicy::KICK_OLD);
 
     void start_accept();
     void stop();
-    void remove_session(std::shared_ptr<ClientSession> session);
+    void remove_session(const ClientSession &session);
+    // Сбрасывает в лог самописцы пакетов всех открытых сессий (по SIGUSR1)
+    void dump_flight_recorders();
+    // Счётчики опкодов обоих режимов: пакеты, байты, отклонённые, квантили времени обработчика
+    void log_opcode_stats();
     void log_session_count();
 
+    /**
+     * Закрепляет аккаунт за авторизованной сессией; при KICK_OLD закрывает прежнюю сессию аккаунта.
+     * false — вход отклонён (REJECT_NEW при живой прежней сессии) или сессия уже закрылась.
+     */
+    bool claim_account(const std::string &username, ClientSession &session);
+    void release_account(const std::string &username, const ClientSession &session);
+    // Сессия аккаунта в игре или nullptr; без обхода всех сессий
+    std::shared_ptr<ClientSession> find_account_session(const std::string &username) const;
+
     std::shared_ptr<Database> db() { return db_; }
     std::shared_ptr<AccountCache> account_cache() { return account_cache_; }
+    SessionRegistry<ClientSession> &sessions() { return sessions_; }
 
 private:
+    // Вторая половина stop(): после того как close() всех сессий отработали на их strand'ах
+    void finish_stop();
+
     boost::asio::io_context &io_context_;
     boost::asio::ip::tcp::acceptor acceptor_;
     std::shared_ptr<Database> db_;
     std::shared_ptr<AccountCache> account_cache_;
 
-    std::unordered_set<std::shared_ptr<ClientSession>> sessions_;
-    std::mutex sessions_mutex_;
+    SessionRegistry<ClientSession> sessions_;
+    AccountDirectory accounts_;
 };
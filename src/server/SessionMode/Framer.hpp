@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+
+#include "Logger.hpp"
+#include "packet/RingMessageBuffer.hpp"
+#include "src/server/SessionMode/OpcodeTable.hpp"
+
+/**
+ * Нарезка входящего потока на кадры [opcode][length(uint16 BE)][payload] для одного режима сессии.
+ * Режим описывается traits-структурой:
+ *
+ *     struct AuthSessionTraits {
+ *         using Opcode = AuthOpcodes;
+ *         using PacketType = AuthPacket;                        // конструктор от Opcode + write_bytes()
+ *         static constexpr SessionMode MODE = SessionMode::AUTH_SESSION;
+ *         static constexpr size_t OPCODE_SIZE = 1;              // 1 или 2 байта, big endian
+ *         static constexpr size_t MAX_PAYLOAD = 2048;
+ *         static constexpr std::string_view NAME = "AuthPacket";
+ *         static constexpr std::array HANDLERS = {...};         // см. OpcodeTable
+ *         static constexpr auto TABLE = OpcodeTable::make<HANDLERS, MODE>();
+ *     };
+ *
+ * Всё в заголовке и без виртуальных вызовов: разбор встраивается прямо в ClientSession.
+ * Session — ClientSession или тестовая заглушка с тем же интерфейсом.
+ */
+template<typename Traits>
+class Framer {
+public:
+    static_assert(Traits::OPCODE_SIZE == 1 || Traits::OPCODE_SIZE == 2);
+    static_assert(Traits::MAX_PAYLOAD <= UINT16_MAX);
+
+    using Opcode = typename Traits::Opcode;
+    using PacketType = typename Traits::PacketType;
+    using Dispatcher = OpcodeTable::Dispatcher<Traits>;
+
+    static constexpr size_t HEADER_SIZE = Traits::OPCODE_SIZE + 2;
+
+    static constexpr uint32_t UNKNOWN_LOG_RATE = 10;     // предупреждений о незнакомых опкодах в секунду
+    static constexpr uint32_t UNKNOWN_LOG_BURST = 20;
+
+    static constexpr Opcode opcode(const uint8_t* header) {
+        if constexpr (Traits::OPCODE_SIZE == 1) return static_cast<Opcode>(header[0]);
+        else return static_cast<Opcode>(static_cast<uint16_t>(header[0] << 8 | header[1]));
+    }
+
+    static constexpr uint16_t payload_size(const uint8_t* header) {
+        return static_cast<uint16_t>(header[Traits::OPCODE_SIZE] << 8 | header[Traits::OPCODE_SIZE + 1]);
+    }
+
+    /**
+     * Разбирает все полные кадры в session->read_buffer(). Останавливается на неполном кадре (он ждёт
+     * следующих данных), при закрытии сессии и при смене режима — остаток разберёт фреймер нового режима.
+     * Возвращает число обработанных кадров.
+     */
+    template<typename Session>
+    static size_t process(const std::shared_ptr<Session>& session) {
+        RingMessageBuffer& buffer = session->read_buffer();
+        size_t frames = 0;
+
+        while (session->isOpened() && session->get_session_mode() == Traits::MODE) {
+            if (buffer.get_active_size() < HEADER_SIZE) break;
+
+            // Заголовок может пересекать границу кольца — peek отдаёт его одним куском
+            const uint8_t* header = buffer.peek(HEADER_SIZE);
+            uint16_t size = payload_size(header);
+
+            // Проверяется по заголовку, не дожидаясь payload: заявленные 64 КБ не должны раздувать буфер
+            if (size > Traits::MAX_PAYLOAD) {
+                Logger::get().error("[Framer] {} payload too big: {}", Traits::NAME, size);
+                session->flight_recorder().record_inbound(header, HEADER_SIZE);
+                session->close_with_error("payload too big");
+                break;
+            }
+
+            // Обработчик ищется по заголовку: незнакомый или слишком короткий кадр в пакет не копируется
+            const auto* entry = Dispatcher::find(opcode(header), Traits::MODE);
+            if (entry && size < entry->min_payload) {
+                Logger::get().error("[Framer] {} {} payload too short: {} < {}",
+                                    Traits::NAME, entry->name, size, entry->min_payload);
+                Dispatcher::count_rejected(*entry);
+                session->flight_recorder().record_inbound(header, HEADER_SIZE);
+                session->close_with_error("payload too short");
+                break;
+            }
+
+            if (buffer.get_active_size() < HEADER_SIZE + size) break;
+
+            // Весь кадр одним куском прямо из кольца, без промежуточного вектора
+            std::span<const uint8_t> frame(buffer.peek(HEADER_SIZE + size), HEADER_SIZE + size);
+            session->flight_recorder().record_inbound(frame.data(), frame.size());
+            PURITY_LOG_TRACE("[Framer] {} opcode {:#x}, {} bytes",
+                             Traits::NAME, static_cast<uint16_t>(opcode(frame.data())), size);
+
+            if (!entry) {
+                PURITY_LOG_RATE(WARN, UNKNOWN_LOG_RATE, UNKNOWN_LOG_BURST, "[Framer] {} unknown opcode: {:#x}",
+                                Traits::NAME, static_cast<uint16_t>(opcode(frame.data())));
+                Dispatcher::count_unknown();
+                buffer.read_completed(HEADER_SIZE + size);
+                ++frames;
+                continue;
+            }
+
+            try {
+                // payload копируется в пакет, кадр в кольце дальше не нужен
+                PacketType packet(opcode(frame.data()));
+                packet.write_bytes(frame.data() + HEADER_SIZE, size);
+                buffer.read_completed(HEADER_SIZE + size);
+                ++frames;
+
+                Dispatcher::dispatch(session, *entry, packet);
+            } catch (const std::exception& ex) {
+                Logger::get().error("[Framer] {} processing failed: {}", Traits::NAME, ex.what());
+                session->close_with_error("packet processing failed");
+                break;
+            }
+        }
+        return frames;
+    }
+};
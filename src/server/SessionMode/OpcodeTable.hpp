@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+
+#include "Logger.hpp"
+#include "metrics/CycleClock.hpp"
+#include "metrics/Histogram.hpp"
+#include "src/server/SessionMode/SessionMode.hpp"
+
+/**
+ * Таблица обработчиков опкодов, собираемая при компиляции: плотный std::array, индекс — значение опкода.
+ *
+ *     static constexpr std::array HANDLERS = {
+ *         OpcodeTable::on<AuthMessages::Ping>(AuthOpcodes::CMSG_PING, "CMSG_PING", &HandlersAuth::handle_ping),
+ *         ...
+ *     };
+ *     static constexpr auto TABLE = OpcodeTable::make<HANDLERS, SessionMode::AUTH_SESSION>();
+ *
+ * Новый опкод — одна строка в HANDLERS. Повтор опкода — ошибка компиляции.
+ * Минимальный payload берётся из схемы сообщения (PacketSchema MIN_SIZE) и проверяется до разбора.
+ * Время каждого обработчика пишется в гистограмму его опкода (для корутин — до завершения).
+ */
+namespace OpcodeTable {
+
+    enum class HandlerKind : uint8_t {
+        NONE,           // опкод не зарегистрирован
+        INLINE,         // вызывается прямо из фреймера
+        COROUTINE       // запускается через co_spawn на executor'е сессии
+    };
+
+    template<typename Session, typename Packet>
+    struct Entry {
+        using InlineHandler = void (*)(std::shared_ptr<Session>, Packet&);
+        // Пакет по значению: корутина стартует через post, когда пакет фреймера уже уничтожен
+        using CoroutineHandler = boost::asio::awaitable<void> (*)(std::shared_ptr<Session>, Packet);
+
+        HandlerKind kind = HandlerKind::NONE;
+        InlineHandler on_packet = nullptr;
+        CoroutineHandler on_packet_async = nullptr;
+        SessionMode mode = SessionMode::AUTH_SESSION;
+        uint16_t opcode = 0;
+        uint16_t index = 0;             // номер среди зарегистрированных: гистограмма опкода
+        uint16_t min_payload = 0;
+        std::string_view name;
+    };
+
+    template<typename Opcode, typename Session, typename Packet>
+    struct Registration {
+        Opcode opcode;
+        Entry<Session, Packet> entry;
+    };
+
+    // Обработчик, вызываемый синхронно; Msg — сообщение с PacketSchema, его MIN_SIZE — нижняя граница payload'а
+    template<typename Msg, typename Opcode, typename Session, typename Packet>
+    constexpr Registration<Opcode, Session, Packet>
+    on(Opcode opcode, std::string_view name, void (*handler)(std::shared_ptr<Session>, Packet&)) {
+        Entry<Session, Packet> entry;
+        entry.kind = HandlerKind::INLINE;
+        entry.on_packet = handler;
+        entry.min_payload = static_cast<uint16_t>(Msg::Schema::MIN_SIZE);
+        entry.name = name;
+        return {opcode, entry};
+    }
+
+    template<typename Msg, typename Opcode, typename Session, typename Packet>
+    constexpr Registration<Opcode, Session, Packet>
+    on(Opcode opcode, std::string_view name, boost::asio::awaitable<void> (*handler)(std::shared_ptr<Session>, Packet)) {
+        Entry<Session, Packet> entry;
+        entry.kind = HandlerKind::COROUTINE;
+        entry.on_packet_async = handler;
+        entry.min_payload = static_cast<uint16_t>(Msg::Schema::MIN_SIZE);
+        entry.name = name;
+        return {opcode, entry};
+    }
+
+    template<auto& HANDLERS>
+    constexpr size_t table_size() {
+        size_t size = 0;
+        for (const auto& h : HANDLERS) size = std::max(size, static_cast<size_t>(h.opcode) + 1);
+        return size;
+    }
+
+    // Размер таблицы — наибольший зарегистрированный опкод + 1
+    template<auto& HANDLERS, SessionMode MODE>
+    constexpr auto make() {
+        using EntryType = decltype(HANDLERS[0].entry);
+        std::array<EntryType, table_size<HANDLERS>()> table{};
+        uint16_t index = 0;
+        for (const auto& h : HANDLERS) {
+            auto& entry = table[static_cast<size_t>(h.opcode)];
+            if (entry.kind != HandlerKind::NONE) throw std::logic_error("opcode registered twice");
+            entry = h.entry;
+            entry.mode = MODE;
+            entry.opcode = static_cast<uint16_t>(h.opcode);
+            entry.index = index++;
+        }
+        return table;
+    }
+
+    // Сумма по шардам потоков на момент чтения
+    struct Stats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t rejected = 0;      // payload короче минимального
+    };
+
+    /**
+     * Поиск и вызов обработчиков по Traits::TABLE плюс счётчики и гистограмма латентности на каждый опкод.
+     * Один экземпляр на режим: static inline внутри шаблона. Замер — два rdtsc и запись в шард
+     * своего потока (см. HistogramSet); счётчики пакетов и байтов лежат там же, общих атомиков нет.
+     */
+    template<typename Traits>
+    class Dispatcher {
+    public:
+        using Opcode = typename Traits::Opcode;
+        using EntryType = typename std::remove_cvref_t<decltype(Traits::TABLE)>::value_type;
+
+        static constexpr size_t SIZE = Traits::TABLE.size();
+        static constexpr size_t REGISTERED = std::size(Traits::HANDLERS);
+
+        // nullptr — опкод не зарегистрирован или не разрешён в этом режиме
+        static constexpr const EntryType* find(Opcode opcode, SessionMode mode) {
+            auto index = static_cast<size_t>(opcode);
+            if (index >= SIZE) return nullptr;
+            const EntryType& entry = Traits::TABLE[index];
+            return entry.kind != HandlerKind::NONE && entry.mode == mode ? &entry : nullptr;
+        }
+
+        template<typename Session, typename Packet>
+        static void dispatch(const std::shared_ptr<Session>& session, const EntryType& entry, Packet& packet) {
+            latency_.add(entry.index, PACKETS);
+            latency_.add(entry.index, BYTES, packet.size());
+
+            uint64_t start = CycleClock::now();
+            if (entry.kind == HandlerKind::INLINE) {
+                entry.on_packet(session, packet);
+                latency_.record(entry.index, CycleClock::now() - start);
+                return;
+            }
+
+            boost::asio::co_spawn(
+                    session->get_executor(),
+                    entry.on_packet_async(session, packet),
+                    [start, index = entry.index, name = entry.name](std::exception_ptr ex) {
+                        latency_.record(index, CycleClock::now() - start);
+                        if (!ex) return;
+                        try { std::rethrow_exception(ex); }
+                        catch (const std::exception& e) {
+                            Logger::get().error("[{}] {} coroutine failed: {}", Traits::NAME, name, e.what());
+                        }
+                    });
+        }
+
+        static void count_rejected(const EntryType& entry) { latency_.add(entry.index, REJECTED); }
+
+        static void count_unknown() { latency_.add(UNKNOWN_ROW, PACKETS); }
+
+        static Stats stats(Opcode opcode) {
+            auto index = static_cast<size_t>(opcode);
+            if (index >= SIZE || Traits::TABLE[index].kind == HandlerKind::NONE) return {};
+            return stats_of(Traits::TABLE[index]);
+        }
+
+        static uint64_t unknown() { return latency_.counter(UNKNOWN_ROW, PACKETS); }
+
+        // Латентность обработчика в тиках CycleClock; для вывода — Histogram::summarize(.., ns_per_tick())
+        static Histogram::Snapshot latency(const EntryType& entry) { return latency_.snapshot(entry.index); }
+
+        // Все опкоды режима вместе
+        static Histogram::Snapshot mode_latency() {
+            Histogram::Snapshot total;
+            for (size_t i = 0; i < REGISTERED; ++i) total.merge(latency_.snapshot(i));
+            return total;
+        }
+
+        // callback(entry, stats) для каждого зарегистрированного опкода
+        template<typename Callback>
+        static void for_each(Callback&& callback) {
+            for (const EntryType& entry : Traits::TABLE) {
+                if (entry.kind != HandlerKind::NONE) callback(entry, stats_of(entry));
+            }
+        }
+
+    private:
+        // Счётчики рядом с гистограммой опкода
+        enum Counter : size_t {
+            PACKETS,
+            BYTES,
+            REJECTED,
+            COUNTERS
+        };
+
+        // Строка без гистограммы под незнакомые опкоды — только PACKETS
+        static constexpr size_t UNKNOWN_ROW = REGISTERED;
+
+        static Stats stats_of(const EntryType& entry) {
+            return {latency_.counter(entry.index, PACKETS), latency_.counter(entry.index, BYTES),
+                    latency_.counter(entry.index, REJECTED)};
+        }
+
+        static inline HistogramSet latency_{REGISTERED + 1, COUNTERS};
+    };
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+enum class SessionMode {
+    AUTH_SESSION,
+    WORK_SESSION
+};
@@ -1,11 +1,38 @@
 #include "AccountInfo.hpp"
 #include "Logger.hpp"
+#include "src/server/ClientSession/ClientSession.hpp"
+
+#include <openssl/crypto.h>
+
+AccountInfo::~AccountInfo() {
+    OPENSSL_cleanse(session_key_.data(), session_key_.size());
+}
+
+SRP6 *AccountInfo::begin_auth(const std::string &username) {
+    srp_ = std::make_unique<SRP6>();
+    srp_->set_only_username(username);
+    username_ = username;
+    return srp_.get();
+}
+
+bool AccountInfo::handle_auth_state(ClientSession &session) {
+    if (auto server = session.server(); server && !server->claim_account(username_, session)) return false;
 
-void AccountInfo::handle_auth_state() {
     setIsAuthenticated(true);
-    Logger::get()->info("Account {} was successfully authorized", srp()->getUserName());
+    if (srp_) {
+        session_key_ = srp_->get_session_key();
+        srp_.reset();   // После логина SRP6 не нужен
+    }
+    Logger::get().info("Account {} was successfully authorized", username_);
+    return true;
+}
+
+void AccountInfo::handle_close_state(ClientSession &session) {
+    // Снимаем и без isAuth: claim мог пройти, а isAuth ещё не выставлен
+    if (auto server = session.server()) server->release_account(username_, session);
+    if (isAuth) Logger::get().info("Account {} was successfully closed connection", username_);
 }
 
-void AccountInfo::handle_close_state() {
-    Logger::get()->info("Account {} was successfully closed connection", srp()->getUserName());
-}
\ No newline at end of file
+size_t AccountInfo::memory_footprint() const {
+    return sizeof(AccountInfo) + username_.capacity() + (srp_ ? srp_->memory_footprint() : 0);
+}
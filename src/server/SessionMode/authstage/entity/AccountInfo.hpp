@@ -1,26 +1,58 @@
+#pragma once
+
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include "srp6/SRP6.hpp"
 
+class ClientSession;
+
+/**
+ * Состояние аккаунта сессии.
+ * SRP6 живёт только на время логина: создаётся на CMSG_AUTH_LOGON_CHALLENGE и освобождается
+ * при переходе в WORK_SESSION — дальше хранятся только имя и сессионный ключ.
+ */
 class AccountInfo {
 public:
+    using SessionKey = std::array<uint8_t, SRP6::SESSION_KEY_SIZE>;
+
     AccountInfo() = default;
 
-    ~AccountInfo() = default;
+    ~AccountInfo();
 
+    /** SRP6 текущей попытки логина или nullptr, если challenge ещё не было / логин завершён **/
     SRP6 *srp() { return srp_.get(); }
 
+    /** начинает новую попытку логина: свежий SRP6 с заданным именем **/
+    SRP6 *begin_auth(const std::string &username);
+
+    /** неудачный proof: SRP6 выбрасывается, следующая попытка — только через новый challenge **/
+    void abort_auth() { srp_.reset(); }
+
     void setIsAuthenticated(bool value) { isAuth = value; }
 
     bool isAuthenticated() { return isAuth; }
 
-    /** метод, вызываемый, когда acc становится авторизованным **/
-    void handle_auth_state();
+    const std::string &username() const { return username_; }
+
+    const SessionKey &session_key() const { return session_key_; }
+
+    /**
+     * метод, вызываемый, когда acc становится авторизованным; закрепляет аккаунт за сессией на сервере.
+     * false — вход отклонён политикой дублей, SRP6 и состояние не тронуты
+     */
+    bool handle_auth_state(ClientSession &session);
+
+    /** метод, вызываемый, когда acc завершает соединение; снимает аккаунт с сессии **/
+    void handle_close_state(ClientSession &session);
 
-    /** метод, вызываемый, когда acc завершает соединение **/
-    void handle_close_state();
+    /** оценка занимаемой памяти в байтах **/
+    size_t memory_footprint() const;
 
 private:
-    std::shared_ptr<SRP6> srp_ = std::make_shared<SRP6>();
+    std::unique_ptr<SRP6> srp_;
+    std::string username_;
+    SessionKey session_key_{};
     bool isAuth = false;
-};
\ No newline at end of file
+};
@@ -1,109 +1,103 @@
 #include "HandlersAuth.hpp"
 
+#include <algorithm>
 #include <utility>
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
 #include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
 #include "utils/PacketUtils.hpp"
 #include "utils/generators/GeneratorUtils.hpp"
 #include "utils/utf8utils/UTF8Utils.hpp"
+#include "metrics/Metrics.hpp"
 
 using namespace HandlersAuth;
 
-void HandlersAuth::dispatch(std::shared_ptr<ClientSession> session, AuthPacket &p) {
-    AuthOpcodes opcode = p.get_opcode();
-    switch (opcode) {
-        case AuthOpcodes::CMSG_PING:
-            handle_ping(std::move(session), p);
-            break;
-
-        case AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE:
-            boost::asio::co_spawn(
-                    session->socket().get_executor(),
-                    handle_logon_challenge(session, p),
-                    boost::asio::detached
-            );
-            break;
-
-        case AuthOpcodes::CMSG_AUTH_LOGON_PROOF:
-            handle_logon_proof(std::move(session), p);
-            break;
-
-        default:
-            Logger::get()->warn("[HandlersAuth] Unknown opcode: {}", static_cast<uint8_t>(opcode));
-            break;
+namespace {
+    Metrics::Timer &srp_challenge_time = Metrics::Registry::instance().timer(
+            "purity_srp_seconds", "SRP6 computation time by step", "step=\"challenge\"");
+    Metrics::Timer &srp_proof_time = Metrics::Registry::instance().timer(
+            "purity_srp_seconds", "SRP6 computation time by step", "step=\"proof\"");
+
+    void send_auth_failure(std::shared_ptr<ClientSession> session, AuthErrorCode error) {
+        AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
+        reply.write(AuthMessages::AuthResponse{AuthStatusCode::AUTH_FAILED, error});
+        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+    }
+
+    // B, g, N и salt (salt — 32 байта, проверено при загрузке из БД)
+    void send_logon_challenge(std::shared_ptr<ClientSession> session, const SRP6 &srp,
+                              std::span<const uint8_t> salt) {
+        AuthMessages::LogonChallengeReply msg;
+        msg.B = srp.get_B_array();
+        msg.g = srp.get_generator();
+        msg.N = SRP6Group::instance().N_bytes;
+        std::copy_n(salt.begin(), std::min(salt.size(), msg.salt.size()), msg.salt.begin());
+
+        AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_CHALLENGE);
+        reply.write(msg);
+        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
     }
 }
 
 void HandlersAuth::handle_ping(std::shared_ptr<ClientSession> session, AuthPacket &p) {
-    // Считываем ping ID из клиента (4 байта LE)
-    uint32_t ping = p.read_uint32_le();
+    // Ping ID из клиента, PONG возвращает то же самое число
+    auto ping = p.read<AuthMessages::Ping>();
 
-    // Формируем PONG — возвращаем то же самое число
     AuthPacket reply(AuthOpcodes::SMSG_PONG);
-    reply.write_uint32_le(ping);
+    reply.write(ping);
 
     // Отправляем обратно клиенту
-    Logger::get()->debug("[HandlersAuth] CMSG_PING");
+    PURITY_LOG_DEBUG("[HandlersAuth] CMSG_PING {}", ping.ping);
     PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
 }
 
 boost::asio::awaitable<void>
-HandlersAuth::handle_logon_challenge(std::shared_ptr<ClientSession> session, AuthPacket &p) {
-    auto log = Logger::get();
+HandlersAuth::handle_logon_challenge(std::shared_ptr<ClientSession> session, AuthPacket p) {
+    auto &log = Logger::get();
     std::string username;
     try {
         // 1 - читаем поле с именем, проверяем на UTF8
-        username = p.read_string_nt_le();
+        username = p.read<AuthMessages::LogonChallenge>().username;
     }
     catch (const std::exception &ex) {
-        log->error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE - Internal error: {}", ex.what());
+        log.error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE - Internal error: {}", ex.what());
 
-        AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
-        reply.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-        reply.write_uint8(static_cast<uint8_t>(AuthErrorCode::INTERNAL_ERROR));
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+        send_auth_failure(std::move(session), AuthErrorCode::INTERNAL_ERROR);
         co_return;
     }
 
     // 1 - проверка на UTF8
     if (!UTF8Utils::is_valid_utf8(username)) {
-        log->error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE - Invalid UTF-8 username received: {}", username);
+        log.error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE - Invalid UTF-8 username received: {}", username);
         // Обработка ошибки, например отказ
-        AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
-        reply.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-        reply.write_uint8(static_cast<uint8_t>(AuthErrorCode::WRONG_USERNAME));
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+        send_auth_failure(std::move(session), AuthErrorCode::WRONG_USERNAME);
         co_return;
     }
 
-    // 2 - делаем верхний регистр
-    username = UTF8Utils::to_uppercase(username);
-    session->getAccountInfo()->srp()->set_only_username(username);
+    // 2 - делаем верхний регистр (только ASCII — так же считает H(UPPER(I)) клиент)
+    UTF8Utils::to_uppercase_inplace(username);
+
+    // SRP6 создаётся только сейчас и живёт до перехода в WORK_SESSION
+    auto srp = session->acquireAccountInfo().begin_auth(username);
 
     auto cache = session->server()->account_cache();
     auto cached_user_opt = cache->get(username);
 
-    auto auth = session->getAccountInfo();
-    auto srp = auth->srp();
-
     // 3 - пробуем взять из кэша
     if (cached_user_opt) {
         auto &cached_user = *cached_user_opt;
 
-        srp->load_verifier(cached_user.salt, cached_user.verifier);
-        srp->generate_server_ephemeral();
+        {
+            Metrics::Timer::Scope timing(srp_challenge_time);
+            srp->load_verifier(cached_user.salt, cached_user.verifier);
+            srp->generate_server_ephemeral();
+        }
 
-        log->debug(
+        PURITY_LOG_DEBUG(
                 "[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE CACHED ENTRY used for '{}': B.size={}, g={}, N.size={}, salt.size={}",
                 username, srp->get_B_bytes().size(), srp->get_generator(), srp->get_N_bytes().size(),
                 cached_user.salt.size());
 
-        AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_CHALLENGE);
-        reply.write_bytes(srp->get_B_bytes());
-        reply.write_uint8(srp->get_generator());
-        reply.write_bytes(srp->get_N_bytes());
-        reply.write_bytes(cached_user.salt);
-
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+        send_logon_challenge(std::move(session), *srp, cached_user.salt);
         co_return;
     }
 
@@ -116,24 +110,18 @@ HandlersAuth::handle_logon_challenge(std::shared_ptr<ClientSession> session, Aut
 
         // 5 - если нет аккаунта
         if (!user) {
-            log->error("[HandlersAuth] User '{}' not found", username);
+            log.error("[HandlersAuth] User '{}' not found", username);
 
-            AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
-            reply.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-            reply.write_uint8(static_cast<uint8_t>(AuthErrorCode::WRONG_USERNAME));
-            PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+            send_auth_failure(std::move(session), AuthErrorCode::WRONG_USERNAME);
             co_return;
         }
 
         // 6 --- Проверка salt и verifier ---
         if (!user->salt.has_value() || !user->verifier.has_value() ||
             user->salt->size() != 32 || user->verifier->size() != 32) {
-            log->error("[HandlersAuth] User '{}' has invalid salt/verifier length", username);
+            log.error("[HandlersAuth] User '{}' has invalid salt/verifier length", username);
 
-            AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
-            reply.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-            reply.write_uint8(static_cast<uint8_t>(AuthErrorCode::WRONG_PASSWORD));
-            PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+            send_auth_failure(std::move(session), AuthErrorCode::WRONG_PASSWORD);
             co_return;
         }
 
@@ -143,60 +131,67 @@ HandlersAuth::handle_logon_challenge(std::shared_ptr<ClientSession> session, Aut
         cache->put(username, cacheEntry);
 
         // 7 --- Инициализация SRP ---
-        srp->load_verifier(*user->salt, *user->verifier);
-        srp->generate_server_ephemeral();
+        {
+            Metrics::Timer::Scope timing(srp_challenge_time);
+            srp->load_verifier(*user->salt, *user->verifier);
+            srp->generate_server_ephemeral();
+        }
 
-        log->debug("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE: B.size={}, g={}, N.size={}, salt.size={}",
+        PURITY_LOG_DEBUG("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE: B.size={}, g={}, N.size={}, salt.size={}",
                    srp->get_B_bytes().size(), srp->get_generator(), srp->get_N_bytes().size(), user->salt->size());
-        AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_CHALLENGE);
-        reply.write_bytes(srp->get_B_bytes());          // 32 байта B (публичный ключ сервера)
-        reply.write_uint8(srp->get_generator());        // 1 байт g
-        reply.write_bytes(srp->get_N_bytes());          // 32 байта N (большое простое число)
-        reply.write_bytes(*user->salt);                 // 32 байта salt
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+        send_logon_challenge(std::move(session), *srp, *user->salt);
         co_return;
     }
     catch (const std::exception &ex) {
-        log->error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE: {}", ex.what());
-        AuthPacket reply(AuthOpcodes::SMSG_AUTH_RESPONSE);
-        reply.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-        reply.write_uint8(static_cast<uint8_t>(AuthErrorCode::DATABASE_BUSY));
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
+        log.error("[HandlersAuth] CMSG_AUTH_LOGON_CHALLENGE: {}", ex.what());
+        send_auth_failure(std::move(session), AuthErrorCode::DATABASE_BUSY);
         co_return;
     }
 }
 
 void HandlersAuth::handle_logon_proof(std::shared_ptr<ClientSession> session, AuthPacket &p) {
-    auto log = Logger::get();
+    auto &log = Logger::get();
     try {
-        std::vector<uint8_t> A_bytes = p.read_bytes(32);
-        std::vector<uint8_t> M1_client = p.read_bytes(20);
-
-        std::vector<uint8_t> M2;
-        auto srp = session->getAccountInfo()->srp();
-
-        if (!srp->verify_client_proof(A_bytes, M1_client, M2)) {
-            log->warn("[HandlersAuth] CMSG_AUTH_LOGON_PROOF: SRP6 M1 verification failed");
-            AuthPacket fail(AuthOpcodes::SMSG_AUTH_RESPONSE);
-            fail.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-            fail.write_uint8(static_cast<uint8_t>(AuthErrorCode::WRONG_PASSWORD));
-            PacketUtils::send_packet_as<AuthPacket>(std::move(session), fail);
+        // A и M1 — одна проверка границ на 52 байта, без кучи
+        auto proof = p.read<AuthMessages::LogonProof>();
+
+        AuthMessages::LogonProofReply reply_msg;
+        auto account = session->getAccountInfo();
+        auto srp = account ? account->srp() : nullptr;
+
+        if (!srp) {
+            log.warn("[HandlersAuth] CMSG_AUTH_LOGON_PROOF without preceding challenge");
+            send_auth_failure(std::move(session), AuthErrorCode::INTERNAL_ERROR);
             return;
         }
 
-        log->debug("[HandlersAuth] CMSG_AUTH_LOGON_PROOF: SRP6 OK — Sent SMSG_AUTH_LOGON_PROOF");
+        bool verified;
+        {
+            Metrics::Timer::Scope timing(srp_proof_time);
+            verified = srp->verify_client_proof(proof.A, proof.M1, reply_msg.M2);
+        }
+        if (!verified) {
+            log.warn("[HandlersAuth] CMSG_AUTH_LOGON_PROOF: SRP6 M1 verification failed");
+            account->abort_auth();  // srp дальше недействителен
+            send_auth_failure(std::move(session), AuthErrorCode::WRONG_PASSWORD);
+            return;
+        }
+
+        // освобождает SRP6, srp дальше недействителен; false — аккаунт уже в игре (REJECT_NEW)
+        if (!account->handle_auth_state(*session)) {
+            send_auth_failure(std::move(session), AuthErrorCode::ALREADY_ONLINE);
+            return;
+        }
+        PURITY_LOG_DEBUG("[HandlersAuth] CMSG_AUTH_LOGON_PROOF: SRP6 OK — Sent SMSG_AUTH_LOGON_PROOF");
         session->set_session_mode(SessionMode::WORK_SESSION);
-        session->getAccountInfo()->handle_auth_state();
+        PURITY_LOG_DEBUG("[HandlersAuth] Session memory after login: {} bytes", session->memory_footprint());
 
         AuthPacket reply(AuthOpcodes::SMSG_AUTH_LOGON_PROOF);
-        reply.write_bytes(M2);
+        reply.write(reply_msg);
         PacketUtils::send_packet_as<AuthPacket>(std::move(session), reply);
     }
     catch (const std::exception &ex) {
-        log->error("[HandlersAuth] CMSG_AUTH_LOGON_PROOF exception: {}", ex.what());
-        AuthPacket fail(AuthOpcodes::SMSG_AUTH_RESPONSE);
-        fail.write_uint8(static_cast<uint8_t>(AuthStatusCode::AUTH_FAILED));
-        fail.write_uint8(static_cast<uint8_t>(AuthErrorCode::INTERNAL_ERROR));
-        PacketUtils::send_packet_as<AuthPacket>(std::move(session), fail);
+        log.error("[HandlersAuth] CMSG_AUTH_LOGON_PROOF exception: {}", ex.what());
+        send_auth_failure(std::move(session), AuthErrorCode::INTERNAL_ERROR);
     }
 }
\ No newline at end of file
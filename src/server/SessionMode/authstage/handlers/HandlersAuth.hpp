@@ -2,11 +2,11 @@
 #include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
 
 namespace HandlersAuth {
-    void dispatch(std::shared_ptr<ClientSession> session, AuthPacket &p);
-
+    // Регистрируются в таблице опкодов режима (reader/*SessionTraits.hpp), вызываются фреймером
     void handle_ping(std::shared_ptr<ClientSession> session, AuthPacket &p);
 
-    boost::asio::awaitable<void> handle_logon_challenge(std::shared_ptr<ClientSession> session, AuthPacket &p);
+    // Пакет по значению: co_spawn запускает корутину через post, когда пакет читателя уже уничтожен
+    boost::asio::awaitable<void> handle_logon_challenge(std::shared_ptr<ClientSession> session, AuthPacket p);
 
     void handle_logon_proof(std::shared_ptr<ClientSession> session, AuthPacket &p);
 }
\ No newline at end of file
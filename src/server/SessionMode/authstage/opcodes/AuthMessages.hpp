@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "packet/PacketSchema.hpp"
+#include "AuthOpcodes.hpp"
+
+/**
+ * Payload'ы auth-стадии. Порядок полей в Schema — порядок байт на проводе;
+ * сервер и клиент кодируют их одними и теми же encode/decode.
+ */
+namespace AuthMessages {
+    using namespace PacketSchema;
+
+    constexpr size_t SRP_KEY_SIZE = 32;     // A, B, N, salt
+    constexpr size_t SRP_PROOF_SIZE = 20;   // M1, M2 (SHA1)
+
+    // CMSG_PING / SMSG_PONG
+    struct Ping {
+        uint32_t ping = 0;
+
+        using Schema = Fields<Field<&Ping::ping, u32le>>;
+    };
+
+    // CMSG_AUTH_LOGON_CHALLENGE
+    struct LogonChallenge {
+        std::string username;
+
+        using Schema = Fields<Field<&LogonChallenge::username, cstring_le>>;
+    };
+
+    // SMSG_AUTH_LOGON_CHALLENGE
+    struct LogonChallengeReply {
+        std::array<uint8_t, SRP_KEY_SIZE> B{};
+        uint8_t g = 0;
+        std::array<uint8_t, SRP_KEY_SIZE> N{};
+        std::array<uint8_t, SRP_KEY_SIZE> salt{};
+
+        using Schema = Fields<
+                Field<&LogonChallengeReply::B, Bytes<SRP_KEY_SIZE>>,
+                Field<&LogonChallengeReply::g, u8>,
+                Field<&LogonChallengeReply::N, Bytes<SRP_KEY_SIZE>>,
+                Field<&LogonChallengeReply::salt, Bytes<SRP_KEY_SIZE>>>;
+    };
+
+    // CMSG_AUTH_LOGON_PROOF
+    struct LogonProof {
+        std::array<uint8_t, SRP_KEY_SIZE> A{};
+        std::array<uint8_t, SRP_PROOF_SIZE> M1{};
+
+        using Schema = Fields<
+                Field<&LogonProof::A, Bytes<SRP_KEY_SIZE>>,
+                Field<&LogonProof::M1, Bytes<SRP_PROOF_SIZE>>>;
+    };
+
+    // SMSG_AUTH_LOGON_PROOF
+    struct LogonProofReply {
+        std::array<uint8_t, SRP_PROOF_SIZE> M2{};
+
+        using Schema = Fields<Field<&LogonProofReply::M2, Bytes<SRP_PROOF_SIZE>>>;
+    };
+
+    // SMSG_AUTH_RESPONSE
+    struct AuthResponse {
+        AuthStatusCode status = AuthStatusCode::AUTH_FAILED;
+        AuthErrorCode error = AuthErrorCode::INTERNAL_ERROR;
+
+        using Schema = Fields<
+                Field<&AuthResponse::status, u8>,
+                Field<&AuthResponse::error, u8>>;
+    };
+
+    static_assert(LogonChallengeReply::Schema::FIXED_SIZE == 97);
+    static_assert(LogonProof::Schema::FIXED_SIZE == 52);
+}
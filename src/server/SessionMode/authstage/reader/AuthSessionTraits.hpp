@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "src/server/SessionMode/OpcodeTable.hpp"
+#include "src/server/SessionMode/SessionMode.hpp"
+#include "src/server/SessionMode/authstage/handlers/HandlersAuth.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
+
+// Кадры авторизации: [opcode(uint8)][length(uint16 BE)][payload], см. Framer
+struct AuthSessionTraits {
+    using Opcode = AuthOpcodes;
+    using PacketType = AuthPacket;
+
+    static constexpr SessionMode MODE = SessionMode::AUTH_SESSION;
+    static constexpr size_t OPCODE_SIZE = 1;
+    static constexpr size_t MAX_PAYLOAD = 2048;
+    static constexpr std::string_view NAME = "AuthPacket";
+
+    static constexpr std::array HANDLERS = {
+            OpcodeTable::on<AuthMessages::Ping>(
+                    AuthOpcodes::CMSG_PING, "CMSG_PING", &HandlersAuth::handle_ping),
+            OpcodeTable::on<AuthMessages::LogonChallenge>(
+                    AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE, "CMSG_AUTH_LOGON_CHALLENGE", &HandlersAuth::handle_logon_challenge),
+            OpcodeTable::on<AuthMessages::LogonProof>(
+                    AuthOpcodes::CMSG_AUTH_LOGON_PROOF, "CMSG_AUTH_LOGON_PROOF", &HandlersAuth::handle_logon_proof),
+    };
+
+    static constexpr auto TABLE = OpcodeTable::make<HANDLERS, MODE>();
+};
@@ -2,41 +2,35 @@
 
 #include <utility>
 #include "utils/PacketUtils.hpp"
+#include "utils/utf8utils/UTF8Utils.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkMessages.hpp"
 #include "src/server/SessionMode/workstage/opcodes/WorkPacket.hpp"
 
 using namespace HandlersWork;
 
-void HandlersWork::dispatch(std::shared_ptr<ClientSession> session, WorkPacket &p) {
-    WorkOpcodes opcode = p.get_opcode();
-    switch (opcode) {
-        case WorkOpcodes::CMSG_PING:
-            handle_ping(std::move(session), p);
-            break;
-
-        case WorkOpcodes::CMSG_MESSAGE:
-            handle_message(std::move(session), p);
-            break;
-
-        default:
-            Logger::get()->warn("[HandlersWork] Unknown opcode: {}", static_cast<uint16_t>(opcode));
-            break;
-    }
+namespace {
+    constexpr uint32_t CHAT_LOG_RATE = 50;      // строк чата в секунду на весь сервер
+    constexpr uint32_t CHAT_LOG_BURST = 100;
 }
 
 void HandlersWork::handle_ping(std::shared_ptr<ClientSession> session, WorkPacket &p) {
-    // Считываем ping ID из клиента (4 байта LE)
-    uint32_t ping = p.read_uint32_le();
+    // Ping ID из клиента, PONG возвращает то же самое число
+    auto ping = p.read<WorkMessages::Ping>();
 
-    // Формируем PONG — возвращаем то же самое число
     WorkPacket reply(WorkOpcodes::SMSG_PONG);
-    reply.write_uint32_le(ping);
+    reply.write(ping);
 
-    Logger::get()->trace("[HandlersWork] CMSG_PING");
+    PURITY_LOG_TRACE("[HandlersWork] CMSG_PING {}", ping.ping);
     // Отправляем обратно клиенту
     PacketUtils::send_packet_as<WorkPacket>(std::move(session), reply);
 }
 
 void HandlersWork::handle_message(std::shared_ptr<ClientSession> session, WorkPacket &p) {
-    std::string msg = p.read_string_nt_le();
-    Logger::get()->info("[HandlersWork] CMSG_MESSAGE: {}", msg);
+    auto chat = p.read<WorkMessages::Chat>();
+    if (!UTF8Utils::is_valid_utf8(chat.text)) {
+        PURITY_LOG_RATE(WARN, CHAT_LOG_RATE, CHAT_LOG_BURST,
+                        "[HandlersWork] CMSG_MESSAGE dropped: invalid UTF-8 ({} bytes)", chat.text.size());
+        return;
+    }
+    PURITY_LOG_RATE(INFO, CHAT_LOG_RATE, CHAT_LOG_BURST, "[HandlersWork] CMSG_MESSAGE: {}", chat.text);
 }
\ No newline at end of file
@@ -2,8 +2,7 @@
 #include "src/server/SessionMode/workstage/opcodes/WorkPacket.hpp"
 
 namespace HandlersWork {
-    void dispatch(std::shared_ptr<ClientSession> session, WorkPacket &p);
-
+    // Регистрируются в таблице опкодов режима (reader/*SessionTraits.hpp), вызываются фреймером
     void handle_ping(std::shared_ptr<ClientSession> session, WorkPacket &p);
 
     void handle_message(std::shared_ptr<ClientSession> session, WorkPacket &p);
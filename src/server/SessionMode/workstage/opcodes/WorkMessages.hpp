@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "packet/PacketSchema.hpp"
+
+/**
+ * Payload'ы work-стадии (см. AuthMessages.hpp).
+ */
+namespace WorkMessages {
+    using namespace PacketSchema;
+
+    // CMSG_PING / SMSG_PONG
+    struct Ping {
+        uint32_t ping = 0;
+
+        using Schema = Fields<Field<&Ping::ping, u32le>>;
+    };
+
+    // CMSG_MESSAGE / SMSG_MESSAGE
+    struct Chat {
+        std::string text;
+
+        using Schema = Fields<Field<&Chat::text, cstring_le>>;
+    };
+}
@@ -17,19 +17,21 @@ public:
 
     WorkOpcodes get_opcode() const { return opcode_; }
 
-    std::vector<uint8_t> build_packet() const override {
+    ByteBuffer build_packet() const override {
         ByteBuffer temp;
+        temp.reserve(4 + buffer_.size());
 
         temp.write_uint16_be(static_cast<uint16_t>(opcode_));
         temp.write_uint16_be(static_cast<uint16_t>(buffer_.size()));
-        temp.write_bytes(buffer_.data());
+        temp.write_bytes(buffer_);
 
-        return temp.data();
+        return temp;
     }
 
     // [Opcode(uint16)][Length(uint16)][Payload]
-    void deserialize(const std::vector<uint8_t> &raw_data) override {
-        ByteBuffer temp(raw_data);
+    void deserialize(std::span<const uint8_t> raw_data) override {
+        // Копируем только заголовок, payload переносится в buffer_ одним memcpy
+        ByteBuffer temp(raw_data.data(), std::min<size_t>(raw_data.size(), 4));
 
         opcode_ = static_cast<WorkOpcodes>(temp.read_uint16_be());
         uint16_t length = temp.read_uint16_be();
@@ -39,7 +41,6 @@ public:
         }
 
         buffer_.clear();
-        auto payload = temp.read_bytes(length);
-        buffer_.write_bytes(payload);
+        buffer_.write_bytes(raw_data.data() + temp.read_pos(), length);
     }
 };
@@ -1,8 +0,0 @@
-#include "src/server/ClientSession/ClientSession.hpp"
-#include "src/server/SessionMode/workstage/opcodes/WorkOpcodes.hpp"
-
-namespace ReaderWorkSession {
-
-    void process_read_buffer_as_workserver(std::shared_ptr<ClientSession> session);
-
-}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "src/server/SessionMode/OpcodeTable.hpp"
+#include "src/server/SessionMode/SessionMode.hpp"
+#include "src/server/SessionMode/workstage/handlers/HandlersWork.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkMessages.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkPacket.hpp"
+
+// Кадры work-сессии: [opcode(uint16 BE)][length(uint16 BE)][payload], см. Framer
+struct WorkSessionTraits {
+    using Opcode = WorkOpcodes;
+    using PacketType = WorkPacket;
+
+    static constexpr SessionMode MODE = SessionMode::WORK_SESSION;
+    static constexpr size_t OPCODE_SIZE = 2;
+    static constexpr size_t MAX_PAYLOAD = 2048;
+    static constexpr std::string_view NAME = "WorkPacket";
+
+    static constexpr std::array HANDLERS = {
+            OpcodeTable::on<WorkMessages::Ping>(WorkOpcodes::CMSG_PING, "CMSG_PING", &HandlersWork::handle_ping),
+            OpcodeTable::on<WorkMessages::Chat>(WorkOpcodes::CMSG_MESSAGE, "CMSG_MESSAGE", &HandlersWork::handle_message),
+    };
+
+    static constexpr auto TABLE = OpcodeTable::make<HANDLERS, MODE>();
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "metrics/ThreadSlot.hpp"
+
+/**
+ * Реестр открытых сессий: шардированная slot map со стабильными 64-битными ID.
+ *
+ * add() пишет в шард своего потока (ThreadSlot), remove() — в шард из ID: потоки io_context'а
+ * не делят ни мьютекс, ни кэш-линию, пока не попадут в один шард.
+ * Чтение (find, for_each, snapshot, size) идёт без мьютексов: слоты лежат в чанках,
+ * которые не переезжают и не освобождаются до разрушения реестра.
+ *
+ * ID = [поколение:32][шард:8][индекс:24]. Поколение слота растёт при каждом освобождении,
+ * поэтому ID ушедшей сессии не находит сессию, занявшую её слот позже. 0 — не ID.
+ */
+template<typename Session>
+class SessionRegistry {
+public:
+    static constexpr uint32_t SHARDS = 32;
+    static constexpr uint32_t CHUNK_SIZE = 1024;
+    static constexpr uint32_t MAX_CHUNKS = 1024;       // до 1М сессий на шард
+
+    using Ptr = std::shared_ptr<Session>;
+
+    SessionRegistry() = default;
+
+    ~SessionRegistry() {
+        for (auto &shard : shards_) {
+            for (auto &chunk : shard.chunks) delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    SessionRegistry(const SessionRegistry &) = delete;
+    SessionRegistry &operator=(const SessionRegistry &) = delete;
+
+    uint64_t add(Ptr session) {
+        uint32_t shard_index = ThreadSlot::current() % SHARDS;
+        Shard &shard = shards_[shard_index];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        uint32_t index;
+        if (!shard.free.empty()) {
+            index = shard.free.back();
+            shard.free.pop_back();
+        } else {
+            index = shard.high_water.load(std::memory_order_relaxed);
+            if (index == CHUNK_SIZE * MAX_CHUNKS) throw std::runtime_error("SessionRegistry: shard is full");
+            if (index % CHUNK_SIZE == 0) shard.chunks[index / CHUNK_SIZE].store(new Chunk(), std::memory_order_release);
+        }
+
+        Slot &slot = shard.slot(index);
+        slot.session.store(std::move(session));
+        // Новый индекс виден читателям только после того, как слот заполнен
+        if (index == shard.high_water.load(std::memory_order_relaxed)) {
+            shard.high_water.store(index + 1, std::memory_order_release);
+        }
+
+        shard.active.fetch_add(1, std::memory_order_relaxed);
+        shard.added.fetch_add(1, std::memory_order_relaxed);
+        return make_id(slot.generation.load(std::memory_order_relaxed), shard_index, index);
+    }
+
+    /** false — ID уже удалён (или никогда не выдавался) **/
+    bool remove(uint64_t id) {
+        Shard *shard = shard_of(id);
+        if (!shard) return false;
+
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        Slot *slot = shard->find_slot(index_of(id));
+        if (!slot || slot->generation.load(std::memory_order_relaxed) != generation_of(id)) return false;
+        release(*shard, *slot, index_of(id));
+        return true;
+    }
+
+    /** nullptr, если сессия уже удалена **/
+    Ptr find(uint64_t id) const {
+        const Shard *shard = shard_of(id);
+        if (!shard) return nullptr;
+        const Slot *slot = shard->find_slot(index_of(id));
+        if (!slot) return nullptr;
+
+        // Поколение меняется раньше, чем слот очищается: совпавшее до и после чтения — значит, сессия та
+        uint32_t generation = generation_of(id);
+        if (slot->generation.load() != generation) return nullptr;
+        Ptr session = slot->session.load();
+        if (slot->generation.load() != generation) return nullptr;
+        return session;
+    }
+
+    /** обход без блокировок; сессии, добавленные или удалённые во время обхода, могут попасть или не попасть **/
+    template<typename Fn>
+    void for_each(Fn &&fn) const {
+        for (const auto &shard : shards_) {
+            uint32_t high_water = shard.high_water.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < high_water; ++i) {
+                if (Ptr session = shard.slot(i).session.load()) fn(session);
+            }
+        }
+    }
+
+    std::vector<Ptr> snapshot() const {
+        std::vector<Ptr> sessions;
+        sessions.reserve(size());
+        for_each([&](const Ptr &session) { sessions.push_back(session); });
+        return sessions;
+    }
+
+    /** удаляет все сессии; ID, выданные до этого, становятся недействительными **/
+    void clear() {
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            uint32_t high_water = shard.high_water.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < high_water; ++i) {
+                Slot &slot = shard.slot(i);
+                if (slot.session.load()) release(shard, slot, i);
+            }
+        }
+    }
+
+    size_t size() const {
+        int64_t total = 0;
+        for (const auto &shard : shards_) total += shard.active.load(std::memory_order_relaxed);
+        return total > 0 ? static_cast<size_t>(total) : 0;
+    }
+
+    // Сколько сессий добавлено за всё время
+    uint64_t added() const {
+        uint64_t total = 0;
+        for (const auto &shard : shards_) total += shard.added.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct Slot {
+        std::atomic<Ptr> session;
+        std::atomic<uint32_t> generation{1};
+    };
+
+    struct Chunk {
+        std::array<Slot, CHUNK_SIZE> slots;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;                           // add/remove/clear; чтение идёт без него
+        std::vector<uint32_t> free;
+        std::array<std::atomic<Chunk *>, MAX_CHUNKS> chunks{};
+        std::atomic<uint32_t> high_water{0};        // индексы [0, high_water) уже в выделенных чанках
+        std::atomic<int64_t> active{0};
+        std::atomic<uint64_t> added{0};
+
+        Slot &slot(uint32_t index) const {
+            return chunks[index / CHUNK_SIZE].load(std::memory_order_acquire)->slots[index % CHUNK_SIZE];
+        }
+
+        Slot *find_slot(uint32_t index) const {
+            if (index >= high_water.load(std::memory_order_acquire)) return nullptr;
+            return &slot(index);
+        }
+    };
+
+    static void release(Shard &shard, Slot &slot, uint32_t index) {
+        uint32_t next = slot.generation.load(std::memory_order_relaxed) + 1;
+        slot.generation.store(next == 0 ? 1 : next);
+        slot.session.store(nullptr);
+        shard.free.push_back(index);
+        shard.active.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static uint64_t make_id(uint32_t generation, uint32_t shard, uint32_t index) {
+        return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(shard) << 24) | index;
+    }
+
+    static uint32_t generation_of(uint64_t id) { return static_cast<uint32_t>(id >> 32); }
+
+    static uint32_t index_of(uint64_t id) { return static_cast<uint32_t>(id & 0xFFFFFF); }
+
+    Shard *shard_of(uint64_t id) {
+        uint32_t shard = (id >> 24) & 0xFF;
+        return shard < SHARDS ? &shards_[shard] : nullptr;
+    }
+
+    const Shard *shard_of(uint64_t id) const {
+        uint32_t shard = (id >> 24) & 0xFF;
+        return shard < SHARDS ? &shards_[shard] : nullptr;
+    }
+
+    std::array<Shard, SHARDS> shards_;
+};
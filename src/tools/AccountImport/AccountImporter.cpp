@@ -0,0 +1,150 @@
+#include "AccountImporter.hpp"
+#include "CsvAccountReader.hpp"
+#include "PgBinaryCopy.hpp"
+
+#include "srp6/SRP6.hpp"
+#include "Logger.hpp"
+
+#include <libpq-fe.h>
+#include <openssl/crypto.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct PgConnDeleter {
+        void operator()(PGconn* conn) const { PQfinish(conn); }
+    };
+
+    struct PgResultDeleter {
+        void operator()(PGresult* res) const { PQclear(res); }
+    };
+
+    using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+    using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
+
+    struct Credentials {
+        std::array<uint8_t, SRP6Group::KEY_SIZE> salt;
+        std::array<uint8_t, SRP6Group::KEY_SIZE> verifier;
+    };
+
+    [[noreturn]] void fail(PGconn* conn, const std::string& what) {
+        throw std::runtime_error("[AccountImport] " + what + ": " + PQerrorMessage(conn));
+    }
+
+    // Считает salt/verifier для строк пачки на всех потоках; пароли затираются сразу после использования
+    void compute_credentials(std::vector<CsvAccountRow>& rows, std::vector<Credentials>& out, unsigned threads) {
+        out.resize(rows.size());
+        std::atomic<size_t> next{0};
+
+        auto worker = [&] {
+            SRP6VerifierGenerator generator;
+            for (size_t i = next.fetch_add(1); i < rows.size(); i = next.fetch_add(1)) {
+                auto& row = rows[i];
+                generator.generate(row.username, row.password, out[i].salt.data(), out[i].verifier.data());
+                OPENSSL_cleanse(row.password.data(), row.password.size());
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+    }
+}
+
+AccountImporter::AccountImporter(AccountImportOptions options) : options_(std::move(options)) {
+    if (options_.threads == 0) {
+        options_.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (options_.batch_size == 0) {
+        throw std::invalid_argument("[AccountImport] batch size must be positive");
+    }
+}
+
+AccountImportStats AccountImporter::run() {
+    auto &log = Logger::get();
+
+    std::ifstream file(options_.csv_path);
+    if (!file) throw std::runtime_error("[AccountImport] Cannot open " + options_.csv_path);
+    CsvAccountReader reader(file);
+
+    PgConnPtr conn(PQconnectdb(options_.conninfo.c_str()));
+    if (PQstatus(conn.get()) != CONNECTION_OK) fail(conn.get(), "Connection failed");
+
+    PgResultPtr copy(PQexec(conn.get(), "COPY accounts (username, salt, verifier) FROM STDIN (FORMAT binary)"));
+    if (PQresultStatus(copy.get()) != PGRES_COPY_IN) fail(conn.get(), "COPY start failed");
+
+    log.info("[AccountImport] Importing {} with {} threads, batch {}",
+              options_.csv_path, options_.threads, options_.batch_size);
+
+    const auto started = std::chrono::steady_clock::now();
+    AccountImportStats stats;
+
+    std::vector<CsvAccountRow> rows;
+    std::vector<Credentials> credentials;
+    rows.reserve(options_.batch_size);
+
+    PgBinaryCopyEncoder encoder;
+    encoder.reserve(options_.batch_size * (2 + 3 * 4 + CsvAccountReader::MAX_USERNAME_BYTES + 2 * SRP6Group::KEY_SIZE));
+    encoder.header();
+
+    auto send = [&] {
+        const auto& data = encoder.data();
+        if (PQputCopyData(conn.get(), reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size())) != 1) {
+            fail(conn.get(), "COPY data failed");
+        }
+        encoder.clear();
+    };
+
+    try {
+        CsvAccountRow row;
+        bool eof = false;
+        while (!eof) {
+            rows.clear();
+            while (rows.size() < options_.batch_size) {
+                if (!reader.next(row)) {
+                    eof = true;
+                    break;
+                }
+                rows.push_back(std::move(row));
+            }
+            if (rows.empty()) break;
+
+            compute_credentials(rows, credentials, options_.threads);
+
+            for (size_t i = 0; i < rows.size(); ++i) {
+                encoder.begin_row(3);
+                encoder.field(rows[i].username);
+                encoder.field(credentials[i].salt);
+                encoder.field(credentials[i].verifier);
+            }
+            send();
+
+            stats.rows += rows.size();
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            log.info("[AccountImport] {} rows, {:.0f} rows/s", stats.rows, stats.rows / elapsed);
+        }
+    } catch (const std::exception& e) {
+        // Обрываем COPY, чтобы сервер откатил уже переданные строки
+        PQputCopyEnd(conn.get(), e.what());
+        PgResultPtr(PQgetResult(conn.get()));
+        throw;
+    }
+
+    encoder.trailer();
+    send();
+
+    if (PQputCopyEnd(conn.get(), nullptr) != 1) fail(conn.get(), "COPY end failed");
+    PgResultPtr result(PQgetResult(conn.get()));
+    if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) fail(conn.get(), "COPY failed");
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return stats;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+struct AccountImportOptions {
+    std::string csv_path;
+    std::string conninfo;
+    unsigned threads = 0;       // 0 — по числу ядер
+    size_t batch_size = 8192;   // строк на один параллельный шаг
+};
+
+struct AccountImportStats {
+    size_t rows = 0;
+    double seconds = 0.0;
+
+    double rows_per_second() const { return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0; }
+};
+
+/**
+ * Импорт аккаунтов из CSV: salt/verifier считаются параллельно на всех ядрах,
+ * строки уходят в accounts одним COPY в бинарном формате (всё или ничего).
+ */
+class AccountImporter {
+public:
+    explicit AccountImporter(AccountImportOptions options);
+
+    AccountImportStats run();
+
+private:
+    AccountImportOptions options_;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+#include "utils/utf8utils/UTF8Utils.hpp"
+
+struct CsvAccountRow {
+    std::string username;
+    std::string password;
+};
+
+/**
+ * Построчное чтение CSV вида "username,password".
+ * Поддерживает кавычки ("a,b", "" внутри поля), CRLF и необязательный заголовок username,password.
+ * Имя приводится к верхнему регистру, как при логине (HandlersAuth::handle_logon_challenge): иначе аккаунт не найдётся.
+ * Некорректная строка — исключение с номером строки: импорт идёт одним COPY и откатывается целиком.
+ */
+class CsvAccountReader {
+public:
+    static constexpr size_t MAX_USERNAME_LENGTH = 50;   // VARCHAR(50) в таблице accounts — в символах, не байтах
+    static constexpr size_t MAX_USERNAME_BYTES = MAX_USERNAME_LENGTH * 4;   // до 4 байт UTF-8 на символ
+
+    explicit CsvAccountReader(std::istream& in) : in_(in) {}
+
+    bool next(CsvAccountRow& row) {
+        while (std::getline(in_, line_)) {
+            ++line_number_;
+            if (!line_.empty() && line_.back() == '\r') line_.pop_back();
+            if (line_.empty()) continue;
+
+            parse_line(row);
+
+            if (line_number_ == 1 && row.username == "username" && row.password == "password") {
+                continue;
+            }
+            if (!UTF8Utils::is_valid_utf8(row.username)) fail("username is not valid UTF-8");
+            size_t length = code_points(row.username);
+            if (length == 0 || length > MAX_USERNAME_LENGTH) {
+                fail("username must be 1.." + std::to_string(MAX_USERNAME_LENGTH) + " characters");
+            }
+            UTF8Utils::to_uppercase_inplace(row.username);
+            return true;
+        }
+        return false;
+    }
+
+    size_t line_number() const { return line_number_; }
+
+private:
+    // Для валидного UTF-8: символов столько же, сколько байт, не являющихся продолжением (10xxxxxx)
+    static size_t code_points(const std::string& str) {
+        size_t count = 0;
+        for (unsigned char b : str) count += (b & 0xC0) != 0x80;
+        return count;
+    }
+
+    void parse_line(CsvAccountRow& row) {
+        size_t pos = 0;
+        read_field(pos, row.username);
+        if (pos >= line_.size() || line_[pos] != ',') fail("expected 2 columns");
+        ++pos;
+        read_field(pos, row.password);
+        if (pos != line_.size()) fail("expected 2 columns");
+    }
+
+    void read_field(size_t& pos, std::string& out) {
+        out.clear();
+        if (pos < line_.size() && line_[pos] == '"') {
+            ++pos;
+            while (true) {
+                if (pos >= line_.size()) fail("unterminated quoted field");
+                char c = line_[pos++];
+                if (c == '"') {
+                    if (pos < line_.size() && line_[pos] == '"') {
+                        out.push_back('"');
+                        ++pos;
+                    } else {
+                        return;
+                    }
+                } else {
+                    out.push_back(c);
+                }
+            }
+        }
+
+        size_t end = line_.find(',', pos);
+        if (end == std::string::npos) end = line_.size();
+        out.assign(line_, pos, end - pos);
+        pos = end;
+    }
+
+    [[noreturn]] void fail(const std::string& reason) const {
+        throw std::runtime_error("CSV line " + std::to_string(line_number_) + ": " + reason);
+    }
+
+    std::istream& in_;
+    std::string line_;
+    size_t line_number_ = 0;
+};
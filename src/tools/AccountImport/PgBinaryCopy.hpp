@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * Кодировщик потока COPY ... FROM STDIN (FORMAT binary).
+ * Формат: сигнатура + flags + длина расширения, затем кортежи
+ * (int16 число полей, для каждого поля int32 длина + байты), в конце int16 -1. Все числа — BE.
+ */
+class PgBinaryCopyEncoder {
+public:
+    void header() {
+        static constexpr char signature[] = "PGCOPY\n\377\r\n";    // 11 байт вместе с завершающим \0
+        append(reinterpret_cast<const uint8_t*>(signature), sizeof(signature));
+        put_int32(0);   // flags
+        put_int32(0);   // длина области расширения
+    }
+
+    void begin_row(int16_t field_count) {
+        put_int16(field_count);
+    }
+
+    void field(std::span<const uint8_t> value) {
+        put_int32(static_cast<int32_t>(value.size()));
+        append(value.data(), value.size());
+    }
+
+    void field(std::string_view value) {
+        field({reinterpret_cast<const uint8_t*>(value.data()), value.size()});
+    }
+
+    void trailer() {
+        put_int16(-1);
+    }
+
+    const std::vector<uint8_t>& data() const { return buffer_; }
+    void clear() { buffer_.clear(); }
+    void reserve(size_t bytes) { buffer_.reserve(bytes); }
+
+private:
+    void put_int16(int16_t value) {
+        auto v = static_cast<uint16_t>(value);
+        uint8_t bytes[2] = {static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v)};
+        append(bytes, sizeof(bytes));
+    }
+
+    void put_int32(int32_t value) {
+        auto v = static_cast<uint32_t>(value);
+        uint8_t bytes[4] = {static_cast<uint8_t>(v >> 24), static_cast<uint8_t>(v >> 16),
+                            static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v)};
+        append(bytes, sizeof(bytes));
+    }
+
+    void append(const uint8_t* data, size_t length) {
+        const size_t offset = buffer_.size();
+        buffer_.resize(offset + length);
+        if (length) std::memcpy(buffer_.data() + offset, data, length);
+    }
+
+    std::vector<uint8_t> buffer_;
+};
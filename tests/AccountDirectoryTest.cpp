@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+#include "src/server/AccountDirectory/AccountDirectory.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Policy = AccountDirectory::DuplicateLoginPolicy;
+}
+
+TEST_CASE("AccountDirectory: KICK_OLD displaces the live session", "[account_directory]") {
+    std::set<uint64_t> alive{1, 2};
+    auto is_alive = [&](uint64_t id) { return alive.count(id) > 0; };
+
+    AccountDirectory directory(Policy::KICK_OLD);
+    REQUIRE(directory.claim("ALICE", 1, is_alive).accepted);
+    REQUIRE(directory.find("ALICE") == 1);
+    REQUIRE(directory.find("BOB") == 0);
+
+    auto result = directory.claim("ALICE", 2, is_alive);
+    REQUIRE(result.accepted);
+    REQUIRE(result.displaced == 1);
+    REQUIRE(directory.find("ALICE") == 2);
+
+    // Закрытие вытесненной сессии не снимает запись новой
+    REQUIRE_FALSE(directory.release("ALICE", 1));
+    REQUIRE(directory.find("ALICE") == 2);
+    REQUIRE(directory.size() == 1);
+
+    REQUIRE(directory.release("ALICE", 2));
+    REQUIRE(directory.find("ALICE") == 0);
+    REQUIRE(directory.size() == 0);
+    std::cout << "✅ 'AccountDirectory: KICK_OLD displaces the live session\n";
+}
+
+TEST_CASE("AccountDirectory: REJECT_NEW keeps the live session", "[account_directory]") {
+    std::set<uint64_t> alive{1, 2, 3};
+    auto is_alive = [&](uint64_t id) { return alive.count(id) > 0; };
+
+    AccountDirectory directory(Policy::REJECT_NEW);
+    REQUIRE(directory.claim("ALICE", 1, is_alive).accepted);
+    REQUIRE(directory.claim("ALICE", 1, is_alive).accepted);
+
+    auto result = directory.claim("ALICE", 2, is_alive);
+    REQUIRE_FALSE(result.accepted);
+    REQUIRE(result.displaced == 0);
+    REQUIRE(directory.find("ALICE") == 1);
+
+    // Запись ушедшей сессии не мешает новому входу
+    alive.erase(1);
+    result = directory.claim("ALICE", 3, is_alive);
+    REQUIRE(result.accepted);
+    REQUIRE(result.displaced == 0);
+    REQUIRE(directory.find("ALICE") == 3);
+    REQUIRE(directory.size() == 1);
+    std::cout << "✅ 'AccountDirectory: REJECT_NEW keeps the live session\n";
+}
+
+TEST_CASE("AccountDirectory: concurrent logins to one account", "[account_directory]") {
+    constexpr int THREADS = 8;
+    auto always_alive = [](uint64_t) { return true; };
+
+    AccountDirectory reject(Policy::REJECT_NEW);
+    AccountDirectory kick(Policy::KICK_OLD);
+    std::atomic<int> accepted{0};
+    std::atomic<int> displaced{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            if (reject.claim("SHARED", t + 1, always_alive).accepted) accepted.fetch_add(1);
+            if (kick.claim("SHARED", t + 1, always_alive).displaced) displaced.fetch_add(1);
+            for (int i = 0; i < 1000; ++i) {
+                std::string name = "ACC" + std::to_string(t * 1000 + i);
+                kick.claim(name, i + 1, always_alive);
+                if (i % 2) kick.release(name, i + 1);
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    REQUIRE(accepted.load() == 1);
+    REQUIRE(displaced.load() == THREADS - 1);
+    REQUIRE(kick.find("SHARED") != 0);
+    REQUIRE(kick.size() == 1 + THREADS * 500);
+    REQUIRE(kick.find("ACC0") == 1);
+    REQUIRE(kick.find("ACC1") == 0);
+    std::cout << "✅ 'AccountDirectory: concurrent logins to one account\n";
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+#include "src/tools/AccountImport/CsvAccountReader.hpp"
+#include "src/tools/AccountImport/PgBinaryCopy.hpp"
+#include "srp6/SRP6.hpp"
+
+#include <iostream>
+#include <map>
+#include <sstream>
+
+TEST_CASE("CsvAccountReader: header, quotes and CRLF", "[account_import]") {
+    std::istringstream in("username,password\r\n"
+                          "alice,secret\r\n"
+                          "\n"
+                          "\"bob,jr\",\"pa\"\"ss\"\n"
+                          "carol,\n");
+    CsvAccountReader reader(in);
+    CsvAccountRow row;
+
+    REQUIRE(reader.next(row));
+    REQUIRE(row.username == "ALICE");
+    REQUIRE(row.password == "secret");
+
+    REQUIRE(reader.next(row));
+    REQUIRE(row.username == "BOB,JR");
+    REQUIRE(row.password == "pa\"ss");
+
+    REQUIRE(reader.next(row));
+    REQUIRE(row.username == "CAROL");
+    REQUIRE(row.password.empty());
+
+    REQUIRE_FALSE(reader.next(row));
+
+    std::istringstream bad("alice,secret\nno_password_column\n");
+    CsvAccountReader bad_reader(bad);
+    REQUIRE(bad_reader.next(row));
+    REQUIRE_THROWS_WITH(bad_reader.next(row), Catch::Contains("line 2"));
+    std::cout << "✅ 'CsvAccountReader: header, quotes and CRLF\n";
+}
+
+TEST_CASE("CsvAccountReader: usernames stored the way login looks them up", "[account_import]") {
+    std::istringstream in("alice,secret\n"
+                          "\"Ivan Petrov\",pw\n");
+    CsvAccountReader reader(in);
+    CsvAccountRow row;
+
+    // "Таблица" accounts после импорта: ключ — то, что уйдёт в COPY
+    std::map<std::string, std::string> accounts;
+    while (reader.next(row)) accounts[row.username] = row.password;
+
+    // Логин: имя от клиента в верхний регистр, затем точный поиск (SELECT_ACCOUNT_BY_USERNAME)
+    std::string login = "alice";
+    UTF8Utils::to_uppercase_inplace(login);
+    REQUIRE(accounts.count(login) == 1);
+    REQUIRE(accounts.count("alice") == 0);
+    REQUIRE(accounts.count("IVAN PETROV") == 1);
+
+    std::istringstream bad("alice,secret\n\xC3\x28,pw\n");
+    CsvAccountReader bad_reader(bad);
+    REQUIRE(bad_reader.next(row));
+    REQUIRE_THROWS_WITH(bad_reader.next(row), Catch::Contains("line 2") && Catch::Contains("UTF-8"));
+    std::cout << "✅ 'CsvAccountReader: usernames stored the way login looks them up\n";
+}
+
+TEST_CASE("CsvAccountReader: username length counted in characters", "[account_import]") {
+    // VARCHAR(50) считает символы: 50 кириллических букв — 100 байт, и это допустимое имя
+    std::string cyrillic_50;
+    for (int i = 0; i < 50; ++i) cyrillic_50 += "\xD0\x96";     // Ж
+    std::string ascii_51(51, 'a');
+
+    std::istringstream in(cyrillic_50 + ",pw\n" + ascii_51 + ",pw\n");
+    CsvAccountReader reader(in);
+    CsvAccountRow row;
+
+    REQUIRE(reader.next(row));
+    REQUIRE(row.username == cyrillic_50);
+    REQUIRE(row.username.size() <= CsvAccountReader::MAX_USERNAME_BYTES);
+    REQUIRE_THROWS_WITH(reader.next(row), Catch::Contains("line 2") && Catch::Contains("characters"));
+
+    std::istringstream too_long(cyrillic_50 + "\xD0\x96,pw\n");
+    CsvAccountReader too_long_reader(too_long);
+    REQUIRE_THROWS_WITH(too_long_reader.next(row), Catch::Contains("1..50 characters"));
+    std::cout << "✅ 'CsvAccountReader: username length counted in characters\n";
+}
+
+TEST_CASE("PgBinaryCopyEncoder: header, tuple and trailer layout", "[account_import]") {
+    PgBinaryCopyEncoder encoder;
+    encoder.header();
+    encoder.begin_row(1);
+    encoder.field(std::string_view("ab"));
+    encoder.trailer();
+
+    const std::vector<uint8_t> expected = {
+            'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', 0x00,
+            0, 0, 0, 0,
+            0, 0, 0, 0,
+            0x00, 0x01,
+            0x00, 0x00, 0x00, 0x02, 'a', 'b',
+            0xFF, 0xFF
+    };
+    REQUIRE(encoder.data() == expected);
+    std::cout << "✅ 'PgBinaryCopyEncoder: header, tuple and trailer layout\n";
+}
+
+TEST_CASE("SRP6VerifierGenerator: generated verifier passes the handshake", "[account_import]") {
+    SRP6VerifierGenerator generator;
+    std::vector<uint8_t> salt(SRP6Group::KEY_SIZE);
+    std::vector<uint8_t> verifier(SRP6Group::KEY_SIZE);
+    generator.generate("Alice", "hunter2", salt.data(), verifier.data());
+
+    SRP6 server;
+    server.set_only_username("Alice");
+    server.load_verifier(salt, verifier);
+    server.generate_server_ephemeral();
+
+    SRP6 client;
+    client.load_constants(server.get_N_bytes(), server.get_generator());
+    client.load_salt(server.get_salt_bytes());
+    client.set_credentials("Alice", "hunter2");
+    client.generate_client_ephemeral();
+    auto M1 = client.compute_M1(server.get_B_bytes());
+
+    std::vector<uint8_t> M2;
+    REQUIRE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+    REQUIRE(client.verify_server_proof(M1, M2));
+    std::cout << "✅ 'SRP6VerifierGenerator: generated verifier passes the handshake\n";
+}
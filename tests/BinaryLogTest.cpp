@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+#include "logging/BinaryLog.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace {
+    template<typename... Args>
+    std::string round_trip(const char* format, const Args&... args) {
+        spdlog::memory_buf_t payload;
+        BinaryLog::encode(payload, BinaryLog::format_id(format), args...);
+
+        spdlog::memory_buf_t out;
+        std::string_view data(payload.data(), payload.size());
+        REQUIRE(BinaryLog::format(out, BinaryLog::format_string(BinaryLog::payload_id(data)), data));
+        return {out.data(), out.size()};
+    }
+}
+
+TEST_CASE("BinaryLog: encoded arguments format like fmt::format", "[binarylog]") {
+    const std::string user = "ALICE";
+    REQUIRE(round_trip("[Auth] user {} session {}", user, 42u) == "[Auth] user ALICE session 42");
+    REQUIRE(round_trip("opcode 0x{:04X} size {}", 0x1EDu, int16_t(-5)) == "opcode 0x01ED size -5");
+    REQUIRE(round_trip("{:.2f} {} {} {}", 3.14159, true, 'x', "literal") == "3.14 true x literal");
+    REQUIRE(round_trip("{} {}", std::string_view("view"), uint64_t(18446744073709551615ull)) ==
+            "view 18446744073709551615");
+    REQUIRE(round_trip("no args") == "no args");
+
+    char name[16] = "BOB";
+    const char* missing = nullptr;
+    REQUIRE(round_trip("{} {}", name, missing) == "BOB (null)");
+
+    // Один литерал — один ID
+    REQUIRE(BinaryLog::format_id("no args") == BinaryLog::format_id("no args"));
+
+    STATIC_REQUIRE(BinaryLog::encodable<int, const std::string&, double, const char*>);
+    STATIC_REQUIRE_FALSE(BinaryLog::encodable<int, std::vector<int>>);
+    std::cout << "✅ 'BinaryLog: encoded arguments format like fmt::format\n";
+}
+
+TEST_CASE("BinaryLog: corrupted payloads and bad formats are reported, not thrown", "[binarylog]") {
+    spdlog::memory_buf_t payload;
+    BinaryLog::encode(payload, 7, std::string("truncated string argument"));
+
+    spdlog::memory_buf_t out;
+    REQUIRE_FALSE(BinaryLog::format(out, "{}", std::string_view(payload.data(), payload.size() - 3)));
+    REQUIRE(std::string(out.data(), out.size()).find("corrupted") != std::string::npos);
+
+    out.clear();
+    REQUIRE_FALSE(BinaryLog::format(out, "{} {}", std::string_view(payload.data(), payload.size())));
+    REQUIRE(std::string(out.data(), out.size()).find("format error") != std::string::npos);
+    std::cout << "✅ 'BinaryLog: corrupted payloads and bad formats are reported, not thrown\n";
+}
+
+TEST_CASE("BinaryLog: file writer and reader round-trip with format definitions", "[binarylog]") {
+    std::string path = "binary_log_test.bin";
+    spdlog::memory_buf_t payload;
+    BinaryLog::encode(payload, BinaryLog::format_id("[Server] port {}"), 3724);
+    std::string_view binary(payload.data(), payload.size());
+    const std::string text = "plain text record";
+
+    {
+        BinaryLog::FileWriter writer(path);
+        LogRing::Header header{1000, static_cast<uint32_t>(binary.size()), 1, 2,
+                               static_cast<uint8_t>(LogRecordKind::BINARY)};
+        writer.write(header, 11, binary);
+        writer.write(header, 11, binary);   // формат уже определён — второй раз не пишется
+        header.kind = static_cast<uint8_t>(LogRecordKind::TEXT);
+        header.length = static_cast<uint32_t>(text.size());
+        writer.write(header, 12, text);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    REQUIRE(file != nullptr);
+    BinaryLog::FileReader reader(file);
+    BinaryLog::FileRecord record;
+    std::vector<LogRecordKind> kinds;
+    std::string format;
+    while (reader.next(record)) {
+        auto kind = static_cast<LogRecordKind>(record.header.kind);
+        kinds.push_back(kind);
+        if (kind == LogRecordKind::FORMAT) format = record.payload.substr(sizeof(uint32_t));
+        if (kind == LogRecordKind::BINARY) {
+            REQUIRE(record.header.time_ns == 1000);
+            REQUIRE(record.header.thread_id == 11);
+            spdlog::memory_buf_t out;
+            REQUIRE(BinaryLog::format(out, format, record.payload));
+            REQUIRE(std::string(out.data(), out.size()) == "[Server] port 3724");
+        }
+        if (kind == LogRecordKind::TEXT) REQUIRE(record.payload == text);
+    }
+    std::fclose(file);
+    std::remove(path.c_str());
+
+    REQUIRE(kinds == std::vector<LogRecordKind>{LogRecordKind::FORMAT, LogRecordKind::BINARY,
+                                                LogRecordKind::BINARY, LogRecordKind::TEXT});
+    std::cout << "✅ 'BinaryLog: file writer and reader round-trip with format definitions\n";
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 #include "packet/ByteBuffer.hpp"
 
+#include <array>
+
 TEST_CASE("ByteBuffer integer BE/LE read/write") {
     ByteBuffer buf;
 
@@ -114,3 +116,163 @@ TEST_CASE("ByteBuffer read_bytes") {
     REQUIRE(bytes[2] == 0xCC);
     std::cout << "✅ 'ByteBuffer read_bytes\n";
 }
+
+TEST_CASE("ByteBuffer inline storage and spill to heap") {
+    ByteBuffer buf;
+    for (size_t i = 0; i < ByteBuffer::INLINE_CAPACITY; ++i) buf.write_uint8(static_cast<uint8_t>(i));
+    REQUIRE_FALSE(buf.on_heap());
+    REQUIRE(buf.size() == ByteBuffer::INLINE_CAPACITY);
+
+    buf.write_uint32_be(0xCAFEBABE);
+    REQUIRE(buf.on_heap());
+    REQUIRE(buf.capacity() >= ByteBuffer::INLINE_CAPACITY + 4);
+
+    for (size_t i = 0; i < ByteBuffer::INLINE_CAPACITY; ++i) REQUIRE(buf.read_uint8() == static_cast<uint8_t>(i));
+    REQUIRE(buf.read_uint32_be() == 0xCAFEBABE);
+    REQUIRE_THROWS_AS(buf.read_uint8(), std::out_of_range);
+
+    ByteBuffer reserved;
+    reserved.reserve(1000);
+    REQUIRE(reserved.on_heap());
+    REQUIRE(reserved.capacity() == 1000);
+    std::cout << "✅ 'ByteBuffer inline storage and spill to heap\n";
+}
+
+TEST_CASE("ByteBuffer copy and move keep data and read position") {
+    ByteBuffer small;
+    small.write_uint16_le(0x1234);
+    small.write_string_nt_be("abc");
+    small.read_uint16_le();
+
+    std::vector<uint8_t> big_payload(300, 0x5A);
+    ByteBuffer big;
+    big.write_bytes(big_payload);
+
+    ByteBuffer small_copy(small);
+    REQUIRE(small_copy.read_string_nt_be() == "abc");
+
+    ByteBuffer big_copy;
+    big_copy = big;
+    REQUIRE(big_copy.to_vector() == big_payload);
+    REQUIRE(big.to_vector() == big_payload);
+
+    const uint8_t* heap_data = big.data();
+    ByteBuffer big_moved(std::move(big));
+    REQUIRE(big_moved.data() == heap_data);
+    REQUIRE(big.size() == 0);
+    REQUIRE_FALSE(big.on_heap());
+
+    ByteBuffer small_moved;
+    small_moved = std::move(small);
+    REQUIRE_FALSE(small_moved.on_heap());
+    REQUIRE(small_moved.read_pos() == 2);
+    REQUIRE(small_moved.read_string_nt_be() == "abc");
+    std::cout << "✅ 'ByteBuffer copy and move keep data and read position\n";
+}
+
+TEST_CASE("ByteBuffer NT string without terminator reads to the end") {
+    ByteBuffer buf;
+    buf.write_string_raw_be("tail");
+    REQUIRE(buf.read_string_nt_be() == "tail");
+    REQUIRE(buf.read_pos() == buf.size());
+    REQUIRE(buf.read_string_nt_be().empty());
+
+    ByteBuffer le;
+    le.write_string_nt_le("Hello");
+    le.write_uint8(0x42);
+    REQUIRE(le.read_string_nt_le() == "Hello");
+    REQUIRE(le.read_uint8() == 0x42);
+    std::cout << "✅ 'ByteBuffer NT string without terminator reads to the end\n";
+}
+
+TEST_CASE("ByteBuffer span and string_view reads do not copy") {
+    ByteBuffer buf;
+    buf.write_string_nt_be("hello");
+    buf.write_string_raw_be("raw!");
+    buf.write_uint32_be(0x01020304);
+    buf.write_uint16_be(0xA1B2);
+
+    std::string_view nt = buf.read_string_view_nt();
+    REQUIRE(nt == "hello");
+    REQUIRE(reinterpret_cast<const uint8_t*>(nt.data()) == buf.data());
+
+    REQUIRE(buf.read_string_view_raw(4) == "raw!");
+
+    std::span<const uint8_t> bytes = buf.read_span(4);
+    REQUIRE(bytes.data() == buf.data() + 10);
+    REQUIRE(bytes[0] == 0x01);
+    REQUIRE(bytes[3] == 0x04);
+
+    std::array<uint8_t, 2> out{};
+    buf.read_into(out);
+    REQUIRE(out[0] == 0xA1);
+    REQUIRE(out[1] == 0xB2);
+
+    REQUIRE_THROWS_AS(buf.read_span(1), std::out_of_range);
+    REQUIRE_THROWS_AS(buf.read_into(out), std::out_of_range);
+    REQUIRE(buf.read_pos() == buf.size());
+    std::cout << "✅ 'ByteBuffer span and string_view reads do not copy\n";
+}
+
+TEST_CASE("ByteBuffer bulk arrays match scalar writes on every backend") {
+    std::vector<uint16_t> u16(1001);
+    std::vector<uint32_t> u32(1001);
+    std::vector<uint64_t> u64(1001);
+    std::vector<float> f32(1001);
+    for (size_t i = 0; i < u16.size(); ++i) {
+        u16[i] = static_cast<uint16_t>(i * 0x0101 + 7);
+        u32[i] = static_cast<uint32_t>(i * 0x01020304u + 11);
+        u64[i] = i * 0x0102030405060708ULL + 13;
+        f32[i] = static_cast<float>(i) * 1.5f - 100.0f;
+    }
+
+    ByteBuffer scalar;
+    for (auto v : u16) scalar.write_uint16_be(v);
+    for (auto v : u32) scalar.write_uint32_be(v);
+    for (auto v : u64) scalar.write_uint64_be(v);
+    for (auto v : f32) scalar.write_float_be(v);
+    for (auto v : u32) scalar.write_uint32_le(v);
+
+    ByteBuffer bulk;
+    bulk.write_array_u16_be(u16);
+    bulk.write_array_u32_be(u32);
+    bulk.write_array_u64_be(u64);
+    bulk.write_array_f32_be(f32);
+    bulk.write_array_u32_le(u32);
+    REQUIRE(bulk.to_vector() == scalar.to_vector());
+
+    std::vector<uint16_t> u16_back(u16.size());
+    std::vector<uint32_t> u32_back(u32.size());
+    std::vector<uint64_t> u64_back(u64.size());
+    std::vector<float> f32_back(f32.size());
+    std::vector<uint32_t> u32_le_back(u32.size());
+    bulk.read_array_u16_be(u16_back);
+    bulk.read_array_u32_be(u32_back);
+    bulk.read_array_u64_be(u64_back);
+    bulk.read_array_f32_be(f32_back);
+    bulk.read_array_u32_le(u32_le_back);
+    REQUIRE(u16_back == u16);
+    REQUIRE(u32_back == u32);
+    REQUIRE(u64_back == u64);
+    REQUIRE(f32_back == f32);
+    REQUIRE(u32_le_back == u32);
+    REQUIRE_THROWS_AS(bulk.read_array_u16_be(u16_back), std::out_of_range);
+
+    // Каждый backend и длины с хвостами меньше вектора
+    for (auto backend : {ByteSwap::Backend::SCALAR, ByteSwap::Backend::SSSE3, ByteSwap::Backend::AVX2}) {
+        for (size_t count : {0, 1, 3, 7, 8, 15, 17, 33, 100}) {
+            std::vector<uint8_t> out16(count * 2), out32(count * 4), out64(count * 8);
+            ByteSwap::copy_swap16(out16.data(), u16.data(), count, backend);
+            ByteSwap::copy_swap32(out32.data(), u32.data(), count, backend);
+            ByteSwap::copy_swap64(out64.data(), u64.data(), count, backend);
+            for (size_t i = 0; i < count; ++i) {
+                REQUIRE(out16[i * 2] == static_cast<uint8_t>(u16[i] >> 8));
+                REQUIRE(out32[i * 4] == static_cast<uint8_t>(u32[i] >> 24));
+                REQUIRE(out32[i * 4 + 3] == static_cast<uint8_t>(u32[i]));
+                REQUIRE(out64[i * 8] == static_cast<uint8_t>(u64[i] >> 56));
+                REQUIRE(out64[i * 8 + 7] == static_cast<uint8_t>(u64[i]));
+            }
+        }
+    }
+    std::cout << "✅ 'ByteBuffer bulk arrays match scalar writes on every backend\n";
+}
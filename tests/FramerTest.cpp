@@ -0,0 +1,280 @@
+#include <catch2/catch.hpp>
+#include "packet/FlightRecorder.hpp"
+#include "packet/PacketSchema.hpp"
+#include "packet/RingMessageBuffer.hpp"
+#include "src/server/SessionMode/Framer.hpp"
+#include "src/server/SessionMode/OpcodeTable.hpp"
+#include "src/server/SessionMode/SessionMode.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkPacket.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // Интерфейс ClientSession, который нужен фреймеру
+    struct FakeSession {
+        struct Received {
+            uint16_t opcode;
+            std::vector<uint8_t> payload;
+        };
+
+        boost::asio::io_context io;
+        RingMessageBuffer buffer{64};
+        FlightRecorder<8, 128> recorder;
+        SessionMode mode = SessionMode::AUTH_SESSION;
+        bool closed = false;
+        std::vector<Received> received;
+
+        RingMessageBuffer& read_buffer() { return buffer; }
+        FlightRecorder<8, 128>& flight_recorder() { return recorder; }
+        boost::asio::io_context::executor_type get_executor() { return io.get_executor(); }
+        bool isOpened() const { return !closed; }
+        SessionMode get_session_mode() const { return mode; }
+        void close_with_error(std::string_view) { closed = true; }
+
+        void feed(const std::vector<uint8_t>& bytes) {
+            size_t sent = 0;
+            while (sent < bytes.size()) {
+                buffer.ensure_free_space(bytes.size() - sent);
+                size_t n = std::min(buffer.get_remaining_space(), bytes.size() - sent);
+                std::memcpy(buffer.write_ptr(), bytes.data() + sent, n);
+                buffer.write_completed(n);
+                sent += n;
+            }
+        }
+    };
+
+    // payload без ограничений на размер
+    struct AnyPayload {
+        using Schema = PacketSchema::Fields<>;
+    };
+
+    template<typename Packet>
+    void record(std::shared_ptr<FakeSession> session, Packet& packet) {
+        auto payload = packet.read_span(packet.size());
+        session->received.push_back({static_cast<uint16_t>(packet.get_opcode()), {payload.begin(), payload.end()}});
+    }
+
+    void on_auth_response(std::shared_ptr<FakeSession> session, AuthPacket& packet) {
+        record(session, packet);
+        // Успешный логин: дальше в буфере кадры work-сессии
+        session->mode = SessionMode::WORK_SESSION;
+    }
+
+    boost::asio::awaitable<void> on_challenge_async(std::shared_ptr<FakeSession> session, AuthPacket packet) {
+        record(session, packet);
+        co_return;
+    }
+
+    struct TestAuthTraits {
+        using Opcode = AuthOpcodes;
+        using PacketType = AuthPacket;
+        static constexpr SessionMode MODE = SessionMode::AUTH_SESSION;
+        static constexpr size_t OPCODE_SIZE = 1;
+        static constexpr size_t MAX_PAYLOAD = 16;
+        static constexpr std::string_view NAME = "TestAuth";
+
+        static constexpr std::array HANDLERS = {
+                OpcodeTable::on<AnyPayload>(AuthOpcodes::CMSG_PING, "CMSG_PING", &record<AuthPacket>),
+                OpcodeTable::on<AuthMessages::LogonProof>(AuthOpcodes::CMSG_AUTH_LOGON_PROOF, "CMSG_AUTH_LOGON_PROOF",
+                                                          &record<AuthPacket>),
+                OpcodeTable::on<AnyPayload>(AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE, "CMSG_AUTH_LOGON_CHALLENGE",
+                                            &on_challenge_async),
+                OpcodeTable::on<AnyPayload>(AuthOpcodes::SMSG_AUTH_RESPONSE, "SMSG_AUTH_RESPONSE", &on_auth_response),
+        };
+        static constexpr auto TABLE = OpcodeTable::make<HANDLERS, MODE>();
+    };
+
+    struct TestWorkTraits {
+        using Opcode = WorkOpcodes;
+        using PacketType = WorkPacket;
+        static constexpr SessionMode MODE = SessionMode::WORK_SESSION;
+        static constexpr size_t OPCODE_SIZE = 2;
+        static constexpr size_t MAX_PAYLOAD = 16;
+        static constexpr std::string_view NAME = "TestWork";
+
+        // Опкоды 0..39 для теста границы кольца; 0x0102, 0x0103 — для смены режима
+        static constexpr auto HANDLERS = [] {
+            std::array<OpcodeTable::Registration<WorkOpcodes, FakeSession, WorkPacket>, 42> handlers{};
+            for (uint16_t i = 0; i < 40; ++i) {
+                handlers[i] = OpcodeTable::on<AnyPayload>(static_cast<WorkOpcodes>(i), "TEST", &record<WorkPacket>);
+            }
+            handlers[40] = OpcodeTable::on<AnyPayload>(static_cast<WorkOpcodes>(0x0102), "TEST", &record<WorkPacket>);
+            handlers[41] = OpcodeTable::on<AnyPayload>(static_cast<WorkOpcodes>(0x0103), "TEST", &record<WorkPacket>);
+            return handlers;
+        }();
+        static constexpr auto TABLE = OpcodeTable::make<HANDLERS, MODE>();
+    };
+
+    std::vector<uint8_t> auth_frame(uint8_t opcode, std::vector<uint8_t> payload) {
+        payload.insert(payload.begin(), {opcode, static_cast<uint8_t>(payload.size() >> 8), static_cast<uint8_t>(payload.size())});
+        return payload;
+    }
+
+    std::vector<uint8_t> work_frame(uint16_t opcode, std::vector<uint8_t> payload) {
+        payload.insert(payload.begin(), {static_cast<uint8_t>(opcode >> 8), static_cast<uint8_t>(opcode),
+                                         static_cast<uint8_t>(payload.size() >> 8), static_cast<uint8_t>(payload.size())});
+        return payload;
+    }
+
+    std::vector<uint8_t> concat(std::initializer_list<std::vector<uint8_t>> parts) {
+        std::vector<uint8_t> out;
+        for (const auto& p : parts) out.insert(out.end(), p.begin(), p.end());
+        return out;
+    }
+}
+
+TEST_CASE("Framer: header decoding is constexpr", "[framer]") {
+    constexpr uint8_t auth_header[] = {0x01, 0x00, 0x04};
+    constexpr uint8_t work_header[] = {0x12, 0x34, 0x01, 0x02};
+
+    static_assert(Framer<TestAuthTraits>::HEADER_SIZE == 3);
+    static_assert(Framer<TestWorkTraits>::HEADER_SIZE == 4);
+    static_assert(Framer<TestAuthTraits>::opcode(auth_header) == AuthOpcodes::CMSG_PING);
+    static_assert(Framer<TestAuthTraits>::payload_size(auth_header) == 4);
+    static_assert(static_cast<uint16_t>(Framer<TestWorkTraits>::opcode(work_header)) == 0x1234);
+    static_assert(Framer<TestWorkTraits>::payload_size(work_header) == 0x0102);
+    std::cout << "✅ 'Framer: header decoding is constexpr\n";
+}
+
+TEST_CASE("Framer: every complete frame of a batch is dispatched", "[framer]") {
+    auto session = std::make_shared<FakeSession>();
+    session->feed(concat({auth_frame(0x01, {1, 0, 0, 0}), auth_frame(0x01, {2, 0, 0, 0}), auth_frame(0x01, {3, 0, 0, 0}),
+                          auth_frame(0x01, {4})}));
+    session->feed({0x01, 0x00});                // начало следующего заголовка
+
+    REQUIRE(Framer<TestAuthTraits>::process(session) == 4);
+    REQUIRE(session->received.size() == 4);
+    REQUIRE(session->received[2].payload == std::vector<uint8_t>{3, 0, 0, 0});
+    REQUIRE(session->received[3].payload == std::vector<uint8_t>{4});
+    REQUIRE(session->buffer.get_active_size() == 2);
+
+    // Хвост дошёл — кадр собирается из двух приходов
+    session->feed({0x02, 7, 8});
+    REQUIRE(Framer<TestAuthTraits>::process(session) == 1);
+    REQUIRE(session->received.back().payload == std::vector<uint8_t>{7, 8});
+    REQUIRE(session->buffer.get_active_size() == 0);
+    REQUIRE_FALSE(session->closed);
+    std::cout << "✅ 'Framer: every complete frame of a batch is dispatched\n";
+}
+
+TEST_CASE("Framer: oversized payload closes the session before it arrives", "[framer]") {
+    auto session = std::make_shared<FakeSession>();
+    session->feed({0x12, 0x34, 0x00, 0x11});    // заявлено 17 байт при пределе 16, payload ещё не пришёл
+    session->mode = SessionMode::WORK_SESSION;
+
+    REQUIRE(Framer<TestWorkTraits>::process(session) == 0);
+    REQUIRE(session->closed);
+    REQUIRE(session->recorder.recorded() == 1);
+    std::cout << "✅ 'Framer: oversized payload closes the session before it arrives\n";
+}
+
+TEST_CASE("Framer: mode switch leaves the rest to the next framer", "[framer]") {
+    auto session = std::make_shared<FakeSession>();
+    session->feed(concat({auth_frame(static_cast<uint8_t>(AuthOpcodes::SMSG_AUTH_RESPONSE), {0, 0}),
+                          work_frame(0x0102, {9, 9, 9}), work_frame(0x0103, {})}));
+
+    REQUIRE(Framer<TestAuthTraits>::process(session) == 1);
+    REQUIRE(session->mode == SessionMode::WORK_SESSION);
+    REQUIRE(Framer<TestAuthTraits>::process(session) == 0);
+
+    REQUIRE(Framer<TestWorkTraits>::process(session) == 2);
+    REQUIRE(session->received[1].opcode == 0x0102);
+    REQUIRE(session->received[1].payload == std::vector<uint8_t>{9, 9, 9});
+    REQUIRE(session->received[2].opcode == 0x0103);
+    REQUIRE(session->received[2].payload.empty());
+    std::cout << "✅ 'Framer: mode switch leaves the rest to the next framer\n";
+}
+
+TEST_CASE("Framer: frames straddling the ring boundary", "[framer]") {
+    auto session = std::make_shared<FakeSession>();
+    session->mode = SessionMode::WORK_SESSION;
+
+    // Сдвигаем позицию кольца так, чтобы кадры переходили через его конец
+    std::vector<uint8_t> stream;
+    for (uint16_t i = 0; i < 40; ++i) {
+        auto frame = work_frame(i, std::vector<uint8_t>(i % 17, static_cast<uint8_t>(i)));
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    size_t sent = 0;
+    while (sent < stream.size()) {
+        size_t n = std::min<size_t>(23, stream.size() - sent);
+        session->feed({stream.begin() + static_cast<long>(sent), stream.begin() + static_cast<long>(sent + n)});
+        sent += n;
+        Framer<TestWorkTraits>::process(session);
+    }
+
+    REQUIRE(session->received.size() == 40);
+    for (uint16_t i = 0; i < 40; ++i) {
+        REQUIRE(session->received[i].opcode == i);
+        REQUIRE(session->received[i].payload == std::vector<uint8_t>(i % 17, static_cast<uint8_t>(i)));
+    }
+    REQUIRE(session->buffer.capacity() > 64);      // кадры через конец кольца собирались в scratch-буфере peek()
+    std::cout << "✅ 'Framer: frames straddling the ring boundary\n";
+}
+
+TEST_CASE("Framer: opcode table is dense and checked before parsing", "[framer]") {
+    using AuthDispatcher = OpcodeTable::Dispatcher<TestAuthTraits>;
+    using WorkDispatcher = OpcodeTable::Dispatcher<TestWorkTraits>;
+
+    static_assert(TestAuthTraits::TABLE.size() == static_cast<size_t>(AuthOpcodes::SMSG_AUTH_RESPONSE) + 1);
+    static_assert(TestAuthTraits::TABLE[static_cast<size_t>(AuthOpcodes::CMSG_AUTH_LOGON_PROOF)].min_payload == 52);
+    static_assert(AuthDispatcher::find(AuthOpcodes::SMSG_PONG, SessionMode::AUTH_SESSION) == nullptr);
+    static_assert(AuthDispatcher::find(AuthOpcodes::CMSG_PING, SessionMode::WORK_SESSION) == nullptr);
+    static_assert(AuthDispatcher::find(AuthOpcodes::CMSG_PING, SessionMode::AUTH_SESSION)->kind ==
+                  OpcodeTable::HandlerKind::INLINE);
+
+    // Незнакомый опкод пропускается целиком, не доходя до пакета; следующий кадр разбирается
+    auto session = std::make_shared<FakeSession>();
+    session->mode = SessionMode::WORK_SESSION;
+    uint64_t unknown_before = WorkDispatcher::unknown();
+    session->feed(concat({work_frame(0x0200, {1, 2, 3}), work_frame(0x0005, {5})}));
+
+    REQUIRE(Framer<TestWorkTraits>::process(session) == 2);
+    REQUIRE(WorkDispatcher::unknown() == unknown_before + 1);
+    REQUIRE(session->received.size() == 1);
+    REQUIRE(session->received[0].opcode == 5);
+    REQUIRE_FALSE(session->closed);
+
+    // Короче схемы сообщения — сессия закрывается по заголовку, payload не ждём
+    auto short_session = std::make_shared<FakeSession>();
+    uint64_t rejected_before = AuthDispatcher::stats(AuthOpcodes::CMSG_AUTH_LOGON_PROOF).rejected;
+    short_session->feed({static_cast<uint8_t>(AuthOpcodes::CMSG_AUTH_LOGON_PROOF), 0x00, 0x0A});
+
+    REQUIRE(Framer<TestAuthTraits>::process(short_session) == 0);
+    REQUIRE(short_session->closed);
+    REQUIRE(AuthDispatcher::stats(AuthOpcodes::CMSG_AUTH_LOGON_PROOF).rejected == rejected_before + 1);
+    std::cout << "✅ 'Framer: opcode table is dense and checked before parsing\n";
+}
+
+TEST_CASE("Framer: coroutine handlers run on the session executor and are counted", "[framer]") {
+    using AuthDispatcher = OpcodeTable::Dispatcher<TestAuthTraits>;
+    auto before = AuthDispatcher::stats(AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE);
+    const auto& entry = *AuthDispatcher::find(AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE, SessionMode::AUTH_SESSION);
+    uint64_t timed_before = AuthDispatcher::latency(entry).count;
+
+    auto session = std::make_shared<FakeSession>();
+    session->feed(auth_frame(static_cast<uint8_t>(AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE), {'A', 'B', 0}));
+
+    REQUIRE(Framer<TestAuthTraits>::process(session) == 1);
+    auto after = AuthDispatcher::stats(AuthOpcodes::CMSG_AUTH_LOGON_CHALLENGE);
+    REQUIRE(after.packets == before.packets + 1);
+    REQUIRE(after.bytes == before.bytes + 3);
+    REQUIRE(session->received.empty());           // корутина только запланирована
+    REQUIRE(AuthDispatcher::latency(entry).count == timed_before);
+
+    session->io.run();
+    REQUIRE(session->received.size() == 1);
+    REQUIRE(AuthDispatcher::latency(entry).count == timed_before + 1);   // время — до завершения корутины
+    REQUIRE(session->received[0].payload == std::vector<uint8_t>{'A', 'B', 0});
+    std::cout << "✅ 'Framer: coroutine handlers run on the session executor and are counted\n";
+}
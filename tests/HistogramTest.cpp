@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+#include "metrics/CycleClock.hpp"
+#include "metrics/Histogram.hpp"
+#include "metrics/ThreadSlot.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Histogram: log-linear buckets keep 1/16 relative error", "[histogram]") {
+    static_assert(Histogram::bucket_of(0) == 0);
+    static_assert(Histogram::bucket_of(15) == 15);
+    static_assert(Histogram::bucket_of(16) == 16);
+    static_assert(Histogram::bucket_of(31) == 31);
+    static_assert(Histogram::bucket_of(32) == 32 && Histogram::bucket_of(33) == 32);
+    static_assert(Histogram::bucket_of(UINT64_MAX) == Histogram::BUCKETS - 1);
+
+    for (uint32_t b = 0; b + 1 < Histogram::BUCKETS; ++b) {
+        uint64_t lo = Histogram::lower_bound(b);
+        uint64_t hi = Histogram::upper_bound(b);
+        REQUIRE(Histogram::bucket_of(lo) == b);
+        REQUIRE(Histogram::bucket_of(hi) == b);
+        REQUIRE(Histogram::lower_bound(b + 1) == hi + 1);
+        REQUIRE((hi - lo) * Histogram::SUB_COUNT <= lo);
+    }
+
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = rng() >> (rng() % 40 + 24);
+        uint32_t b = Histogram::bucket_of(v);
+        REQUIRE(Histogram::lower_bound(b) <= v);
+        REQUIRE(v <= Histogram::upper_bound(b));
+    }
+    std::cout << "✅ 'Histogram: log-linear buckets keep 1/16 relative error\n";
+}
+
+TEST_CASE("Histogram: percentiles of a known distribution", "[histogram]") {
+    HistogramSet set(2);
+    for (uint64_t v = 1; v <= 10000; ++v) set.record(1, v);
+    set.record(0, 5);
+
+    auto snapshot = set.snapshot(1);
+    REQUIRE(snapshot.count == 10000);
+    REQUIRE(snapshot.sum == 10000 * 10001 / 2);
+    REQUIRE(snapshot.mean() == 5000);
+
+    // Верхняя граница корзины: не меньше точного квантиля и не больше чем на 1/16 выше
+    for (double q : {0.5, 0.9, 0.99, 0.999}) {
+        auto exact = static_cast<uint64_t>(q * 10000);
+        uint64_t p = snapshot.percentile(q);
+        REQUIRE(p >= exact);
+        REQUIRE(p <= exact + exact / 16);
+    }
+    REQUIRE(set.snapshot(0).percentile(0.5) == 5);
+    REQUIRE(HistogramSet(1).snapshot(0).percentile(0.99) == 0);
+
+    auto summary = Histogram::summarize(snapshot, 2.0);
+    REQUIRE(summary.count == 10000);
+    REQUIRE(summary.p50 == 2 * snapshot.percentile(0.5));
+    std::cout << "✅ 'Histogram: percentiles of a known distribution\n";
+}
+
+TEST_CASE("Histogram: per-thread shards merge on snapshot", "[histogram]") {
+    HistogramSet set(3, 2);
+    constexpr int THREADS = 8;
+    constexpr int PER_THREAD = 20000;
+
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> slots(THREADS);
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            slots[t] = ThreadSlot::current();
+            for (int i = 0; i < PER_THREAD; ++i) {
+                set.record(static_cast<size_t>(i % 3), static_cast<uint64_t>(t + 1));
+                set.add(static_cast<size_t>(i % 3), 1, 10);
+            }
+        });
+    }
+    // Снимки параллельно с записью не должны ни падать, ни терять уже записанное
+    uint64_t last = 0;
+    for (int i = 0; i < 50; ++i) {
+        uint64_t now = set.snapshot(0).count;
+        REQUIRE(now >= last);
+        last = now;
+    }
+    for (auto& t : threads) t.join();
+
+    Histogram::Snapshot total;
+    for (size_t i = 0; i < set.size(); ++i) total.merge(set.snapshot(i));
+    REQUIRE(total.count == THREADS * PER_THREAD);
+    REQUIRE(total.sum == static_cast<uint64_t>(PER_THREAD) * THREADS * (THREADS + 1) / 2);
+    REQUIRE(total.buckets[1] == PER_THREAD);
+
+    // Счётчики рядом с гистограммой суммируются так же и в гистограмму не попадают
+    uint64_t counted = 0;
+    for (size_t i = 0; i < set.size(); ++i) {
+        REQUIRE(set.counter(i, 0) == 0);
+        counted += set.counter(i, 1);
+    }
+    REQUIRE(counted == 10ULL * THREADS * PER_THREAD);
+    for (uint32_t slot : slots) REQUIRE(slot < ThreadSlot::MAX_THREADS);
+
+    // Номер завершившегося потока достаётся следующему
+    uint32_t reused = ThreadSlot::SHARED;
+    std::thread([&] { reused = ThreadSlot::current(); }).join();
+    REQUIRE(reused < ThreadSlot::MAX_THREADS);
+    std::cout << "✅ 'Histogram: per-thread shards merge on snapshot\n";
+}
+
+TEST_CASE("CycleClock: ticks convert to wall time", "[histogram]") {
+    uint64_t start = CycleClock::now();
+    auto wall_start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t ticks = CycleClock::now() - start;
+    auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall_start).count();
+
+    auto ns = static_cast<double>(CycleClock::to_ns(ticks));
+    REQUIRE(ns > wall_ns * 0.9);
+    REQUIRE(ns < wall_ns * 1.1);
+    std::cout << "✅ 'CycleClock: ticks convert to wall time\n";
+}
@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include "logging/LogRing.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    std::string make_payload(uint64_t seq, size_t length) {
+        std::string s(length, static_cast<char>('a' + seq % 26));
+        std::string tag = std::to_string(seq) + ":";
+        s.replace(0, std::min(tag.size(), length), tag.substr(0, length));
+        return s;
+    }
+}
+
+TEST_CASE("LogRing: records keep order and content across wrap-around", "[logring]") {
+    LogRing ring(16, LogRing::OverflowPolicy::DROP, 1);
+    LogRing::Record record;
+
+    for (uint64_t seq = 0; seq < 200; ++seq) {
+        // 1..4 слота на запись, чтобы регулярно пересекать границу кольца
+        std::string payload = make_payload(seq, (seq * 37) % (LogRing::SLOT_SIZE * 4 - LogRing::HEADER_SIZE));
+        REQUIRE(ring.push(static_cast<int64_t>(seq), 2, 0, payload));
+        REQUIRE(ring.pop(record));
+        REQUIRE(record.header.time_ns == static_cast<int64_t>(seq));
+        REQUIRE(record.text() == payload);
+    }
+    REQUIRE_FALSE(ring.pop(record));
+    REQUIRE(ring.dropped() == 0);
+    std::cout << "✅ 'LogRing: records keep order and content across wrap-around\n";
+}
+
+TEST_CASE("LogRing: DROP rejects new records, OVERRUN evicts the oldest", "[logring]") {
+    LogRing::Record record;
+    const std::string payload(LogRing::SLOT_SIZE - LogRing::HEADER_SIZE, 'x');   // ровно один слот
+
+    LogRing drop(8, LogRing::OverflowPolicy::DROP, 1);
+    for (int i = 0; i < 10; ++i) drop.push(i, 2, 0, payload);
+    REQUIRE(drop.dropped() == 2);
+    REQUIRE(drop.pop(record));
+    REQUIRE(record.header.time_ns == 0);
+
+    LogRing overrun(8, LogRing::OverflowPolicy::OVERRUN, 1);
+    for (int i = 0; i < 10; ++i) REQUIRE(overrun.push(i, 2, 0, payload));
+    REQUIRE(overrun.dropped() == 2);
+    REQUIRE(overrun.pop(record));
+    REQUIRE(record.header.time_ns == 2);
+
+    // Слишком длинный payload обрезается до половины кольца
+    LogRing small(8, LogRing::OverflowPolicy::DROP, 1);
+    REQUIRE(small.push(0, 2, 0, std::string(10000, 'y')));
+    REQUIRE(small.pop(record));
+    REQUIRE(record.header.length == small.max_payload());
+    std::cout << "✅ 'LogRing: DROP rejects new records, OVERRUN evicts the oldest\n";
+}
+
+TEST_CASE("LogRing: largest record fits a ring requested above MAX_SLOTS", "[logring]") {
+    LogRing ring(131072, LogRing::OverflowPolicy::DROP, 1);
+    REQUIRE(ring.capacity() == LogRing::MAX_SLOTS);
+
+    LogRing::Record record;
+    for (uint64_t seq = 0; seq < 3; ++seq) {
+        std::string payload = make_payload(seq, ring.max_payload());
+        REQUIRE(ring.push(static_cast<int64_t>(seq), 2, 0, payload));
+        REQUIRE(ring.pop(record));
+        REQUIRE(record.header.time_ns == static_cast<int64_t>(seq));
+        REQUIRE(record.header.slots == LogRing::MAX_SLOTS / 2);
+        REQUIRE(record.text() == payload);
+    }
+    REQUIRE_FALSE(ring.pop(record));
+    REQUIRE(ring.dropped() == 0);
+    std::cout << "✅ 'LogRing: largest record fits a ring requested above MAX_SLOTS\n";
+}
+
+TEST_CASE("LogRing: concurrent producer and consumer never see torn records", "[logring]") {
+    for (auto policy : {LogRing::OverflowPolicy::DROP, LogRing::OverflowPolicy::OVERRUN}) {
+        LogRing ring(64, policy, 1);
+        constexpr uint64_t COUNT = 200000;
+        std::atomic<bool> done{false};
+
+        std::thread producer([&] {
+            for (uint64_t seq = 0; seq < COUNT; ++seq) {
+                ring.push(static_cast<int64_t>(seq), 2, 0, make_payload(seq, seq % 300));
+            }
+            done = true;
+        });
+
+        LogRing::Record record;
+        uint64_t received = 0;
+        int64_t last = -1;
+        bool ok = true;
+        while (!done || !ring.empty()) {
+            while (ring.pop(record)) {
+                auto seq = static_cast<uint64_t>(record.header.time_ns);
+                ok = ok && record.header.time_ns > last && record.text() == make_payload(seq, seq % 300);
+                last = record.header.time_ns;
+                ++received;
+            }
+        }
+        producer.join();
+
+        REQUIRE(ok);
+        REQUIRE(received + ring.dropped() == COUNT);
+    }
+    std::cout << "✅ 'LogRing: concurrent producer and consumer never see torn records\n";
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch.hpp>
+#include "Logger.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+    struct CountedArg {
+        static inline int formatted = 0;
+    };
+}
+
+template<>
+struct fmt::formatter<CountedArg> : fmt::formatter<std::string_view> {
+    auto format(const CountedArg&, fmt::format_context& ctx) const {
+        ++CountedArg::formatted;
+        return fmt::formatter<std::string_view>::format("counted", ctx);
+    }
+};
+
+TEST_CASE("Logger: escape_to escapes quotes, backslashes and control bytes", "[logger]") {
+    spdlog::memory_buf_t buf;
+    Logger::escape_to(buf, std::string_view("say \"hi\" \\ bye\nline\t\x01\x1f end\xd0\x9f", 28));
+    REQUIRE(std::string(buf.data(), buf.size()) == "say \\\"hi\\\" \\\\ bye\\nline\\t\\u0001\\u001f end\xd0\x9f");
+    std::cout << "✅ 'Logger: escape_to escapes quotes, backslashes and control bytes\n";
+}
+
+TEST_CASE("Logger: escape_to matches byte-by-byte reference at every offset", "[logger]") {
+    auto reference = [](std::string_view s) {
+        std::string out;
+        for (unsigned char c : s) {
+            if (c == '"') out += "\\\"";
+            else if (c == '\\') out += "\\\\";
+            else if (c == '\n') out += "\\n";
+            else if (c == '\r') out += "\\r";
+            else if (c == '\t') out += "\\t";
+            else if (c == '\b') out += "\\b";
+            else if (c == '\f') out += "\\f";
+            else if (c < 0x20) out += fmt::format("\\u{:04x}", c);
+            else out += static_cast<char>(c);
+        }
+        return out;
+    };
+
+    // Спецсимвол в каждой позиции строки длиннее нескольких SIMD-блоков
+    for (unsigned char special : {'"', '\\', '\n', '\x00', '\x1f'}) {
+        for (size_t pos = 0; pos < 70; ++pos) {
+            std::string s(70, 'a');
+            s[pos] = static_cast<char>(special);
+            s[69 - pos / 2] = static_cast<char>(0xC0 + pos % 32);     // байты >= 0x80 не экранируются
+
+            spdlog::memory_buf_t buf;
+            Logger::escape_to(buf, s);
+            REQUIRE(std::string(buf.data(), buf.size()) == reference(s));
+        }
+    }
+    std::cout << "✅ 'Logger: escape_to matches byte-by-byte reference at every offset\n";
+}
+
+TEST_CASE("Logger: MDC encodes inline pairs and replaces duplicate keys", "[logger]") {
+    MDC mdc;
+    REQUIRE(mdc.put("opcode", "0x01"));
+    REQUIRE(mdc.put("user", "a\"b"));
+    REQUIRE(mdc.put("opcode", "0x02"));
+    REQUIRE(mdc.data().size() == 2);
+
+    spdlog::memory_buf_t buf;
+    Logger::encode_mdc(buf, "hello\n", mdc);
+    REQUIRE(std::string(buf.data(), buf.size()) ==
+            "\"message\":\"hello\\n\",\"mdc\":{\"opcode\":\"0x02\",\"user\":\"a\\\"b\"}");
+
+    static const char* keys[] = {"k2", "k3", "k4", "k5", "k6", "k7"};
+    for (const char* key : keys) REQUIRE(mdc.put(key, "v"));
+    REQUIRE_FALSE(mdc.put("overflow", "v"));
+    std::cout << "✅ 'Logger: MDC encodes inline pairs and replaces duplicate keys\n";
+}
+
+TEST_CASE("Logger: disabled levels skip argument formatting", "[logger]") {
+    auto& log = Logger::get();
+    log.set_level(spdlog::level::info);
+
+    CountedArg::formatted = 0;
+    log.debug("value {}", CountedArg{});
+    REQUIRE_FALSE(log.should_log(spdlog::level::debug));
+    REQUIRE(CountedArg::formatted == 0);
+
+    log.info("value {}", CountedArg{});
+    REQUIRE(CountedArg::formatted == 1);
+    std::cout << "✅ 'Logger: disabled levels skip argument formatting\n";
+}
+
+TEST_CASE("Logger: PURITY_LOG_* macros do not evaluate arguments of disabled levels", "[logger]") {
+    Logger::get().set_level(spdlog::level::info);
+
+    int evaluated = 0;
+    auto touch = [&evaluated] { return ++evaluated; };
+
+    PURITY_LOG_TRACE("trace {}", touch());
+    PURITY_LOG_DEBUG("debug {}", touch());
+    REQUIRE(evaluated == 0);
+
+#if PURITY_LOG_LEVEL <= PURITY_LOG_LEVEL_INFO
+    PURITY_LOG_INFO("info {}", touch());
+    REQUIRE(evaluated == 1);
+#endif
+    std::cout << "✅ 'Logger: PURITY_LOG_* macros do not evaluate arguments of disabled levels\n";
+}
+
+TEST_CASE("Logger: rate limiter passes a burst, then the configured rate", "[logger]") {
+    LogRateLimiter limiter(__FILE__, __LINE__, 10, 3);      // 100 мс на запись, пачка 3
+    const int64_t ms = 1'000'000;
+    int64_t now = 1'000 * ms;
+
+    int passed = 0;
+    for (int i = 0; i < 10; ++i) passed += limiter.allow(now);
+    REQUIRE(passed == 3);
+    REQUIRE(limiter.suppression().pending() == 7);
+
+    REQUIRE_FALSE(limiter.allow(now + 50 * ms));
+    REQUIRE(limiter.allow(now + 100 * ms));
+    REQUIRE_FALSE(limiter.allow(now + 150 * ms));
+
+    // После паузы пачка восстанавливается
+    passed = 0;
+    for (int i = 0; i < 10; ++i) passed += limiter.allow(now + 10'000 * ms);
+    REQUIRE(passed == 3);
+    std::cout << "✅ 'Logger: rate limiter passes a burst, then the configured rate\n";
+}
+
+TEST_CASE("Logger: sampler passes the first and every N-th record", "[logger]") {
+    LogSampler sampler(__FILE__, __LINE__, 4);
+    std::vector<int> passed;
+    for (int i = 0; i < 10; ++i) {
+        if (sampler.allow()) passed.push_back(i);
+    }
+    REQUIRE(passed == std::vector<int>{0, 4, 8});
+
+    // collect забирает счётчик ровно один раз
+    uint64_t collected = 0;
+    auto take = [&](const LogSuppression& site, uint64_t count) {
+        if (&site == &sampler.suppression()) collected += count;
+    };
+    LogSuppression::collect(take);
+    REQUIRE(collected == 7);
+    LogSuppression::collect(take);
+    REQUIRE(collected == 7);
+    std::cout << "✅ 'Logger: sampler passes the first and every N-th record\n";
+}
+
+TEST_CASE("Logger: rate-limited macros skip formatting of suppressed records", "[logger]") {
+    Logger::get().set_level(spdlog::level::info);
+
+    int evaluated = 0;
+    auto touch = [&evaluated] { return ++evaluated; };
+
+    for (int i = 0; i < 10; ++i) {
+        PURITY_LOG_EVERY_N(WARN, 5, "sampled {}", touch());
+        PURITY_LOG_RATE(WARN, 1, 2, "limited {}", touch());
+        PURITY_LOG_EVERY_N(DEBUG, 1, "disabled {}", touch());
+    }
+    REQUIRE(evaluated == 2 + 2);
+    std::cout << "✅ 'Logger: rate-limited macros skip formatting of suppressed records\n";
+}
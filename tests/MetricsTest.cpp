@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+#include "metrics/Metrics.hpp"
+#include "metrics/MetricsEndpoint.hpp"
+
+#include <boost/asio.hpp>
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::string http_get(uint16_t port, const std::string& path) {
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::socket socket(io);
+        socket.connect({boost::asio::ip::address_v4::loopback(), port});
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        boost::asio::write(socket, boost::asio::buffer(request));
+
+        std::string response;
+        boost::system::error_code ec;
+        boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+        return response;
+    }
+}
+
+TEST_CASE("Metrics: per-thread counters and gauges sum on read", "[metrics]") {
+    auto& registry = Metrics::Registry::instance();
+    auto& counter = registry.counter("test_metrics_events_total", "Test events");
+    auto& gauge = registry.gauge("test_metrics_in_flight", "Test gauge", "kind=\"a\"");
+    REQUIRE(&counter == &registry.counter("test_metrics_events_total", "Test events"));
+    REQUIRE(&gauge != &registry.gauge("test_metrics_in_flight", "Test gauge", "kind=\"b\""));
+    REQUIRE_THROWS_AS(registry.gauge("test_metrics_events_total", "Wrong type"), std::logic_error);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                counter.add(2);
+                gauge.add();
+            }
+            for (int i = 0; i < 9000; ++i) gauge.sub();
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    REQUIRE(counter.value() == 8 * 10000 * 2);
+    REQUIRE(gauge.value() == 8 * 1000);
+    gauge.sub(8 * 1000 + 5);
+    REQUIRE(gauge.value() == -5);
+    std::cout << "✅ 'Metrics: per-thread counters and gauges sum on read\n";
+}
+
+TEST_CASE("Metrics: Prometheus text format", "[metrics]") {
+    auto& registry = Metrics::Registry::instance();
+    registry.counter("test_render_requests_total", "Requests", "route=\"login\"").add(3);
+    registry.counter("test_render_requests_total", "Requests", "route=\"chat\"").add(4);
+    registry.callback("test_render_callback", "From elsewhere", Metrics::Type::GAUGE, [] { return 1.5; });
+    auto& timer = registry.timer("test_render_seconds", "Durations", "step=\"x\"");
+    for (int i = 0; i < 100; ++i) timer.record_ticks(1000);
+    { Metrics::Timer::Scope timing(timer); }
+
+    std::string text = registry.render();
+    REQUIRE(text.find("# HELP test_render_requests_total Requests\n# TYPE test_render_requests_total counter\n"
+                      "test_render_requests_total{route=\"login\"} 3\n"
+                      "test_render_requests_total{route=\"chat\"} 4\n") != std::string::npos);
+    REQUIRE(text.find("# TYPE test_render_callback gauge\ntest_render_callback 1.5\n") != std::string::npos);
+    REQUIRE(text.find("# TYPE test_render_seconds summary\n") != std::string::npos);
+    REQUIRE(text.find("test_render_seconds{step=\"x\",quantile=\"0.99\"} ") != std::string::npos);
+    REQUIRE(text.find("test_render_seconds_count{step=\"x\"} 101\n") != std::string::npos);
+    REQUIRE(text.find("test_render_seconds_sum{step=\"x\"} ") != std::string::npos);
+    std::cout << "✅ 'Metrics: Prometheus text format\n";
+}
+
+TEST_CASE("MetricsEndpoint: serves /metrics on loopback", "[metrics]") {
+    Metrics::Registry::instance().counter("test_endpoint_hits_total", "Endpoint test").add(7);
+
+    boost::asio::io_context io;
+    auto endpoint = std::make_shared<MetricsEndpoint>(io, 0);
+    endpoint->start();
+    REQUIRE(endpoint->port() != 0);
+    std::thread runner([&] { io.run(); });
+
+    std::string ok = http_get(endpoint->port(), "/metrics");
+    REQUIRE(ok.starts_with("HTTP/1.1 200 OK\r\n"));
+    REQUIRE(ok.find("Content-Type: text/plain; version=0.0.4") != std::string::npos);
+    REQUIRE(ok.find("\ntest_endpoint_hits_total 7\n") != std::string::npos);
+
+    std::string body = ok.substr(ok.find("\r\n\r\n") + 4);
+    REQUIRE(ok.find("Content-Length: " + std::to_string(body.size()) + "\r\n") != std::string::npos);
+
+    REQUIRE(http_get(endpoint->port(), "/").starts_with("HTTP/1.1 404 Not Found\r\n"));
+
+    endpoint->stop();
+    runner.join();
+    std::cout << "✅ 'MetricsEndpoint: serves /metrics on loopback\n";
+}
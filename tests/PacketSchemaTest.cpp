@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+
+#include "src/server/SessionMode/authstage/opcodes/AuthMessages.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
+#include "src/server/SessionMode/workstage/opcodes/WorkMessages.hpp"
+
+#include <iostream>
+#include <numeric>
+
+namespace {
+    struct Mixed {
+        uint16_t id = 0;
+        uint32_t counter = 0;
+        std::string name;
+        uint64_t stamp = 0;
+        uint8_t flag = 0;
+
+        using Schema = PacketSchema::Fields<
+                PacketSchema::Field<&Mixed::id, PacketSchema::u16be>,
+                PacketSchema::Field<&Mixed::counter, PacketSchema::u32le>,
+                PacketSchema::Field<&Mixed::name, PacketSchema::cstring_be>,
+                PacketSchema::Field<&Mixed::stamp, PacketSchema::u64be>,
+                PacketSchema::Field<&Mixed::flag, PacketSchema::u8>>;
+    };
+
+    static_assert(!Mixed::Schema::FIXED);
+    static_assert(Mixed::Schema::FIXED_SIZE == 15);
+    static_assert(Mixed::Schema::MIN_SIZE == 16);
+    static_assert(AuthMessages::LogonChallenge::Schema::MIN_SIZE == 1);
+    static_assert(Mixed::Schema::run_size(0) == 6);
+    static_assert(Mixed::Schema::run_size(1) == 0);
+    static_assert(Mixed::Schema::run_size(2) == 0);
+    static_assert(Mixed::Schema::run_size(3) == 9);
+    static_assert(AuthMessages::AuthResponse::Schema::FIXED);
+}
+
+TEST_CASE("PacketSchema encodes the same bytes as hand-written writes", "[schema]") {
+    AuthMessages::LogonChallengeReply msg;
+    std::iota(msg.B.begin(), msg.B.end(), 0);
+    msg.g = 7;
+    std::iota(msg.N.begin(), msg.N.end(), 100);
+    std::iota(msg.salt.begin(), msg.salt.end(), 200);
+
+    ByteBuffer manual;
+    manual.write_bytes(msg.B);
+    manual.write_uint8(msg.g);
+    manual.write_bytes(msg.N);
+    manual.write_bytes(msg.salt);
+
+    ByteBuffer generated;
+    PacketSchema::encode(msg, generated);
+    REQUIRE(generated.to_vector() == manual.to_vector());
+    REQUIRE(PacketSchema::encoded_size(msg) == 97);
+    REQUIRE_FALSE(generated.on_heap());
+
+    Mixed mixed{0x1234, 0xAABBCCDD, "name", 0x0102030405060708ULL, 1};
+    ByteBuffer manual_mixed;
+    manual_mixed.write_uint16_be(mixed.id);
+    manual_mixed.write_uint32_le(mixed.counter);
+    manual_mixed.write_string_nt_be(mixed.name);
+    manual_mixed.write_uint64_be(mixed.stamp);
+    manual_mixed.write_uint8(mixed.flag);
+
+    ByteBuffer generated_mixed;
+    PacketSchema::encode(mixed, generated_mixed);
+    REQUIRE(generated_mixed.to_vector() == manual_mixed.to_vector());
+    REQUIRE(PacketSchema::encoded_size(mixed) == generated_mixed.size());
+    std::cout << "✅ 'PacketSchema encodes the same bytes as hand-written writes\n";
+}
+
+TEST_CASE("PacketSchema round trip through packets", "[schema]") {
+    AuthPacket response(AuthOpcodes::SMSG_AUTH_RESPONSE);
+    response.write(AuthMessages::AuthResponse{AuthStatusCode::AUTH_FAILED, AuthErrorCode::DATABASE_BUSY});
+
+    AuthPacket received;
+    received.deserialize(response.build_packet().bytes());
+    auto decoded = received.read<AuthMessages::AuthResponse>();
+    REQUIRE(decoded.status == AuthStatusCode::AUTH_FAILED);
+    REQUIRE(decoded.error == AuthErrorCode::DATABASE_BUSY);
+
+    ByteBuffer buf;
+    PacketSchema::encode(WorkMessages::Chat{"hello world"}, buf);
+    PacketSchema::encode(WorkMessages::Ping{42}, buf);
+    REQUIRE(PacketSchema::decode<WorkMessages::Chat>(buf).text == "hello world");
+    REQUIRE(PacketSchema::decode<WorkMessages::Ping>(buf).ping == 42);
+
+    Mixed mixed{1, 2, "abc", 3, 4};
+    ByteBuffer mixed_buf;
+    PacketSchema::encode(mixed, mixed_buf);
+    auto back = PacketSchema::decode<Mixed>(mixed_buf);
+    REQUIRE(back.id == 1);
+    REQUIRE(back.counter == 2);
+    REQUIRE(back.name == "abc");
+    REQUIRE(back.stamp == 3);
+    REQUIRE(back.flag == 4);
+    std::cout << "✅ 'PacketSchema round trip through packets\n";
+}
+
+TEST_CASE("PacketSchema rejects truncated payloads", "[schema]") {
+    AuthMessages::LogonProof proof;
+    ByteBuffer full;
+    PacketSchema::encode(proof, full);
+
+    ByteBuffer truncated(full.data(), full.size() - 1);
+    REQUIRE_THROWS_AS(PacketSchema::decode<AuthMessages::LogonProof>(truncated), std::out_of_range);
+    REQUIRE(truncated.read_pos() == 0);     // фиксированная часть проверяется целиком до чтения
+
+    Mixed mixed{1, 2, "abc", 3, 4};
+    ByteBuffer mixed_buf;
+    PacketSchema::encode(mixed, mixed_buf);
+    ByteBuffer mixed_truncated(mixed_buf.data(), mixed_buf.size() - 2);
+    REQUIRE_THROWS_AS(PacketSchema::decode<Mixed>(mixed_truncated), std::out_of_range);
+    std::cout << "✅ 'PacketSchema rejects truncated payloads\n";
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+#include "packet/ReceiveBufferPool.hpp"
+#include "packet/RingMessageBuffer.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    // Поток кадров [len(2) BE][payload], приходящий кусками случайного размера
+    std::vector<uint8_t> make_stream(std::mt19937& rng, size_t frames) {
+        std::vector<uint8_t> stream;
+        std::uniform_int_distribution<int> len(0, 700);
+        for (size_t f = 0; f < frames; ++f) {
+            auto size = static_cast<uint16_t>(len(rng));
+            stream.push_back(static_cast<uint8_t>(size >> 8));
+            stream.push_back(static_cast<uint8_t>(size));
+            for (uint16_t i = 0; i < size; ++i) stream.push_back(static_cast<uint8_t>(f * 31 + i));
+        }
+        return stream;
+    }
+
+    void check_fragmented_stream(RingMessageBuffer::Mapping mapping) {
+        std::mt19937 rng(12345);
+        auto stream = make_stream(rng, 2000);
+        std::uniform_int_distribution<size_t> chunk(1, 300);
+
+        RingMessageBuffer buffer(1024, mapping);
+        const size_t initial_capacity = buffer.get_free_space();
+        size_t sent = 0;
+        size_t parsed = 0;
+        bool straddled = false;
+
+        while (parsed < stream.size()) {
+            if (sent < stream.size()) {
+                buffer.ensure_free_space(256);
+                size_t n = std::min({chunk(rng), buffer.get_remaining_space(), stream.size() - sent});
+                std::memcpy(buffer.write_ptr(), stream.data() + sent, n);
+                buffer.write_completed(n);
+                sent += n;
+            }
+
+            // Медленный потребитель: не больше одного кадра за приход
+            if (buffer.get_active_size() >= 2) {
+                const uint8_t* header = buffer.peek(2);
+                size_t size = static_cast<size_t>(header[0]) << 8 | header[1];
+                if (buffer.get_active_size() >= 2 + size) {
+                    straddled |= buffer.get_contiguous_size() < 2 + size;
+                    const uint8_t* frame = buffer.peek(2 + size);
+                    REQUIRE(std::equal(frame, frame + 2 + size, stream.begin() + static_cast<long>(parsed)));
+                    buffer.read_completed(2 + size);
+                    parsed += 2 + size;
+                }
+            }
+        }
+
+        REQUIRE(buffer.get_active_size() == 0);
+        if (buffer.mirrored()) REQUIRE_FALSE(straddled);
+        else REQUIRE(straddled);
+
+        // Пик нагрузки прошёл — выросшая память возвращается
+        const bool grew = buffer.get_free_space() > initial_capacity;
+        REQUIRE(buffer.shrink_if_idle() == grew);
+        REQUIRE(buffer.get_free_space() == initial_capacity);
+        REQUIRE_FALSE(buffer.shrink_if_idle());
+    }
+}
+
+TEST_CASE("RingMessageBuffer: fragmented frames survive wrap-around and growth", "[ringbuffer]") {
+    check_fragmented_stream(RingMessageBuffer::Mapping::PLAIN);
+    check_fragmented_stream(RingMessageBuffer::Mapping::MIRRORED);
+    std::cout << "✅ 'RingMessageBuffer: fragmented frames survive wrap-around and growth\n";
+}
+
+TEST_CASE("RingMessageBuffer: mirrored mapping keeps the tail contiguous", "[ringbuffer]") {
+    RingMessageBuffer buffer(4096, RingMessageBuffer::Mapping::MIRRORED);
+    if (!buffer.mirrored()) {
+        WARN("mirrored mapping is not available here");
+        return;
+    }
+    const size_t capacity = buffer.get_free_space();
+
+    // Сдвигаем позиции к концу кольца и пишем через границу одним куском
+    std::vector<uint8_t> filler(capacity - 10, 0xEE);
+    std::memcpy(buffer.write_ptr(), filler.data(), filler.size());
+    buffer.write_completed(filler.size());
+    buffer.read_completed(filler.size() - 1);   // один байт остаётся, позиции не сбрасываются
+
+    std::vector<uint8_t> data(100);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i);
+    REQUIRE(buffer.get_remaining_space() >= data.size());
+    std::memcpy(buffer.write_ptr(), data.data(), data.size());
+    buffer.write_completed(data.size());
+
+    buffer.read_completed(1);
+    REQUIRE(buffer.get_contiguous_size() == data.size());
+    REQUIRE(std::equal(data.begin(), data.end(), buffer.read_ptr()));
+    std::cout << "✅ 'RingMessageBuffer: mirrored mapping keeps the tail contiguous\n";
+}
+
+TEST_CASE("RingMessageBuffer: overflow is rejected", "[ringbuffer]") {
+    RingMessageBuffer buffer(64);
+    REQUIRE_THROWS(buffer.read_completed(1));
+    REQUIRE_THROWS(buffer.write_completed(buffer.get_remaining_space() + 1));
+    REQUIRE_THROWS(buffer.peek(1));
+    std::cout << "✅ 'RingMessageBuffer: overflow is rejected\n";
+}
+
+TEST_CASE("ReceiveBufferPool: buffers are reused, shrunk and capped", "[ringbuffer]") {
+    auto& pool = ReceiveBufferPool::local();
+    while (pool.cached() > 0) pool.acquire();
+
+    auto buffer = pool.acquire();
+    RingMessageBuffer* raw = buffer.get();
+
+    // Всплеск: буфер вырос и держит непрочитанные байты
+    buffer->ensure_free_space(3 * ReceiveBufferPool::BUFFER_SIZE);
+    buffer->write_completed(100);
+    pool.release(std::move(buffer));
+    REQUIRE(pool.cached() == 1);
+
+    auto reused = pool.acquire();
+    REQUIRE(reused.get() == raw);
+    REQUIRE(reused->get_active_size() == 0);
+    REQUIRE(reused->get_free_space() == ReceiveBufferPool::BUFFER_SIZE);
+    pool.release(std::move(reused));
+
+    std::vector<ReceiveBufferPool::BufferPtr> many;
+    for (size_t i = 0; i < ReceiveBufferPool::MAX_CACHED + 10; ++i) many.push_back(pool.acquire());
+    for (auto& b : many) pool.release(std::move(b));
+    REQUIRE(pool.cached() == ReceiveBufferPool::MAX_CACHED);
+    std::cout << "✅ 'ReceiveBufferPool: buffers are reused, shrunk and capped\n";
+}
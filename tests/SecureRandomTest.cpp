@@ -0,0 +1,50 @@
+#include <catch2/catch.hpp>
+#include "utils/generators/SecureRandom.hpp"
+
+#include <array>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+TEST_CASE("SecureRandom: consecutive slices differ", "[random]") {
+    std::array<uint8_t, 32> a{};
+    std::array<uint8_t, 32> b{};
+
+    SecureRandom::fill(a);
+    SecureRandom::fill(b);
+
+    REQUIRE(a != b);
+    std::cout << "✅ 'SecureRandom: consecutive slices differ\n";
+}
+
+TEST_CASE("SecureRandom: child process does not reuse parent's buffer", "[random]") {
+    // Наполняем thread-local буфер до fork
+    std::array<uint8_t, 32> warmup{};
+    SecureRandom::fill(warmup);
+
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        std::array<uint8_t, 32> child{};
+        SecureRandom::fill(child);
+        ssize_t written = write(fds[1], child.data(), child.size());
+        _exit(written == static_cast<ssize_t>(child.size()) ? 0 : 1);
+    }
+
+    std::array<uint8_t, 32> parent{};
+    SecureRandom::fill(parent);
+
+    std::array<uint8_t, 32> child{};
+    REQUIRE(read(fds[0], child.data(), child.size()) == static_cast<ssize_t>(child.size()));
+    close(fds[0]);
+    close(fds[1]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    REQUIRE(parent != child);
+    std::cout << "✅ 'SecureRandom: child process does not reuse parent's buffer\n";
+}
@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include "src/server/SessionRegistry/SessionRegistry.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct FakeSession {
+        explicit FakeSession(int n) : number(n) {}
+        int number;
+    };
+
+    using Registry = SessionRegistry<FakeSession>;
+}
+
+TEST_CASE("SessionRegistry: add, find, remove by stable ID", "[session_registry]") {
+    Registry registry;
+    REQUIRE(registry.find(0) == nullptr);
+    REQUIRE_FALSE(registry.remove(0));
+
+    auto first = std::make_shared<FakeSession>(1);
+    auto second = std::make_shared<FakeSession>(2);
+    uint64_t first_id = registry.add(first);
+    uint64_t second_id = registry.add(second);
+    REQUIRE(first_id != 0);
+    REQUIRE(first_id != second_id);
+    REQUIRE(registry.size() == 2);
+    REQUIRE(registry.find(first_id) == first);
+    REQUIRE(registry.find(second_id) == second);
+
+    REQUIRE(registry.remove(first_id));
+    REQUIRE_FALSE(registry.remove(first_id));
+    REQUIRE(registry.find(first_id) == nullptr);
+    REQUIRE(first.use_count() == 1);
+
+    // Слот переиспользуется, но старый ID на новую сессию не указывает
+    auto third = std::make_shared<FakeSession>(3);
+    uint64_t third_id = registry.add(third);
+    REQUIRE((third_id & 0xFFFFFFFF) == (first_id & 0xFFFFFFFF));
+    REQUIRE(third_id != first_id);
+    REQUIRE(registry.find(first_id) == nullptr);
+    REQUIRE_FALSE(registry.remove(first_id));
+    REQUIRE(registry.find(third_id) == third);
+
+    REQUIRE(registry.snapshot().size() == 2);
+    REQUIRE(registry.added() == 3);
+
+    registry.clear();
+    REQUIRE(registry.size() == 0);
+    REQUIRE(registry.find(second_id) == nullptr);
+    REQUIRE(registry.snapshot().empty());
+    std::cout << "✅ 'SessionRegistry: add, find, remove by stable ID\n";
+}
+
+TEST_CASE("SessionRegistry: concurrent churn with lock-free snapshots", "[session_registry]") {
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 20000;
+    constexpr int KEEP = 100;     // сессий на поток, которые остаются в реестре
+
+    Registry registry;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> snapshots{0};
+    std::atomic<uint64_t> errors{0};     // REQUIRE из Catch2 в рабочих потоках небезопасен
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            std::set<int> seen;
+            registry.for_each([&](const Registry::Ptr &s) {
+                if (!s || !seen.insert(s->number).second) errors.fetch_add(1);
+            });
+            snapshots.fetch_add(1);
+        }
+    });
+
+    std::vector<std::thread> writers;
+    std::vector<std::vector<uint64_t>> kept(THREADS);
+    for (int t = 0; t < THREADS; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < ROUNDS; ++i) {
+                auto session = std::make_shared<FakeSession>(t * ROUNDS + i);
+                uint64_t id = registry.add(session);
+                if (registry.find(id) != session) errors.fetch_add(1);
+                if (i % (ROUNDS / KEEP) == 0) {
+                    kept[t].push_back(id);
+                } else if (!registry.remove(id) || registry.find(id) != nullptr) {
+                    errors.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto &w : writers) w.join();
+    done.store(true);
+    reader.join();
+
+    REQUIRE(errors.load() == 0);
+    REQUIRE(snapshots.load() > 0);
+    REQUIRE(registry.size() == THREADS * KEEP);
+    REQUIRE(registry.snapshot().size() == THREADS * KEEP);
+    REQUIRE(registry.added() == THREADS * ROUNDS);
+    for (auto &ids : kept) {
+        for (uint64_t id : ids) REQUIRE(registry.find(id) != nullptr);
+    }
+    std::cout << "✅ 'SessionRegistry: concurrent churn with lock-free snapshots\n";
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include "srp6/Sha1Hasher.hpp"
+
+#include <openssl/sha.h>
+#include <iostream>
+#include <vector>
+
+namespace {
+    std::vector<uint8_t> make_message(size_t length, uint8_t seed) {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i) data[i] = static_cast<uint8_t>(seed + i * 31);
+        return data;
+    }
+
+    Sha1Hasher::Digest reference(const std::vector<uint8_t>& data) {
+        Sha1Hasher::Digest out;
+        SHA1(data.data(), data.size(), out.data());
+        return out;
+    }
+}
+
+TEST_CASE("Sha1Hasher: scatter digest matches one-shot SHA1", "[sha1]") {
+    auto data = make_message(177, 7);
+
+    Sha1Hasher hasher;
+    std::span<const uint8_t> all(data);
+    auto digest = hasher.digest({all.subspan(0, 20), all.subspan(20, 0), all.subspan(20, 100), all.subspan(120)});
+
+    REQUIRE(digest == reference(data));
+    std::cout << "✅ 'Sha1Hasher: scatter digest matches one-shot SHA1\n";
+}
+
+TEST_CASE("Sha1Batch: every backend matches one-shot SHA1", "[sha1]") {
+    // Длины вокруг границ блока (55/56/64) и разное количество блоков в одной пачке
+    const size_t lengths[] = {0, 1, 20, 55, 56, 63, 64, 65, 92, 119, 120, 128, 176, 200, 513};
+    constexpr size_t COUNT = std::size(lengths);
+
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<std::array<Sha1Hasher::Part, 2>> parts(COUNT);
+    std::vector<Sha1Batch::Message> messages;
+    for (size_t i = 0; i < COUNT; ++i) {
+        data.push_back(make_message(lengths[i], static_cast<uint8_t>(i)));
+    }
+    for (size_t i = 0; i < COUNT; ++i) {
+        std::span<const uint8_t> all(data[i]);
+        size_t split = all.size() / 3;
+        parts[i] = {all.subspan(0, split), all.subspan(split)};
+        messages.push_back({parts[i]});
+    }
+
+    for (auto backend : {Sha1Batch::Backend::SCALAR, Sha1Batch::Backend::AVX2, Sha1Batch::Backend::AUTO}) {
+        std::vector<Sha1Hasher::Digest> out(COUNT);
+        Sha1Batch::digest(messages, out.data(), backend);
+        for (size_t i = 0; i < COUNT; ++i) {
+            INFO("length " << lengths[i]);
+            REQUIRE(out[i] == reference(data[i]));
+        }
+    }
+    std::cout << "✅ 'Sha1Batch: every backend matches one-shot SHA1 (avx2="
+              << Sha1Batch::has_avx2() << ")\n";
+}
@@ -1,9 +1,11 @@
 #include <catch2/catch.hpp>
 
 #include "srp6/SRP6.hpp"
+#include "src/server/SessionMode/authstage/opcodes/AuthPacket.hpp"
 #include <openssl/bn.h>
 #include <openssl/sha.h>
 #include <openssl/rand.h>
+#include <array>
 #include <vector>
 #include <cstring>
 #include <iostream>
@@ -78,3 +80,120 @@ TEST_CASE("SRP6: server ephemeral generates different B each time", "[srp6]") {
     REQUIRE(B1 != B2);
     std::cout << "✅ 'SRP6: server ephemeral generates different B each time\n";
 }
+
+TEST_CASE("SRP6: full handshake agrees on proofs and session key", "[srp6]") {
+    SRP6 server;
+    auto [salt, verifier] = server.generate_salt_and_verifier_trinity("bob", "hunter2");
+    REQUIRE(salt.size() == 32);
+    REQUIRE(verifier.size() == 32);
+
+    server.set_only_username("BOB");
+    server.load_verifier(salt, verifier);
+    server.generate_server_ephemeral();
+
+    SRP6 client;
+    client.set_credentials("bob", "hunter2");
+    client.load_constants(server.get_N_bytes(), server.get_generator());
+    client.load_salt(salt);
+    client.generate_client_ephemeral();
+    auto M1 = client.compute_M1(server.get_B_bytes());
+
+    std::vector<uint8_t> M2;
+    REQUIRE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+    REQUIRE(M2.size() == 20);
+    REQUIRE(client.verify_server_proof(client.get_last_M1(), M2));
+    REQUIRE(server.get_session_key() == client.get_session_key());
+    std::cout << "✅ 'SRP6: full handshake agrees on proofs and session key\n";
+}
+
+TEST_CASE("SRP6: wrong password and degenerate A are rejected", "[srp6]") {
+    SRP6 server;
+    auto [salt, verifier] = server.generate_salt_and_verifier_trinity("bob", "hunter2");
+    server.set_only_username("BOB");
+    server.load_verifier(salt, verifier);
+    server.generate_server_ephemeral();
+
+    SRP6 client;
+    client.set_credentials("bob", "wrong");
+    client.load_salt(salt);
+    client.generate_client_ephemeral();
+    auto M1 = client.compute_M1(server.get_B_bytes());
+
+    std::vector<uint8_t> M2;
+    REQUIRE_FALSE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+    REQUIRE(M2.empty());
+
+    // A = N (A % N == 0) даёт S = 0 независимо от пароля; новый B — чтобы проверка дошла до A
+    server.generate_server_ephemeral();
+    REQUIRE_FALSE(server.verify_client_proof(server.get_N_bytes(), M1, M2));
+    server.generate_server_ephemeral();
+    REQUIRE_FALSE(server.verify_client_proof(std::vector<uint8_t>(32, 0), M1, M2));
+
+    std::vector<uint8_t> other_N(32, 0xFF);
+    REQUIRE_THROWS(client.load_constants(other_N, 7));
+    std::cout << "✅ 'SRP6: wrong password and degenerate A are rejected\n";
+}
+
+TEST_CASE("SRP6: one proof per server ephemeral", "[srp6]") {
+    SRP6 server;
+    auto [salt, verifier] = server.generate_salt_and_verifier_trinity("bob", "hunter2");
+    server.set_only_username("BOB");
+    server.load_verifier(salt, verifier);
+
+    // До challenge проверять нечего
+    SRP6 client;
+    client.set_credentials("bob", "hunter2");
+    client.load_salt(salt);
+    client.generate_client_ephemeral();
+    std::vector<uint8_t> M2;
+    REQUIRE_FALSE(server.verify_client_proof(client.get_A_bytes(), std::vector<uint8_t>(20, 0), M2));
+
+    server.generate_server_ephemeral();
+
+    SRP6 guesser;
+    guesser.set_credentials("bob", "wrong");
+    guesser.load_salt(salt);
+    guesser.generate_client_ephemeral();
+    REQUIRE_FALSE(server.verify_client_proof(guesser.get_A_bytes(), guesser.compute_M1(server.get_B_bytes()), M2));
+
+    // Верный пароль на том же B уже не принимается — нужен новый challenge
+    auto M1 = client.compute_M1(server.get_B_bytes());
+    REQUIRE_FALSE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+
+    server.generate_server_ephemeral();
+    M1 = client.compute_M1(server.get_B_bytes());
+    REQUIRE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+    REQUIRE(client.verify_server_proof(client.get_last_M1(), M2));
+
+    // И после успешной проверки повтор отклоняется
+    REQUIRE_FALSE(server.verify_client_proof(client.get_A_bytes(), M1, M2));
+    std::cout << "✅ 'SRP6: one proof per server ephemeral\n";
+}
+
+TEST_CASE("SRP6: proof verified straight from packet spans", "[srp6]") {
+    SRP6 server;
+    auto [salt, verifier] = server.generate_salt_and_verifier_trinity("bob", "hunter2");
+    server.set_only_username("BOB");
+    server.load_verifier(salt, verifier);
+    server.generate_server_ephemeral();
+
+    SRP6 client;
+    client.set_credentials("bob", "hunter2");
+    client.load_salt(salt);
+    client.generate_client_ephemeral();
+
+    AuthPacket proof(AuthOpcodes::CMSG_AUTH_LOGON_PROOF);
+    proof.write_bytes(client.get_A_bytes());
+    proof.write_bytes(client.compute_M1(server.get_B_bytes()));
+    ByteBuffer frame = proof.build_packet();
+
+    AuthPacket received;
+    received.deserialize(frame.bytes());
+    std::span<const uint8_t> A = received.read_span(32);
+    std::span<const uint8_t> M1 = received.read_span(20);
+
+    std::array<uint8_t, SHA_DIGEST_LENGTH> M2{};
+    REQUIRE(server.verify_client_proof(A, M1, M2));
+    REQUIRE(client.verify_server_proof(client.get_last_M1(), M2));
+    std::cout << "✅ 'SRP6: proof verified straight from packet spans\n";
+}
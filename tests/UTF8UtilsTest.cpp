@@ -0,0 +1,169 @@
+#include <catch2/catch.hpp>
+#include "utils/utf8utils/UTF8Utils.hpp"
+
+#include <cctype>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr UTF8Utils::Backend BACKENDS[] = {UTF8Utils::Backend::SCALAR, UTF8Utils::Backend::SSSE3,
+                                               UTF8Utils::Backend::AVX2};
+
+    // Эталон по таблице 3-7 стандарта Unicode: допустимые диапазоны второго байта зависят от первого
+    bool reference_valid(const std::string& s) {
+        const auto* b = reinterpret_cast<const unsigned char*>(s.data());
+        size_t i = 0;
+        while (i < s.size()) {
+            unsigned char c = b[i];
+            size_t length;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (c < 0x80) { ++i; continue; }
+            else if (c >= 0xC2 && c <= 0xDF) length = 2;
+            else if (c >= 0xE0 && c <= 0xEF) {
+                length = 3;
+                if (c == 0xE0) lo = 0xA0;
+                if (c == 0xED) hi = 0x9F;
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                length = 4;
+                if (c == 0xF0) lo = 0x90;
+                if (c == 0xF4) hi = 0x8F;
+            } else return false;
+
+            if (i + length > s.size()) return false;
+            if (b[i + 1] < lo || b[i + 1] > hi) return false;
+            for (size_t k = 2; k < length; ++k) {
+                if (b[i + k] < 0x80 || b[i + k] > 0xBF) return false;
+            }
+            i += length;
+        }
+        return true;
+    }
+
+    void require_all_backends(const std::string& s, bool expected) {
+        for (auto backend : BACKENDS) {
+            INFO("backend " << static_cast<int>(backend) << ", size " << s.size());
+            REQUIRE(UTF8Utils::is_valid_utf8(s, backend) == expected);
+        }
+    }
+}
+
+TEST_CASE("UTF8Utils: known valid and invalid sequences", "[utf8]") {
+    const std::vector<std::string> valid = {
+            "", "Administrator", "Привет, мир", "€", "\xF0\x9D\x84\x9E", "\xF4\x8F\xBF\xBF",
+            "\xED\x9F\xBF", "\xEE\x80\x80", "\xC2\x80", "\xE0\xA0\x80", "\xF0\x90\x80\x80"};
+    const std::vector<std::string> invalid = {
+            "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+            "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80",
+            "\xFF", "\x80", "\xBF", "\xE2\x82", "\xE2\x82\x41", "\xC3", "\xC3\xA9\xA9", "\xF0\x9D\x84"};
+
+    // Сама строка, в середине ASCII и на стыках 16- и 32-байтовых блоков
+    for (const auto& s : valid) {
+        for (size_t offset : {0, 5, 13, 14, 15, 16, 29, 30, 31, 32, 47}) {
+            std::string text = std::string(offset, 'a') + s + std::string(40, 'b');
+            require_all_backends(text, true);
+            require_all_backends(std::string(offset, 'a') + s, true);
+        }
+    }
+    for (const auto& s : invalid) {
+        REQUIRE_FALSE(reference_valid(s));
+        for (size_t offset : {0, 5, 13, 14, 15, 16, 29, 30, 31, 32, 47}) {
+            require_all_backends(std::string(offset, 'a') + s + std::string(40, 'b'), false);
+            require_all_backends(std::string(offset, 'a') + s, false);
+        }
+    }
+    std::cout << "✅ 'UTF8Utils: known valid and invalid sequences\n";
+}
+
+TEST_CASE("UTF8Utils: every two-byte pair matches the reference", "[utf8]") {
+    for (unsigned first = 0x80; first <= 0xFF; ++first) {
+        for (unsigned second = 0; second <= 0xFF; ++second) {
+            for (size_t offset : {14, 30}) {
+                std::string s(offset, 'x');
+                s.push_back(static_cast<char>(first));
+                s.push_back(static_cast<char>(second));
+                s.append("\x80\x80", 2);                // добиваем до 4 байт продолжениями
+                s.append(20, 'y');
+                bool expected = reference_valid(s);
+                for (auto backend : BACKENDS) {
+                    if (UTF8Utils::is_valid_utf8(s, backend) != expected) {
+                        FAIL("backend " << static_cast<int>(backend) << ": " << std::hex << first << " " << second);
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "✅ 'UTF8Utils: every two-byte pair matches the reference\n";
+}
+
+TEST_CASE("UTF8Utils: random mutations agree with the reference", "[utf8]") {
+    const std::string base = "Съешь же ещё этих мягких французских булок \xF0\x9F\x98\x80 da vypej chaju. ";
+    std::mt19937 rng(42);
+
+    for (int round = 0; round < 20000; ++round) {
+        std::string s = base.substr(0, rng() % base.size());
+        s += base.substr(0, rng() % base.size());
+        for (unsigned n = rng() % 3; n > 0 && !s.empty(); --n) {
+            s[rng() % s.size()] = static_cast<char>(rng());
+        }
+        bool expected = reference_valid(s);
+        for (auto backend : BACKENDS) {
+            if (UTF8Utils::is_valid_utf8(s, backend) != expected) {
+                FAIL("backend " << static_cast<int>(backend) << ", round " << round);
+            }
+        }
+    }
+    std::cout << "✅ 'UTF8Utils: random mutations agree with the reference\n";
+}
+
+TEST_CASE("UTF8Utils: ASCII case folding leaves other bytes alone", "[utf8]") {
+    std::string all;
+    for (int rep = 0; rep < 3; ++rep) {
+        for (int c = 0; c < 256; ++c) all.push_back(static_cast<char>(c));
+    }
+
+    // Разные длины — чтобы пройти SIMD, SWAR и побайтовый хвост
+    const std::vector<size_t> sizes = {0, 1, 7, 8, 15, 16, 17, 31, 100, all.size()};
+    for (size_t size : sizes) {
+        std::string upper = all.substr(0, size);
+        std::string lower = upper;
+        UTF8Utils::to_uppercase_inplace(upper);
+        UTF8Utils::to_lowercase_inplace(lower);
+
+        for (size_t i = 0; i < size; ++i) {
+            auto c = static_cast<unsigned char>(all[i]);
+            REQUIRE(static_cast<unsigned char>(upper[i]) == (c < 0x80 ? std::toupper(c) : c));
+            REQUIRE(static_cast<unsigned char>(lower[i]) == (c < 0x80 ? std::tolower(c) : c));
+        }
+    }
+
+    REQUIRE(UTF8Utils::to_uppercase("player_One") == "PLAYER_ONE");
+    REQUIRE(UTF8Utils::to_uppercase("иван") == "иван");
+    REQUIRE(UTF8Utils::to_lowercase("Hello, Мир") == "hello, Мир");
+    std::cout << "✅ 'UTF8Utils: ASCII case folding leaves other bytes alone\n";
+}
+
+TEST_CASE("UTF8Utils: Unicode simple case mapping", "[utf8]") {
+    REQUIRE(UTF8Utils::to_uppercase_unicode("Привет, мир! ёж") == "ПРИВЕТ, МИР! ЁЖ");
+    REQUIRE(UTF8Utils::to_lowercase_unicode("СЪЕШЬ ЖЕ ЕЩЁ, Ѓ Ї") == "съешь же ещё, ѓ ї");
+    REQUIRE(UTF8Utils::to_uppercase_unicode("αβγ ως") == "ΑΒΓ ΩΣ");
+    REQUIRE(UTF8Utils::to_uppercase_unicode("āăą żźž") == "ĀĂĄ ŻŹŽ");
+    REQUIRE(UTF8Utils::to_uppercase_unicode("\xF0\x90\x90\xA8") == "\xF0\x90\x90\x80");     // Deseret
+
+    // Многосимвольные отображения не применяются, длина в байтах может меняться
+    REQUIRE(UTF8Utils::to_uppercase_unicode("straße") == "STRAßE");
+    REQUIRE(UTF8Utils::to_uppercase_unicode("ſ") == "S");
+    REQUIRE(UTF8Utils::to_lowercase_unicode("\xE2\x84\xAA") == "k");                        // знак Кельвина
+
+    // Невалидные байты переносятся без изменений
+    REQUIRE(UTF8Utils::to_uppercase_unicode("a\xFF\xD0") == "A\xFF\xD0");
+
+    std::string long_text;
+    for (int i = 0; i < 20; ++i) long_text += "Ёлка and ель ";
+    std::string expected;
+    for (int i = 0; i < 20; ++i) expected += "ЁЛКА AND ЕЛЬ ";
+    REQUIRE(UTF8Utils::to_uppercase_unicode(long_text) == expected);
+    REQUIRE(UTF8Utils::to_lowercase_unicode(expected) == UTF8Utils::to_lowercase_unicode(long_text));
+    std::cout << "✅ 'UTF8Utils: Unicode simple case mapping\n";
+}
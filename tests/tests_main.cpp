@@ -6,11 +6,11 @@
 struct LoggerGuard {
     LoggerGuard() {
         Logger::init_thread_pool();
-        Logger::get()->info("Logger initialized for tests");
+        Logger::get().info("Logger initialized for tests");
     }
 
     ~LoggerGuard() {
-        Logger::get()->info("Logger shutdown requested");
+        Logger::get().info("Logger shutdown requested");
         Logger::shutdown();
     }
 };